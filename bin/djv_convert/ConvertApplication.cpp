@@ -40,10 +40,159 @@
 #include <QDir>
 #include <QTimer>
 
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace djv
 {
     namespace convert
     {
+        namespace
+        {
+            //! This class provides a pipeline for reading and converting frames
+            //! with multiple threads. The frames are processed out of order and
+            //! returned in order. With zero threads the frames are processed on
+            //! the calling thread when they are requested.
+            class Pipeline
+            {
+            public:
+                //! This struct provides a frame.
+                struct Frame
+                {
+                    Graphics::Image   image;
+                    Graphics::Image   tmp;
+                    Graphics::Image * p = nullptr;
+                    Core::Error       error;
+                };
+
+                //! The function for reading and converting a frame. The
+                //! arguments are the thread index and the frame index.
+                typedef std::function<void(int, qint64, Frame &)> Function;
+
+                Pipeline(int threads, qint64 length, qint64 queue, const Function & function) :
+                    _length(length),
+                    _queue(queue),
+                    _function(function)
+                {
+                    for (int i = 0; i < threads; ++i)
+                    {
+                        _threads.push_back(std::thread([this, i] { _run(i); }));
+                    }
+                }
+
+                ~Pipeline()
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _cancel = true;
+                    }
+                    _cv.notify_all();
+                    for (auto & i : _threads)
+                    {
+                        i.join();
+                    }
+                }
+
+                //! Wait for the next frame.
+                std::shared_ptr<Frame> next()
+                {
+                    if (_threads.empty())
+                    {
+                        return _process(0, _write++);
+                    }
+                    std::shared_ptr<Frame> out;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _cv.wait(lock, [this] { return _frames.count(_write) > 0; });
+                        const auto i = _frames.find(_write);
+                        out = i->second;
+                        _frames.erase(i);
+                        ++_write;
+                    }
+                    _cv.notify_all();
+                    return out;
+                }
+
+            private:
+                void _run(int thread)
+                {
+                    while (1)
+                    {
+                        // Wait until there is room in the queue.
+                        qint64 index = 0;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _cv.wait(lock, [this]
+                            {
+                                return _cancel || _read >= _length || _read - _write < _queue;
+                            });
+                            if (_cancel || _read >= _length)
+                                break;
+                            index = _read++;
+                        }
+
+                        // The frame is always published so that the writer
+                        // does not wait for it forever. After an error no more
+                        // frames are started since the writer stops there.
+                        const auto frame = _process(thread, index);
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _frames[index] = frame;
+                            if (!frame->p)
+                            {
+                                _cancel = true;
+                            }
+                        }
+                        _cv.notify_all();
+                    }
+                }
+
+                //! Process a frame. Errors are stored in the frame and reported
+                //! by the writer.
+                std::shared_ptr<Frame> _process(int thread, qint64 index)
+                {
+                    auto frame = std::make_shared<Frame>();
+                    try
+                    {
+                        _function(thread, index, *frame);
+                    }
+                    catch (const Core::Error & error)
+                    {
+                        frame->p = nullptr;
+                        frame->error = error;
+                    }
+                    catch (const std::exception & error)
+                    {
+                        frame->p = nullptr;
+                        frame->error = Core::Error(error.what());
+                    }
+                    catch (...)
+                    {
+                        frame->p = nullptr;
+                        frame->error = Core::Error(
+                            qApp->translate("djv::convert::Application", "Unknown error"));
+                    }
+                    return frame;
+                }
+
+                qint64                   _length = 0;
+                qint64                   _queue = 0;
+                Function                 _function;
+                std::vector<std::thread> _threads;
+                std::mutex               _mutex;
+                std::condition_variable  _cv;
+                qint64                   _read = 0;
+                qint64                   _write = 0;
+                std::map<qint64, std::shared_ptr<Frame> > _frames;
+                bool                     _cancel = false;
+            };
+
+        } // namespace
+
         Application::Application(int & argc, char ** argv) :
             QGuiApplication(argc, argv)
         {
@@ -305,36 +454,75 @@ namespace djv
                     return;
                 }
             }
+
+            // Open a loader for each conversion thread since loaders cannot be
+            // shared between threads. Movies are read with a single thread
+            // because seeking between frames is expensive. A single thread runs
+            // on the main thread so that the conversion uses OpenGL like it
+            // always has.
             const qint64 length = static_cast<qint64>(saveInfo.sequence.frames.count());
-            float    progressAccum = 0.f;
-            Core::Timer progressTimer;
-            progressTimer.start();
-            for (qint64 i = 0; i < length; ++i)
+            int threads = 1;
+            if (Core::FileInfo::SEQUENCE == input.file.type())
+            {
+                threads = static_cast<int>(Core::Math::clamp<qint64>(options.threads, 1, qMax<qint64>(length, 1)));
+            }
+            //DJV_DEBUG_PRINT("threads = " << threads);
+            std::vector<std::unique_ptr<Graphics::ImageLoad> > loads;
+            loads.push_back(std::unique_ptr<Graphics::ImageLoad>(load.take()));
+            for (int i = 1; i < threads; ++i)
+            {
+                try
+                {
+                    Graphics::ImageIOInfo info;
+                    loads.push_back(std::unique_ptr<Graphics::ImageLoad>(
+                        _context->imageIOFactory()->load(input.file, info)));
+                }
+                catch (Core::Error error)
+                {
+                    error.add(
+                        errorLabels()[ERROR_OPEN_INPUT].
+                        arg(QDir::toNativeSeparators(input.file)));
+                    _context->printError(error);
+                    save->close();
+                    exit(1);
+                    return;
+                }
+            }
+            std::vector<std::unique_ptr<Graphics::OpenGLImage> > openGLImages;
+            for (int i = 0; i < threads; ++i)
+            {
+                openGLImages.push_back(std::unique_ptr<Graphics::OpenGLImage>(new Graphics::OpenGLImage));
+            }
+            imageOptions.xform.position = position;
+            imageOptions.xform.scale = glm::vec2(scaleSize) / glm::vec2(loadInfo.size);
+            const Graphics::PixelDataInfo savePixelDataInfo = saveInfo;
+            const Core::FrameList & loadFrames = loadInfo.sequence.frames;
+
+            // Start reading and converting the images.
+            Pipeline pipeline(
+                threads > 1 ? threads : 0,
+                length,
+                qMax(options.queue, threads),
+                [&](int thread, qint64 i, Pipeline::Frame & frame)
             {
-                Core::Timer frameTimer;
-                frameTimer.start();
-
                 // Load the current image.
-                Graphics::Image image;
                 int timeout = input.timeout;
-                while (!image.isValid())
+                while (!frame.image.isValid())
                 {
                     try
                     {
-                        load->read(
-                            image,
+                        loads[thread]->read(
+                            frame.image,
                             Graphics::ImageIOFrameInfo(
-                                loadInfo.sequence.frames.count() ?
-                                loadInfo.sequence.frames[i] :
-                                -1,
+                                loadFrames.count() ? loadFrames.at(i) : -1,
                                 layer,
                                 input.proxy));
                     }
                     catch (const Core::Error & in)
                     {
-                        error = in;
+                        frame.error = in;
                     }
-                    if (!image.isValid() && timeout > 0)
+                    if (!frame.image.isValid() && timeout > 0)
                     {
                         //print("Timeout...");
                         --timeout;
@@ -345,8 +533,38 @@ namespace djv
                         break;
                     }
                 }
-                if (!image.isValid())
+                if (!frame.image.isValid())
+                    return;
+
+                // Convert. There is no OpenGL context on the conversion
+                // threads so the conversion is done in software there.
+                frame.p = &frame.image;
+                Graphics::OpenGLImageOptions tmpOptions = imageOptions;
+                tmpOptions.colorProfile = frame.image.colorProfile;
+                if (frame.image.info() != savePixelDataInfo ||
+                    tmpOptions != Graphics::OpenGLImageOptions())
+                {
+                    frame.tmp.set(savePixelDataInfo);
+                    openGLImages[thread]->copy(
+                        frame.image,
+                        frame.tmp,
+                        tmpOptions);
+                    frame.p = &frame.tmp;
+                }
+            });
+
+            // Write the images in order.
+            float    progressAccum = 0.f;
+            Core::Timer progressTimer;
+            progressTimer.start();
+            Core::Timer frameTimer;
+            frameTimer.start();
+            for (qint64 i = 0; i < length; ++i)
+            {
+                const std::shared_ptr<Pipeline::Frame> frame = pipeline.next();
+                if (!frame->p)
                 {
+                    error = frame->error;
                     error.add(
                         errorLabels()[ERROR_READ_INPUT].
                         arg(QDir::toNativeSeparators(input.file)));
@@ -355,11 +573,11 @@ namespace djv
                     exit(1);
                     return;
                 }
-                //DJV_DEBUG_PRINT("image = " << *image);
+                //DJV_DEBUG_PRINT("image = " << *frame->p);
 
                 // Process the image tags.
                 Graphics::ImageTags tags = output.tags;
-                tags.add(image.tags);
+                tags.add(frame->image.tags);
                 if (output.tagsAuto)
                 {
                     tags[Graphics::ImageTags::tagLabels()[Graphics::ImageTags::CREATOR]] =
@@ -374,31 +592,14 @@ namespace djv
                                 0,
                                 saveInfo.sequence.speed));
                 }
-
-                // Convert.
-                Graphics::Image * p = &image;
-                Graphics::Image tmp;
-                imageOptions.xform.position = position;
-                imageOptions.xform.scale = glm::vec2(scaleSize) / glm::vec2(loadInfo.size);
-                imageOptions.colorProfile = image.colorProfile;
-                if (p->info() != static_cast<Graphics::PixelDataInfo>(saveInfo) ||
-                    imageOptions != Graphics::OpenGLImageOptions())
-                {
-                    tmp.set(saveInfo);
-                    openGLImage->copy(
-                        image,
-                        tmp,
-                        imageOptions);
-                    p = &tmp;
-                }
-                p->tags = tags;
+                frame->p->tags = tags;
 
                 // Save the image.
-                //DJV_DEBUG_PRINT("output = " << tmp);
+                //DJV_DEBUG_PRINT("output = " << *frame->p);
                 try
                 {
                     save->write(
-                        *p,
+                        *frame->p,
                         Graphics::ImageIOFrameInfo(
                             saveInfo.sequence.frames.count() ?
                             saveInfo.sequence.frames[i] :
@@ -415,10 +616,13 @@ namespace djv
                     return;
                 }
 
-                // Statistics.
+                // Statistics. The frames are processed in parallel so the
+                // estimate is based on the time between written frames rather
+                // than the time spent on each frame.
                 timer.check();
                 frameTimer.check();
                 progressAccum += frameTimer.seconds();
+                frameTimer.start();
                 progressTimer.check();
                 if (length > 1 && progressTimer.seconds() > 3.f)
                 {
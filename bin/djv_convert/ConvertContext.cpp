@@ -33,6 +33,7 @@
 #include <djvCore/FileInfoUtil.h>
 
 #include <QCoreApplication>
+#include <QThread>
 
 namespace djv
 {
@@ -40,7 +41,9 @@ namespace djv
     {
         Options::Options() :
             scale(1.0),
-            channel(static_cast<Graphics::OpenGLImageOptions::CHANNEL>(0))
+            channel(static_cast<Graphics::OpenGLImageOptions::CHANNEL>(0)),
+            threads(qMax(1, QThread::idealThreadCount())),
+            queue(threads * 2)
         {}
 
         Input::Input() :
@@ -147,6 +150,16 @@ namespace djv
                     {
                         in >> _options.channel;
                     }
+                    else if (qApp->translate("djv::convert::Context", "-threads") == arg)
+                    {
+                        in >> _options.threads;
+                        _options.threads = qMax(1, _options.threads);
+                    }
+                    else if (qApp->translate("djv::convert::Context", "-queue") == arg)
+                    {
+                        in >> _options.queue;
+                        _options.queue = qMax(1, _options.queue);
+                    }
 
                     // Parse the input options.
                     else if (qApp->translate("djv::convert::Context", "-layer") == arg)
@@ -287,33 +300,40 @@ namespace djv
                 "        Crop the image using floating point values (1.0 = 100%).\n"
                 "    -channel (value)\n"
                 "        Show only specific image channels: %1. Default = %2.\n"
+                "    -threads (value)\n"
+                "        Set the number of threads used to read and convert image sequence "
+                "frames. With more than one thread the conversion is done in software "
+                "instead of with OpenGL, so the output may differ slightly. Default = %3.\n"
+                "    -queue (value)\n"
+                "        Set the maximum number of frames that are read ahead of the frame "
+                "being written. Default = %4.\n"
                 "\n"
                 "Input Options\n"
                 "\n"
                 "    -layer (value)\n"
                 "        Set the input layer.\n"
                 "    -proxy (value)\n"
-                "        Set the proxy scale: %3. Default = %4.\n"
+                "        Set the proxy scale: %5. Default = %6.\n"
                 "    -time (start) (end)\n"
                 "        Set the start and end time.\n"
                 "    -slate (input) (frames)\n"
                 "        Set the slate.\n"
                 "    -timeout (value)\n"
                 "        Set the maximum number of seconds to wait for each input frame. "
-                "Default = %5.\n"
+                "Default = %7.\n"
                 "\n"
                 "Output Options\n"
                 "\n"
                 "    -pixel (value)\n"
-                "        Convert the pixel type: %6.\n"
+                "        Convert the pixel type: %8.\n"
                 "    -speed (value)\n"
-                "        Set the speed: %7.\n"
+                "        Set the speed: %9.\n"
                 "    -tag (name) (value)\n"
                 "        Set an image tag.\n"
                 "    -tags_auto (value)\n"
-                "        Automatically generate image tags (e.g., timecode): %8. "
-                "Default = %9.\n"
-                "%10"
+                "        Automatically generate image tags (e.g., timecode): %10. "
+                "Default = %11.\n"
+                "%12"
                 "\n"
                 "Examples\n"
                 "\n"
@@ -358,6 +378,8 @@ namespace djv
             return QString(label).
                 arg(Graphics::OpenGLImageOptions::channelLabels().join(", ")).
                 arg(channelLabel.join(", ")).
+                arg(_options.threads).
+                arg(_options.queue).
                 arg(Graphics::PixelDataInfo::proxyLabels().join(", ")).
                 arg(proxyLabel.join(", ")).
                 arg(_input.timeout).
@@ -38,6 +38,7 @@
 #include <djvCore/Memory.h>
 #include <djvCore/Sequence.h>
 #include <djvCore/System.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Time.h>
 
 #include <QCoreApplication>
@@ -412,6 +413,12 @@ namespace djv
                             SIGNAL(message(const QString &)),
                             SLOT(debugLogCallback(const QString &)));
                     }
+                    else if (qApp->translate("djv::Core::CoreContext", "-pool_threads") == arg)
+                    {
+                        int value = 0;
+                        in >> value;
+                        ThreadPool::global()->setThreadCount(value);
+                    }
                     else if (
                         qApp->translate("djv::Core::CoreContext", "-help") == arg ||
                         qApp->translate("djv::Core::CoreContext", "-h") == arg)
@@ -491,6 +498,10 @@ namespace djv
                 "\n"
                 "    -debug_log\n"
                 "        Print debug log messages.\n"
+                "    -pool_threads (value)\n"
+                "        Set the number of threads used for image processing and for RLE\n"
+                "        compression. A value of zero uses the number of CPU threads. Default =\n"
+                "        %12.\n"
                 "    -help, -h\n"
                 "        Show the command line documentation.\n"
                 "    -info\n"
@@ -508,7 +519,8 @@ namespace djv
                 arg(Time::unitsLabels().join(", ")).
                 arg(timeUnitsLabel.join(", ")).
                 arg(Speed::fpsLabels().join(", ")).
-                arg(speedLabel.join(", "));
+                arg(speedLabel.join(", ")).
+                arg(ThreadPool::global()->threadCount());
         }
 
         void CoreContext::consolePrint(const QString & string, bool newline, int indent)
@@ -0,0 +1,848 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/FileBatchReader.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+
+#include <QCoreApplication>
+
+#if defined(DJV_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <malloc.h>
+#else // DJV_WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DJV_WINDOWS
+#if defined(DJV_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif // DJV_IO_URING
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            //! The alignment of the memory allocated by default.
+            const size_t alignment = 4096;
+
+            quint8 * allocateDefault(quint64 size)
+            {
+                void * p = nullptr;
+#if defined(DJV_WINDOWS)
+                p = ::_aligned_malloc(size, alignment);
+#else // DJV_WINDOWS
+                if (::posix_memalign(&p, alignment, size) != 0)
+                {
+                    p = nullptr;
+                }
+#endif // DJV_WINDOWS
+                return reinterpret_cast<quint8 *>(p);
+            }
+
+            void releaseDefault(quint8 * p, quint64)
+            {
+#if defined(DJV_WINDOWS)
+                ::_aligned_free(p);
+#else // DJV_WINDOWS
+                ::free(p);
+#endif // DJV_WINDOWS
+            }
+
+#if defined(DJV_WINDOWS)
+            typedef HANDLE File;
+            const File fileInvalid = INVALID_HANDLE_VALUE;
+#else // DJV_WINDOWS
+            typedef int File;
+            const File fileInvalid = -1;
+#endif // DJV_WINDOWS
+
+            //! Open a file for reading and get its size.
+            File fileOpen(const QString & fileName, quint64 & size)
+            {
+#if defined(DJV_WINDOWS)
+                File f = ::CreateFileW(
+                    StringUtil::qToStdWString(fileName).data(),
+                    GENERIC_READ,
+                    FILE_SHARE_READ,
+                    0,
+                    OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN,
+                    0);
+                if (f != fileInvalid)
+                {
+                    LARGE_INTEGER tmp;
+                    size = ::GetFileSizeEx(f, &tmp) ? tmp.QuadPart : 0;
+                }
+#else // DJV_WINDOWS
+                File f = ::open(fileName.toUtf8().data(), O_RDONLY);
+                if (f != fileInvalid)
+                {
+                    struct stat info;
+                    size = 0 == ::fstat(f, &info) ? info.st_size : 0;
+                }
+#endif // DJV_WINDOWS
+                return f;
+            }
+
+            void fileClose(File f)
+            {
+#if defined(DJV_WINDOWS)
+                ::CloseHandle(f);
+#else // DJV_WINDOWS
+                ::close(f);
+#endif // DJV_WINDOWS
+            }
+
+            //! Read from a file, starting at the given offset. This is also used
+            //! to finish short reads.
+            bool fileRead(File f, quint8 * data, quint64 size, quint64 offset)
+            {
+                while (offset < size)
+                {
+                    const quint64 n = std::min(size - offset, static_cast<quint64>(1) << 30);
+#if defined(DJV_WINDOWS)
+                    OVERLAPPED overlapped;
+                    memset(&overlapped, 0, sizeof(OVERLAPPED));
+                    overlapped.Offset = static_cast<DWORD>(offset);
+                    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                    DWORD r = 0;
+                    if (!::ReadFile(f, data + offset, static_cast<DWORD>(n), &r, &overlapped) || 0 == r)
+                    {
+                        return false;
+                    }
+#else // DJV_WINDOWS
+                    const ssize_t r = ::pread(f, data + offset, n, offset);
+                    if (-1 == r && EINTR == errno)
+                    {
+                        continue;
+                    }
+                    if (r <= 0)
+                    {
+                        return false;
+                    }
+#endif // DJV_WINDOWS
+                    offset += r;
+                }
+                return true;
+            }
+
+#if defined(DJV_IO_URING)
+            //! This class provides a minimal io_uring submission and completion
+            //! queue, using the system calls directly.
+            class Ring
+            {
+            public:
+                ~Ring()
+                {
+                    if (_sqes != MAP_FAILED)
+                    {
+                        ::munmap(_sqes, _sqesSize);
+                    }
+                    if (_cqPtr != MAP_FAILED && _cqPtr != _sqPtr)
+                    {
+                        ::munmap(_cqPtr, _cqSize);
+                    }
+                    if (_sqPtr != MAP_FAILED)
+                    {
+                        ::munmap(_sqPtr, _sqSize);
+                    }
+                    if (_f != -1)
+                    {
+                        ::close(_f);
+                    }
+                }
+
+                bool init(unsigned entries)
+                {
+                    io_uring_params params;
+                    memset(&params, 0, sizeof(io_uring_params));
+                    _f = ::syscall(__NR_io_uring_setup, entries, &params);
+                    if (-1 == _f)
+                        return false;
+                    _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                    _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                    const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+                    if (single)
+                    {
+                        _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+                    }
+                    _sqPtr = ::mmap(
+                        0, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _f, IORING_OFF_SQ_RING);
+                    if (MAP_FAILED == _sqPtr)
+                        return false;
+                    _cqPtr = single ? _sqPtr : ::mmap(
+                        0, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _f, IORING_OFF_CQ_RING);
+                    if (MAP_FAILED == _cqPtr)
+                        return false;
+                    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                    _sqes = ::mmap(
+                        0, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _f, IORING_OFF_SQES);
+                    if (MAP_FAILED == _sqes)
+                        return false;
+                    quint8 * sq = reinterpret_cast<quint8 *>(_sqPtr);
+                    _sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+                    _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                    _sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                    _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+                    quint8 * cq = reinterpret_cast<quint8 *>(_cqPtr);
+                    _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                    _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                    _cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                    _cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+                    return true;
+                }
+
+                //! Add a read to the submission queue.
+                void read(int f, const iovec * iov, quint64 userData)
+                {
+                    const unsigned tail = *_sqTail;
+                    const unsigned index = tail & *_sqMask;
+                    io_uring_sqe * sqe = reinterpret_cast<io_uring_sqe *>(_sqes) + index;
+                    memset(sqe, 0, sizeof(io_uring_sqe));
+                    sqe->opcode = IORING_OP_READV;
+                    sqe->fd = f;
+                    sqe->addr = reinterpret_cast<quint64>(iov);
+                    sqe->len = 1;
+                    sqe->off = 0;
+                    sqe->user_data = userData;
+                    _sqArray[index] = index;
+                    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+                }
+
+                //! Submit the queued reads and wait for them to complete. The
+                //! callback is given the user data and result of each read.
+                //!
+                //! If the submission fails the reads that were not submitted are
+                //! removed from the queue, and the reads that were submitted are
+                //! waited on. False is returned if they cannot be waited on, in
+                //! which case the kernel may still be writing to their buffers.
+                bool wait(unsigned count, const std::function<void(quint64, int)> & callback)
+                {
+                    unsigned submit = count;
+                    while (submit > 0 || _inflight > 0)
+                    {
+                        const int r = ::syscall(
+                            __NR_io_uring_enter, _f, submit, submit + _inflight,
+                            IORING_ENTER_GETEVENTS, nullptr, 0);
+                        if (-1 == r)
+                        {
+                            if (EINTR == errno)
+                                continue;
+                            if (submit > 0)
+                            {
+                                __atomic_store_n(
+                                    _sqTail,
+                                    __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE),
+                                    __ATOMIC_RELEASE);
+                                submit = 0;
+                                continue;
+                            }
+                            return false;
+                        }
+                        const unsigned submitted = std::min(static_cast<unsigned>(r), submit);
+                        submit -= submitted;
+                        _inflight += submitted;
+                        unsigned head = *_cqHead;
+                        const unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+                        for (; head != tail; ++head)
+                        {
+                            const io_uring_cqe & cqe = _cqes[head & *_cqMask];
+                            callback(cqe.user_data, cqe.res);
+                            --_inflight;
+                        }
+                        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+                    }
+                    return true;
+                }
+
+            private:
+                int            _f        = -1;
+                void *         _sqPtr    = MAP_FAILED;
+                size_t         _sqSize   = 0;
+                void *         _cqPtr    = MAP_FAILED;
+                size_t         _cqSize   = 0;
+                void *         _sqes     = MAP_FAILED;
+                size_t         _sqesSize = 0;
+                unsigned *     _sqHead   = nullptr;
+                unsigned *     _sqTail   = nullptr;
+                unsigned *     _sqMask   = nullptr;
+                unsigned *     _sqArray  = nullptr;
+                unsigned *     _cqHead   = nullptr;
+                unsigned *     _cqTail   = nullptr;
+                unsigned *     _cqMask   = nullptr;
+                io_uring_cqe * _cqes     = nullptr;
+                unsigned       _inflight = 0;
+            };
+#endif // DJV_IO_URING
+
+        } // namespace
+
+        struct FileBatchReader::Private
+        {
+            struct Entry
+            {
+                enum STATE
+                {
+                    QUEUED,
+                    READING,
+                    DONE,
+                    FAILED
+                };
+
+                STATE     state   = QUEUED;
+                bool      discard = false;
+                quint8 *  data    = nullptr;
+                quint64   size    = 0;
+                Release   release;
+            };
+
+            // A read that is in progress.
+            struct Request
+            {
+                QString  fileName;
+                File     f       = fileInvalid;
+                quint8 * data    = nullptr;
+                quint64  size    = 0;
+                bool     ok      = false;
+#if defined(DJV_IO_URING)
+                iovec    iov;
+#endif // DJV_IO_URING
+            };
+
+            // Read a file that has been opened into memory.
+            void read(Request &, const Allocate &);
+
+            // Finish a request, these functions are called with the mutex locked.
+            void finish(Request &, const Release &);
+            void trim();
+            void releaseOldest();
+
+            BACKEND backend = BACKEND_THREADS;
+            int queueDepth = 0;
+#if defined(DJV_IO_URING)
+            std::unique_ptr<Ring> ring;
+#endif // DJV_IO_URING
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::condition_variable doneCV;
+
+            // These members are protected by the mutex.
+            quint64 byteWindow = byteWindowDefault();
+            Allocate allocate = allocateDefault;
+            Release release = releaseDefault;
+            std::map<QString, Entry> entries;
+            std::deque<QString> queue;
+            std::list<QString> done;
+            quint64 doneBytes = 0;
+            quint64 hits = 0;
+            quint64 misses = 0;
+            bool running = true;
+        };
+
+        void FileBatchReader::Private::read(Request & request, const Allocate & allocate)
+        {
+            if (request.f != fileInvalid && request.size > 0)
+            {
+                // The allocator may throw, in which case the entry is marked as
+                // failed and the file is read normally when it is opened.
+                try
+                {
+                    request.data = allocate(request.size);
+                }
+                catch (const std::exception &)
+                {
+                    request.data = nullptr;
+                }
+                if (request.data)
+                {
+                    request.ok = fileRead(request.f, request.data, request.size, 0);
+                }
+            }
+        }
+
+        void FileBatchReader::Private::finish(Request & request, const Release & release)
+        {
+            if (request.f != fileInvalid)
+            {
+                fileClose(request.f);
+                request.f = fileInvalid;
+            }
+            if (request.data && !request.ok)
+            {
+                release(request.data, request.size);
+                request.data = nullptr;
+            }
+            const auto i = entries.find(request.fileName);
+            if (i == entries.end() || i->second.discard)
+            {
+                if (request.data)
+                {
+                    release(request.data, request.size);
+                }
+                if (i != entries.end())
+                {
+                    entries.erase(i);
+                }
+            }
+            else if (request.ok)
+            {
+                i->second.state = Entry::DONE;
+                i->second.data = request.data;
+                i->second.size = request.size;
+                i->second.release = release;
+                done.push_back(request.fileName);
+                doneBytes += request.size;
+                trim();
+            }
+            else
+            {
+                i->second.state = Entry::FAILED;
+            }
+        }
+
+        void FileBatchReader::Private::trim()
+        {
+            while (doneBytes > byteWindow && done.size())
+            {
+                releaseOldest();
+            }
+        }
+
+        void FileBatchReader::Private::releaseOldest()
+        {
+            const auto i = entries.find(done.front());
+            done.pop_front();
+            i->second.release(i->second.data, i->second.size);
+            doneBytes -= i->second.size;
+            entries.erase(i);
+        }
+
+        const QStringList & FileBatchReader::backendLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Core::FileBatchReader", "Threads") <<
+                qApp->translate("djv::Core::FileBatchReader", "io_uring");
+            DJV_ASSERT(data.count() == BACKEND_COUNT);
+            return data;
+        }
+
+        FileBatchReader::FileBatchReader(int queueDepth, BACKEND backend) :
+            _p(new Private)
+        {
+            _p->queueDepth = std::max(queueDepth, 1);
+#if defined(DJV_IO_URING)
+            if (BACKEND_IO_URING == backend)
+            {
+                _p->ring.reset(new Ring);
+                if (_p->ring->init(_p->queueDepth))
+                {
+                    _p->backend = BACKEND_IO_URING;
+                    _p->threads.push_back(std::thread(&FileBatchReader::ioUringRun, this));
+                }
+                else
+                {
+                    _p->ring.reset();
+                }
+            }
+#endif // DJV_IO_URING
+            if (BACKEND_THREADS == _p->backend)
+            {
+                for (int i = 0; i < _p->queueDepth; ++i)
+                {
+                    _p->threads.push_back(std::thread(&FileBatchReader::threadsRun, this));
+                }
+            }
+        }
+
+        FileBatchReader::~FileBatchReader()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->running = false;
+            }
+            _p->cv.notify_all();
+            for (auto & thread : _p->threads)
+            {
+                thread.join();
+            }
+            clear();
+        }
+
+        FileBatchReader::BACKEND FileBatchReader::backend() const
+        {
+            return _p->backend;
+        }
+
+        int FileBatchReader::queueDepth() const
+        {
+            return _p->queueDepth;
+        }
+
+        quint64 FileBatchReader::byteWindow() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->byteWindow;
+        }
+
+        void FileBatchReader::setByteWindow(quint64 value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->byteWindow = value;
+            _p->trim();
+        }
+
+        void FileBatchReader::setAllocator(const Allocate & allocate, const Release & release)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->allocate = allocate;
+            _p->release = release;
+        }
+
+        void FileBatchReader::submit(const QStringList & fileNames)
+        {
+            //DJV_DEBUG("FileBatchReader::submit");
+            //DJV_DEBUG_PRINT("file names = " << fileNames);
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                if (0 == _p->byteWindow)
+                    return;
+
+                // Files that are never opened, for example after a seek, would
+                // otherwise fill the window and stop any more reads.
+                while (_p->doneBytes >= _p->byteWindow && _p->done.size())
+                {
+                    _p->releaseOldest();
+                }
+                Q_FOREACH(const QString & fileName, fileNames)
+                {
+                    if (_p->entries.find(fileName) == _p->entries.end())
+                    {
+                        _p->entries[fileName] = Private::Entry();
+                        _p->queue.push_back(fileName);
+                    }
+                }
+            }
+            _p->cv.notify_all();
+        }
+
+        void FileBatchReader::open(const QString & fileName, FileIO & io)
+        {
+            //DJV_DEBUG("FileBatchReader::open");
+            //DJV_DEBUG_PRINT("file name = " << fileName);
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            auto i = _p->entries.find(fileName);
+            if (i != _p->entries.end() && Private::Entry::QUEUED == i->second.state)
+            {
+                // The read has not started so move it to the front of the queue.
+                _p->queue.erase(std::find(_p->queue.begin(), _p->queue.end(), fileName));
+                _p->queue.push_front(fileName);
+                _p->cv.notify_all();
+            }
+            _p->doneCV.wait(lock, [this, &fileName, &i]
+            {
+                i = _p->entries.find(fileName);
+                return
+                    i == _p->entries.end() ||
+                    (i->second.state != Private::Entry::QUEUED &&
+                     i->second.state != Private::Entry::READING);
+            });
+            if (i != _p->entries.end() && Private::Entry::DONE == i->second.state)
+            {
+                const Private::Entry entry = i->second;
+                _p->done.erase(std::find(_p->done.begin(), _p->done.end(), fileName));
+                _p->doneBytes -= entry.size;
+                _p->entries.erase(i);
+                ++_p->hits;
+                lock.unlock();
+                io.open(fileName, entry.data, entry.size, entry.release);
+                return;
+            }
+            if (i != _p->entries.end())
+            {
+                _p->entries.erase(i);
+            }
+            ++_p->misses;
+            lock.unlock();
+            io.open(fileName, FileIO::READ);
+        }
+
+        void FileBatchReader::clear()
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            for (auto i = _p->entries.begin(); i != _p->entries.end();)
+            {
+                switch (i->second.state)
+                {
+                case Private::Entry::READING:
+                    i->second.discard = true;
+                    ++i;
+                    break;
+                case Private::Entry::DONE:
+                    i->second.release(i->second.data, i->second.size);
+                    i = _p->entries.erase(i);
+                    break;
+                default:
+                    i = _p->entries.erase(i);
+                    break;
+                }
+            }
+            _p->queue.clear();
+            _p->done.clear();
+            _p->doneBytes = 0;
+        }
+
+        void FileBatchReader::clear(const QStringList & fileNames)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            Q_FOREACH(const QString & fileName, fileNames)
+            {
+                const auto i = _p->entries.find(fileName);
+                if (i == _p->entries.end())
+                    continue;
+                switch (i->second.state)
+                {
+                case Private::Entry::QUEUED:
+                    _p->queue.erase(std::find(_p->queue.begin(), _p->queue.end(), fileName));
+                    _p->entries.erase(i);
+                    break;
+                case Private::Entry::READING:
+                    i->second.discard = true;
+                    break;
+                case Private::Entry::DONE:
+                    _p->done.erase(std::find(_p->done.begin(), _p->done.end(), fileName));
+                    _p->doneBytes -= i->second.size;
+                    i->second.release(i->second.data, i->second.size);
+                    _p->entries.erase(i);
+                    break;
+                default:
+                    _p->entries.erase(i);
+                    break;
+                }
+            }
+        }
+
+        quint64 FileBatchReader::hits() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->hits;
+        }
+
+        quint64 FileBatchReader::misses() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->misses;
+        }
+
+        quint64 FileBatchReader::pendingBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->doneBytes;
+        }
+
+        int FileBatchReader::queueDepthDefault()
+        {
+            return 8;
+        }
+
+        quint64 FileBatchReader::byteWindowDefault()
+        {
+            return 512 * Memory::megabyte;
+        }
+
+        FileBatchReader * FileBatchReader::global()
+        {
+            // The global reader is not deleted so that the threads are not
+            // joined while the application is exiting.
+            static FileBatchReader * reader = new FileBatchReader;
+            return reader;
+        }
+
+        void FileBatchReader::threadsRun()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (_p->running)
+            {
+                if (_p->queue.empty())
+                {
+                    _p->cv.wait(lock);
+                    continue;
+                }
+                Private::Request request;
+                request.fileName = _p->queue.front();
+                _p->queue.pop_front();
+                _p->entries[request.fileName].state = Private::Entry::READING;
+                const Allocate allocate = _p->allocate;
+                const Release release = _p->release;
+                lock.unlock();
+
+                request.f = fileOpen(request.fileName, request.size);
+                _p->read(request, allocate);
+
+                lock.lock();
+                _p->finish(request, release);
+                _p->doneCV.notify_all();
+            }
+        }
+
+        void FileBatchReader::ioUringRun()
+        {
+#if defined(DJV_IO_URING)
+            std::vector<Private::Request> requests;
+            bool ring = true;
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (_p->running)
+            {
+                if (_p->queue.empty())
+                {
+                    _p->cv.wait(lock);
+                    continue;
+                }
+
+                // Take a batch of files from the queue.
+                requests.clear();
+                while (requests.size() < static_cast<size_t>(_p->queueDepth) && !_p->queue.empty())
+                {
+                    Private::Request request;
+                    request.fileName = _p->queue.front();
+                    _p->queue.pop_front();
+                    _p->entries[request.fileName].state = Private::Entry::READING;
+                    requests.push_back(request);
+                }
+                const Allocate allocate = _p->allocate;
+                const Release release = _p->release;
+                lock.unlock();
+
+                // Open the files and submit the reads together.
+                unsigned count = 0;
+                for (size_t i = 0; i < requests.size(); ++i)
+                {
+                    Private::Request & request = requests[i];
+                    request.f = fileOpen(request.fileName, request.size);
+                    if (request.f != fileInvalid && request.size > 0)
+                    {
+                        try
+                        {
+                            request.data = allocate(request.size);
+                        }
+                        catch (const std::exception &)
+                        {
+                            request.data = nullptr;
+                        }
+                        if (request.data && ring)
+                        {
+                            request.iov.iov_base = request.data;
+                            request.iov.iov_len = request.size;
+                            _p->ring->read(request.f, &request.iov, i);
+                            ++count;
+                        }
+                    }
+                }
+                std::vector<qint64> results(requests.size(), 0);
+                std::vector<bool> completed(requests.size(), false);
+                if (count && !_p->ring->wait(count, [&results, &completed](quint64 index, int result)
+                {
+                    if (index < results.size())
+                    {
+                        results[index] = result;
+                        completed[index] = true;
+                    }
+                }))
+                {
+                    // The reads that did not complete may still be in progress,
+                    // so their buffers are abandoned rather than released. The
+                    // ring is not used again and the files are read with the
+                    // file descriptors instead.
+                    for (size_t i = 0; i < requests.size(); ++i)
+                    {
+                        if (requests[i].data && !completed[i])
+                        {
+                            requests[i].data = nullptr;
+                        }
+                    }
+                    ring = false;
+                }
+
+                // Finish short reads, and any reads that could not be completed
+                // by the ring, with the file descriptor.
+                for (size_t i = 0; i < requests.size(); ++i)
+                {
+                    Private::Request & request = requests[i];
+                    if (request.data)
+                    {
+                        request.ok = fileRead(
+                            request.f,
+                            request.data,
+                            request.size,
+                            results[i] > 0 ? results[i] : 0);
+                    }
+                }
+
+                lock.lock();
+                for (auto & request : requests)
+                {
+                    _p->finish(request, release);
+                }
+                _p->doneCV.notify_all();
+            }
+#endif // DJV_IO_URING
+        }
+
+    } // namespace Core
+
+    _DJV_STRING_OPERATOR_LABEL(Core::FileBatchReader::BACKEND, Core::FileBatchReader::backendLabels())
+
+} // namespace djv
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/StringUtil.h>
+#include <djvCore/Util.h>
+
+#include <QMetaType>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        class FileIO;
+
+        //! This class provides batched reading of whole files into memory. The
+        //! reads for several files are submitted at the same time, so that the
+        //! storage can work on them in parallel. On Linux the reads are submitted
+        //! with io_uring when it is available, otherwise they are read by a pool
+        //! of threads.
+        //!
+        //! This is used by the image loaders to read the frames of uncompressed
+        //! file sequences.
+        class FileBatchReader
+        {
+            Q_GADGET
+
+        public:
+            //! This enumeration provides the backends used for reading.
+            enum BACKEND
+            {
+                BACKEND_THREADS,
+                BACKEND_IO_URING,
+
+                BACKEND_COUNT
+            };
+            Q_ENUM(BACKEND);
+
+            //! Get the backend labels.
+            static const QStringList & backendLabels();
+
+            //! Create a new batch reader. The queue depth is the number of files
+            //! that are read at the same time. If io_uring is not available the
+            //! threads backend is used instead.
+            explicit FileBatchReader(
+                int     queueDepth = queueDepthDefault(),
+                BACKEND            = BACKEND_IO_URING);
+
+            ~FileBatchReader();
+
+            //! Get the backend.
+            BACKEND backend() const;
+
+            //! Get the queue depth.
+            int queueDepth() const;
+
+            //! Get the maximum number of bytes of files that have been read but
+            //! not opened. The oldest files are released when this is exceeded.
+            quint64 byteWindow() const;
+
+            //! Set the maximum number of bytes of files that have been read but
+            //! not opened.
+            void setByteWindow(quint64);
+
+            //! This typedef provides a function for allocating memory.
+            typedef std::function<quint8 * (quint64)> Allocate;
+
+            //! This typedef provides a function for releasing memory.
+            typedef std::function<void(quint8 *, quint64)> Release;
+
+            //! Set the functions used to allocate and release the memory for the
+            //! files. By default page-aligned memory is allocated from the heap.
+            void setAllocator(const Allocate &, const Release &);
+
+            //! Submit reads for a batch of files. Files that have already been
+            //! submitted are ignored. If the byte window is full the oldest files
+            //! that have been read but not opened are released to make room.
+            void submit(const QStringList &);
+
+            //! Open a file for reading. If the file has been submitted this waits
+            //! for the read to finish and the file is opened from memory,
+            //! otherwise the file is opened normally.
+            //!
+            //! Throws:
+            //! - Error
+            void open(const QString &, FileIO &);
+
+            //! Cancel the reads that have not started, and release the files that
+            //! have been read but not opened.
+            void clear();
+
+            //! Cancel the reads of the given files that have not started, and
+            //! release the given files that have been read but not opened.
+            void clear(const QStringList &);
+
+            //! Get the number of files that were opened from memory.
+            quint64 hits() const;
+
+            //! Get the number of files that were opened normally.
+            quint64 misses() const;
+
+            //! Get the number of bytes of files that have been read but not
+            //! opened.
+            quint64 pendingBytes() const;
+
+            //! Get the default queue depth.
+            static int queueDepthDefault();
+
+            //! Get the default byte window.
+            static quint64 byteWindowDefault();
+
+            //! Get the global batch reader.
+            static FileBatchReader * global();
+
+        private:
+            void threadsRun();
+            void ioUringRun();
+
+            DJV_PRIVATE_COPY(FileBatchReader);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+
+    DJV_STRING_OPERATOR(Core::FileBatchReader::BACKEND);
+
+} // namespace djv
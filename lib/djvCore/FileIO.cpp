@@ -54,20 +54,77 @@
 #endif // DJV_MMAP
 #if defined(DJV_WINDOWS)
 #include <io.h>
+#include <malloc.h>
 #else // DJV_WINDOWS
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 #endif // DJV_WINDOWS
 
+#include <algorithm>
+#include <new>
+
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 namespace djv
 {
     namespace Core
     {
+        namespace
+        {
+            quint64 _writeBufferSizeDefault = 1024 * 1024;
+
+            //! The size of the buffer used for endian conversion when buffering
+            //! is disabled.
+            const quint64 endianBufferSize = 65536;
+
+            //! The minimum size of the write buffer, so that it can hold a word
+            //! for endian conversion.
+            const quint64 writeBufferSizeMin = 16;
+
+            //! The alignment of the memory and reads used for direct reads. This is
+            //! a multiple of the sector size of the storage.
+            const quint64 directAlignmentValue = 4096;
+
+            //! The size of each read used for direct reads.
+            const quint64 directReadSize = 8 * 1024 * 1024;
+
+            quint8 * directAllocateDefault(quint64 size)
+            {
+                void * p = nullptr;
+#if defined(DJV_WINDOWS)
+                p = ::_aligned_malloc(size, directAlignmentValue);
+#else // DJV_WINDOWS
+                if (::posix_memalign(&p, directAlignmentValue, size) != 0)
+                {
+                    p = nullptr;
+                }
+#endif // DJV_WINDOWS
+                if (!p)
+                {
+                    throw std::bad_alloc();
+                }
+                return reinterpret_cast<quint8 *>(p);
+            }
+
+            void directReleaseDefault(quint8 * p, quint64)
+            {
+#if defined(DJV_WINDOWS)
+                ::_aligned_free(p);
+#else // DJV_WINDOWS
+                ::free(p);
+#endif // DJV_WINDOWS
+            }
+
+            FileIO::Allocate _directAllocate = directAllocateDefault;
+            FileIO::Release  _directRelease = directReleaseDefault;
+
+        } // namespace
+
         struct FileIO::Private
         {
             Private() :
@@ -93,15 +150,48 @@ namespace djv
             const quint8 *  mmapStart = nullptr;
             const quint8 *  mmapEnd = nullptr;
             const quint8 *  mmapP = nullptr;
+
+            quint8 *                               memory = nullptr;
+            std::function<void(quint8 *, quint64)> memoryRelease;
+
+            // Get whether reads use the memory-map pointers, either because the
+            // file is memory-mapped or because it has been read into memory.
+            bool isMapped() const
+            {
+#if defined(DJV_MMAP)
+                return READ == mode;
+#else // DJV_MMAP
+                return memory != nullptr;
+#endif // DJV_MMAP
+            }
+
+            quint64                   writeBufferSize = _writeBufferSizeDefault;
+            std::unique_ptr<quint8[]> buffer;
+            quint64                   bufferCapacity = 0;
+            quint64                   bufferUsed = 0;
         };
 
+        FileIO::Block::Block()
+        {}
+
+        FileIO::Block::Block(const void * p, quint64 size, int wordSize) :
+            p(p),
+            size(size),
+            wordSize(wordSize)
+        {}
+
         FileIO::FileIO() :
             _p(new Private)
         {}
 
         FileIO::~FileIO()
         {
-            close();
+            try
+            {
+                close();
+            }
+            catch (const Error &)
+            {}
         }
 
         void FileIO::open(const QString & fileName, MODE mode)
@@ -132,14 +222,10 @@ namespace djv
                     arg(QDir::toNativeSeparators(fileName)));
             }
 #else // DJV_WINDOWS
-            int readFlag = 0;
-#if defined(DJV_LINUX)
-            //readFlag = O_DIRECT;
-#endif // DJV_LINUX
             _p->f = ::open(
                 fileName.toUtf8().data(),
                 (WRITE == mode) ?
-                (O_WRONLY | O_CREAT | O_TRUNC) : (O_RDONLY | readFlag),
+                (O_WRONLY | O_CREAT | O_TRUNC) : (O_RDONLY),
                 (WRITE == mode) ?
                 (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) : (0));
             if (-1 == _p->f)
@@ -210,10 +296,183 @@ namespace djv
 #endif // DJV_MMAP
         }
 
+        void FileIO::open(
+            const QString &                                  fileName,
+            quint8 *                                         data,
+            quint64                                          size,
+            const std::function<void(quint8 *, quint64)> & release)
+        {
+            //DJV_DEBUG("FileIO::open");
+            //DJV_DEBUG_PRINT("file name = " << fileName);
+            //DJV_DEBUG_PRINT("size = " << size);
+
+            close();
+
+            _p->fileName = fileName;
+            _p->pos = 0;
+            _p->size = size;
+            _p->mode = READ;
+            _p->memory = data;
+            _p->memoryRelease = release;
+            _p->mmapStart = data;
+            _p->mmapEnd = data + size;
+            _p->mmapP = data;
+        }
+
+        void FileIO::openDirect(const QString & fileName)
+        {
+            //DJV_DEBUG("FileIO::openDirect");
+            //DJV_DEBUG_PRINT("file name = " << fileName);
+
+            close();
+
+            // Allocate the memory. The reads are rounded up to the alignment, the
+            // last one is cut short by the end of the file.
+            const quint64 size = FileInfo(fileName).size();
+            //DJV_DEBUG_PRINT("size = " << size);
+            const quint64 capacity = std::max(
+                (size + directAlignmentValue - 1) / directAlignmentValue * directAlignmentValue,
+                directAlignmentValue);
+            const Allocate allocate = _directAllocate;
+            const Release release = _directRelease;
+            quint8 * data = allocate(capacity);
+
+            // Open the file, bypassing the file cache. Some file systems (for
+            // example tmpfs on Linux) do not support this, in which case the file
+            // is read normally and dropped from the cache afterwards.
+#if defined(DJV_WINDOWS)
+            HANDLE f = ::CreateFileW(
+                StringUtil::qToStdWString(fileName).data(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                0,
+                OPEN_EXISTING,
+                FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN,
+                0);
+            if (INVALID_HANDLE_VALUE == f)
+            {
+                release(data, capacity);
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_OPEN].
+                    arg(QDir::toNativeSeparators(fileName)));
+            }
+#else // DJV_WINDOWS
+            bool direct = false;
+            int f = -1;
+#if defined(DJV_LINUX)
+            f = ::open(fileName.toUtf8().data(), O_RDONLY | O_DIRECT);
+            direct = f != -1;
+#endif // DJV_LINUX
+            if (-1 == f)
+            {
+                f = ::open(fileName.toUtf8().data(), O_RDONLY);
+            }
+            if (-1 == f)
+            {
+                release(data, capacity);
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_OPEN].
+                    arg(QDir::toNativeSeparators(fileName)));
+            }
+#if defined(DJV_OSX)
+            direct = ::fcntl(f, F_NOCACHE, 1) != -1;
+#endif // DJV_OSX
+#endif // DJV_WINDOWS
+
+            // Read the file.
+            quint64 pos = 0;
+            while (pos < size)
+            {
+                const quint64 readSize = std::min(capacity - pos, directReadSize);
+#if defined(DJV_WINDOWS)
+                DWORD n = 0;
+                if (!::ReadFile(f, data + pos, static_cast<DWORD>(readSize), &n, 0) || !n)
+                {
+                    break;
+                }
+#else // DJV_WINDOWS
+                const ssize_t n = ::pread(f, data + pos, readSize, pos);
+                if (-1 == n && EINTR == errno)
+                {
+                    continue;
+                }
+#if defined(DJV_LINUX)
+                if (-1 == n && EINVAL == errno && direct)
+                {
+                    // The file system does not support unaligned reads, for
+                    // example after a short read, so finish reading normally.
+                    ::fcntl(f, F_SETFL, ::fcntl(f, F_GETFL) & ~O_DIRECT);
+                    direct = false;
+                    continue;
+                }
+#endif // DJV_LINUX
+                if (n <= 0)
+                {
+                    break;
+                }
+#endif // DJV_WINDOWS
+                pos += n;
+            }
+#if defined(DJV_WINDOWS)
+            ::CloseHandle(f);
+#else // DJV_WINDOWS
+#if defined(DJV_LINUX)
+            if (!direct)
+            {
+                ::posix_fadvise(f, 0, 0, POSIX_FADV_DONTNEED);
+            }
+#endif // DJV_LINUX
+            ::close(f);
+#endif // DJV_WINDOWS
+            if (pos < size)
+            {
+                release(data, capacity);
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_READ].
+                    arg(QDir::toNativeSeparators(fileName)));
+            }
+
+            // The memory is released with the size it was allocated with rather
+            // than the file size.
+            open(fileName, data, size, [release, capacity](quint8 * p, quint64)
+            {
+                release(p, capacity);
+            });
+        }
+
         void FileIO::close()
         {
             //DJV_DEBUG("FileIO::close");
 
+            // Flush the write buffer, keeping any error until the file is closed.
+            Error error;
+            bool errorValid = false;
+            try
+            {
+                flush();
+            }
+            catch (const Error & otherError)
+            {
+                error = otherError;
+                errorValid = true;
+            }
+
+            if (_p->memory)
+            {
+                if (_p->memoryRelease)
+                {
+                    _p->memoryRelease(_p->memory, _p->size);
+                }
+                _p->memory = nullptr;
+                _p->memoryRelease = nullptr;
+                _p->mmapStart = 0;
+                _p->mmapEnd = 0;
+                _p->mmapP = 0;
+            }
+
 #if defined(DJV_MMAP)
 #if defined(DJV_WINDOWS)
             if (_p->mmapStart != 0)
@@ -234,7 +493,7 @@ namespace djv
             }
 #else // DJV_WINDOWS
             _p->mmapStart = 0;
-            if (_p->mmap != (void *)-1)
+            if (_p->mmap && _p->mmap != (void *)-1)
             {
                 //DJV_DEBUG_PRINT("munmap");
                 int r = ::munmap(_p->mmap, _p->size);
@@ -272,6 +531,9 @@ namespace djv
             _p->pos = 0;
             _p->size = 0;
             _p->mode = static_cast<MODE>(0);
+
+            if (errorValid)
+                throw error;
         }
 
         const QString & FileIO::fileName() const
@@ -283,9 +545,9 @@ namespace djv
         {
             return
 #if defined(DJV_WINDOWS)
-                _p->f != INVALID_HANDLE_VALUE &&
+                (_p->f != INVALID_HANDLE_VALUE || _p->memory) &&
 #else
-                _p->f != -1 &&
+                (_p->f != -1 || _p->memory) &&
 #endif
                 (_p->size ? _p->pos < _p->size : true);
         }
@@ -301,49 +563,52 @@ namespace djv
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("word size = " << wordSize);
 
-#if defined(DJV_MMAP)
-            const quint8 * p = _p->mmapP + size * wordSize;
-            if (p > _p->mmapEnd)
-            {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_READ].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
-            }
-            if (_p->endian && wordSize > 1)
+            if (_p->isMapped())
             {
-                Memory::convertEndian(_p->mmapP, in, size, wordSize);
+                const quint8 * p = _p->mmapP + size * wordSize;
+                if (p > _p->mmapEnd)
+                {
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_READ].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
+                if (_p->endian && wordSize > 1)
+                {
+                    Memory::convertEndian(_p->mmapP, in, size, wordSize);
+                }
+                else
+                {
+                    memcpy(in, _p->mmapP, size * wordSize);
+                }
+                _p->mmapP = p;
             }
             else
             {
-                memcpy(in, _p->mmapP, size * wordSize);
-            }
-            _p->mmapP = p;
-#else // DJV_MMAP
 #if defined(DJV_WINDOWS)
-            DWORD n;
-            if (!::ReadFile(_p->f, in, size * wordSize, &n, 0))
-            {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_READ].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
-            }
+                DWORD n;
+                if (!::ReadFile(_p->f, in, size * wordSize, &n, 0))
+                {
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_READ].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
 #else // DJV_WINDOWS
-    //if (-1 == ::read(_p->f, in, size * wordSize) == (size * wordSize))
-    //{
-    //    throw Error(
-    //        "djv::Core::FileIO",
-    //        errorLabels()[ERROR_READ].
-    //        arg(QDir::toNativeSeparators(_p->fileName)));
-    //}
-            ::read(_p->f, in, size * wordSize);
-            if (_p->endian && wordSize > 1)
-            {
-                Memory::convertEndian(in, size, wordSize);
-            }
+        //if (-1 == ::read(_p->f, in, size * wordSize) == (size * wordSize))
+        //{
+        //    throw Error(
+        //        "djv::Core::FileIO",
+        //        errorLabels()[ERROR_READ].
+        //        arg(QDir::toNativeSeparators(_p->fileName)));
+        //}
+                ::read(_p->f, in, size * wordSize);
+                if (_p->endian && wordSize > 1)
+                {
+                    Memory::convertEndian(in, size, wordSize);
+                }
 #endif // DJV_WINDOWS
-#endif // DJV_MMAP
+            }
             _p->pos += size * wordSize;
         }
 
@@ -353,41 +618,67 @@ namespace djv
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("word size = " << wordSize);
             //DJV_DEBUG_PRINT("endian = " << _p->endian);
+            const Block block(in, size, wordSize);
+            write(&block, 1);
+        }
 
-            quint8 * p = (quint8 *)in;
-            std::vector<quint8> tmp;
-            if (_p->endian && wordSize > 1)
-            {
-                tmp.resize(size * wordSize);
-                p = tmp.data();
-                Memory::convertEndian(in, p, size, wordSize);
-            }
+        void FileIO::set(const std::vector<Block> & in)
+        {
+            //DJV_DEBUG("FileIO::set");
+            //DJV_DEBUG_PRINT("blocks = " << in.size());
+            write(in.data(), in.size());
+        }
 
-#if defined(DJV_WINDOWS)
-            DWORD n;
-            if (!::WriteFile(_p->f, p, static_cast<DWORD>(size * wordSize), &n, 0))
+        void FileIO::flush()
+        {
+            if (_p->bufferUsed)
             {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_WRITE].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
+                //DJV_DEBUG("FileIO::flush");
+                //DJV_DEBUG_PRINT("size = " << _p->bufferUsed);
+                const quint64 size = _p->bufferUsed;
+                _p->bufferUsed = 0;
+                writeSystem(_p->buffer.get(), size);
             }
-#else
-            if (::write(_p->f, p, size * wordSize) == -1)
-            {
-                throw Error(
-                    "djv::Core::FileIO",
-                    errorLabels()[ERROR_WRITE].
-                    arg(QDir::toNativeSeparators(_p->fileName)));
-            }
-#endif
+        }
 
-            _p->pos += size * wordSize;
-            _p->size = Math::max(_p->pos, _p->size);
+        quint64 FileIO::writeBufferSize() const
+        {
+            return _p->writeBufferSize;
+        }
+
+        void FileIO::setWriteBufferSize(quint64 value)
+        {
+            flush();
+            _p->writeBufferSize = value;
+            _p->buffer.reset();
+            _p->bufferCapacity = 0;
+        }
+
+        quint64 FileIO::writeBufferSizeDefault()
+        {
+            return _writeBufferSizeDefault;
+        }
+
+        void FileIO::setWriteBufferSizeDefault(quint64 value)
+        {
+            _writeBufferSizeDefault = value;
+        }
+
+        void FileIO::setDirectAllocator(const Allocate & allocate, const Release & release)
+        {
+            _directAllocate = allocate;
+            _directRelease = release;
+        }
+
+        quint64 FileIO::directAlignment()
+        {
+            return directAlignmentValue;
         }
 
         void FileIO::readAhead()
         {
+            if (_p->memory)
+                return;
 #if defined(DJV_MMAP)
 #if defined(DJV_LINUX)
             ::madvise((void *)_p->mmapStart, _p->size, MADV_WILLNEED);
@@ -464,28 +755,29 @@ namespace djv
             switch (_p->mode)
             {
             case READ:
-#if defined(DJV_MMAP)
-                if (!seek)
-                {
-                    _p->mmapP = reinterpret_cast<const quint8 *>(_p->mmapStart) + in;
-                }
-                else
+                if (_p->isMapped())
                 {
-                    _p->mmapP += in;
-                }
-                if (_p->mmapP > _p->mmapEnd)
-                {
-                    throw Error(
-                        "djv::Core::FileIO",
-                        errorLabels()[ERROR_SET_POS].
-                        arg(QDir::toNativeSeparators(_p->fileName)));
+                    if (!seek)
+                    {
+                        _p->mmapP = reinterpret_cast<const quint8 *>(_p->mmapStart) + in;
+                    }
+                    else
+                    {
+                        _p->mmapP += in;
+                    }
+                    if (_p->mmapP > _p->mmapEnd)
+                    {
+                        throw Error(
+                            "djv::Core::FileIO",
+                            errorLabels()[ERROR_SET_POS].
+                            arg(QDir::toNativeSeparators(_p->fileName)));
+                    }
+                    break;
                 }
-                break;
-#else
                 // Fall through...
-#endif
             case WRITE:
             {
+                flush();
 #if defined(DJV_WINDOWS)
                 if (!::SetFilePointer(
                     _p->f,
@@ -520,6 +812,142 @@ namespace djv
             }
         }
 
+        void FileIO::write(const Block * blocks, size_t count)
+        {
+            if (_p->mode != WRITE)
+            {
+                throw Error(
+                    "djv::Core::FileIO",
+                    errorLabels()[ERROR_WRITE].
+                    arg(QDir::toNativeSeparators(_p->fileName)));
+            }
+
+            // Allocate the write buffer. When buffering is disabled the buffer is
+            // only used for endian conversion and is flushed after every call.
+            const quint64 capacity = _p->writeBufferSize ?
+                Math::max(_p->writeBufferSize, writeBufferSizeMin) :
+                endianBufferSize;
+            if (capacity != _p->bufferCapacity)
+            {
+                flush();
+                _p->buffer.reset(new quint8[capacity]);
+                _p->bufferCapacity = capacity;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const quint8 * p = reinterpret_cast<const quint8 *>(blocks[i].p);
+                const int wordSize = blocks[i].wordSize;
+                const quint64 byteCount = blocks[i].size * wordSize;
+                if (!byteCount)
+                {
+                    continue;
+                }
+                if (_p->endian && wordSize > 1)
+                {
+                    // Convert the endian directly into the write buffer.
+                    quint64 size = blocks[i].size;
+                    while (size)
+                    {
+                        quint64 words = (capacity - _p->bufferUsed) / wordSize;
+                        if (!words)
+                        {
+                            flush();
+                            continue;
+                        }
+                        words = Math::min(words, size);
+                        Memory::convertEndian(p, _p->buffer.get() + _p->bufferUsed, words, wordSize);
+                        _p->bufferUsed += words * wordSize;
+                        p += words * wordSize;
+                        size -= words;
+                    }
+                }
+                else if (byteCount <= capacity - _p->bufferUsed)
+                {
+                    memcpy(_p->buffer.get() + _p->bufferUsed, p, byteCount);
+                    _p->bufferUsed += byteCount;
+                }
+                else
+                {
+                    // Write the buffer and the block together.
+                    const quint64 size = _p->bufferUsed;
+                    _p->bufferUsed = 0;
+                    writeSystem(_p->buffer.get(), size, p, byteCount);
+                }
+                _p->pos += byteCount;
+                _p->size = Math::max(_p->pos, _p->size);
+            }
+
+            if (!_p->writeBufferSize)
+            {
+                flush();
+            }
+        }
+
+        void FileIO::writeSystem(const void * a, quint64 aSize, const void * b, quint64 bSize)
+        {
+            //DJV_DEBUG("FileIO::writeSystem");
+            //DJV_DEBUG_PRINT("a size = " << aSize);
+            //DJV_DEBUG_PRINT("b size = " << bSize);
+#if defined(DJV_WINDOWS)
+            const void * p[] = { a, b };
+            const quint64 size[] = { aSize, bSize };
+            for (int i = 0; i < 2; ++i)
+            {
+                DWORD n;
+                if (size[i] && !::WriteFile(_p->f, p[i], static_cast<DWORD>(size[i]), &n, 0))
+                {
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_WRITE].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
+            }
+#else // DJV_WINDOWS
+            iovec iov[2];
+            int count = 0;
+            if (aSize)
+            {
+                iov[count].iov_base = const_cast<void *>(a);
+                iov[count].iov_len = aSize;
+                ++count;
+            }
+            if (bSize)
+            {
+                iov[count].iov_base = const_cast<void *>(b);
+                iov[count].iov_len = bSize;
+                ++count;
+            }
+            int i = 0;
+            while (i < count)
+            {
+                const ssize_t r = ::writev(_p->f, iov + i, count - i);
+                if (-1 == r)
+                {
+                    if (EINTR == errno)
+                        continue;
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_WRITE].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
+
+                // Skip past the data that was written.
+                size_t n = static_cast<size_t>(r);
+                while (i < count && n >= iov[i].iov_len)
+                {
+                    n -= iov[i].iov_len;
+                    ++i;
+                }
+                if (i < count)
+                {
+                    iov[i].iov_base = reinterpret_cast<quint8 *>(iov[i].iov_base) + n;
+                    iov[i].iov_len -= n;
+                }
+            }
+#endif // DJV_WINDOWS
+        }
+
         const QStringList & FileIO::errorLabels()
         {
             static const QStringList data = QStringList() <<
@@ -35,7 +35,9 @@
 
 #include <QMetaType>
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -64,7 +66,41 @@ namespace djv
             //! - Error
             void open(const QString & fileName, MODE);
 
-            //! Close the file.
+            //! Open a file that has already been read into memory, for example by
+            //! FileBatchReader. The file is opened for reading and the memory is
+            //! released with the given function when the file is closed.
+            void open(
+                const QString &                                  fileName,
+                quint8 *                                         data,
+                quint64                                          size,
+                const std::function<void(quint8 *, quint64)> & release);
+
+            //! Open a file for reading without using the operating system's file
+            //! cache. The whole file is read into memory with sector-aligned reads,
+            //! so that large files do not take up memory in the cache as well.
+            //!
+            //! Throws:
+            //! - Error
+            void openDirect(const QString & fileName);
+
+            //! This typedef provides a function for allocating memory.
+            typedef std::function<quint8 * (quint64)> Allocate;
+
+            //! This typedef provides a function for releasing memory.
+            typedef std::function<void(quint8 *, quint64)> Release;
+
+            //! Set the functions used to allocate and release the memory for
+            //! openDirect(). The memory must be aligned to directAlignment(). By
+            //! default page-aligned memory is allocated from the heap.
+            static void setDirectAllocator(const Allocate &, const Release &);
+
+            //! Get the alignment of the memory and reads used by openDirect().
+            static quint64 directAlignment();
+
+            //! Close the file. The write buffer is flushed first.
+            //!
+            //! Throws:
+            //! - Error
             void close();
 
             //! Get the file name.
@@ -89,11 +125,31 @@ namespace djv
             inline void getU32(quint32 *, quint64 = 1);
             inline void getF32(float *, quint64 = 1);
 
-            //! Set data.
+            //! Set data. The data is copied into the write buffer and written to
+            //! the file when the buffer is full.
             //!
             //! Throws:
             //! - Error
             void set(const void *, quint64, int wordSize = 1);
+
+            //! This struct provides a block of data for set().
+            struct Block
+            {
+                Block();
+                Block(const void *, quint64, int wordSize = 1);
+
+                const void * p        = nullptr;
+                quint64      size     = 0;
+                int          wordSize = 1;
+            };
+
+            //! Set multiple blocks of data, for example a header and the pixel
+            //! data. Large blocks are written together with the write buffer in
+            //! a single system call.
+            //!
+            //! Throws:
+            //! - Error
+            void set(const std::vector<Block> &);
             inline void set8(const qint8 *, quint64);
             inline void setU8(const quint8 *, quint64);
             inline void set16(const qint16 *, quint64);
@@ -109,6 +165,27 @@ namespace djv
             inline void setU32(const quint32 &);
             inline void setF32(const float &);
 
+            //! Write the contents of the write buffer to the file.
+            //!
+            //! Throws:
+            //! - Error
+            void flush();
+
+            //! Get the size of the write buffer.
+            quint64 writeBufferSize() const;
+
+            //! Set the size of the write buffer. A size of zero disables buffering.
+            //!
+            //! Throws:
+            //! - Error
+            void setWriteBufferSize(quint64);
+
+            //! Get the default size of the write buffer.
+            static quint64 writeBufferSizeDefault();
+
+            //! Set the default size of the write buffer.
+            static void setWriteBufferSizeDefault(quint64);
+
             //! Start an asynchronous read-ahead. This allows the operating system to
             //! cache the file by the time we need it.
             void readAhead();
@@ -164,6 +241,8 @@ namespace djv
 
         private:
             void setPos(quint64, bool seek);
+            void write(const Block *, size_t);
+            void writeSystem(const void *, quint64, const void * = nullptr, quint64 = 0);
 
             DJV_PRIVATE_COPY(FileIO);
 
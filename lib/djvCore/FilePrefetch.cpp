@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/FilePrefetch.h>
+
+#include <djvCore/Memory.h>
+#include <djvCore/Sequence.h>
+#include <djvCore/StringUtil.h>
+
+#if defined(DJV_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else // DJV_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DJV_WINDOWS
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+#if ! defined(DJV_LINUX)
+            const size_t readSize = 1024 * 1024;
+#endif // ! DJV_LINUX
+
+        } // namespace
+
+        struct FilePrefetch::Private
+        {
+            // Get the files ahead of the playhead.
+            QStringList aheadFiles() const;
+
+            // Remove the prefetched files that are no longer ahead of the
+            // playhead.
+            void prune();
+
+            std::thread thread;
+            mutable std::mutex mutex;
+            std::condition_variable cv;
+            std::condition_variable doneCV;
+
+            // These members are protected by the mutex.
+            FileInfo fileInfo;
+            qint64 playhead = 0;
+            int direction = 1;
+            FrameList frames;
+            bool hasFrames = false;
+            int frameCount = frameCountDefault();
+            quint64 byteWindow = byteWindowDefault();
+            std::map<QString, quint64> prefetched;
+            quint64 outstandingBytes = 0;
+            quint64 lastSize = 0;
+            bool idle = true;
+            bool running = true;
+        };
+
+        QStringList FilePrefetch::Private::aheadFiles() const
+        {
+            QStringList out;
+            const FrameList & sequence = fileInfo.sequence().frames;
+            const qint64 size = sequence.count();
+            if (fileInfo.type() != FileInfo::SEQUENCE)
+            {
+                return out;
+            }
+            if (hasFrames)
+            {
+                const int count = std::min(frameCount, frames.count());
+                for (int i = 0; i < count; ++i)
+                {
+                    const qint64 index = frames[i];
+                    if (index >= 0 && index < size)
+                    {
+                        out += fileInfo.fileName(sequence[index]);
+                    }
+                }
+                return out;
+            }
+            if (size < 2)
+            {
+                return out;
+            }
+            const qint64 count = std::min(static_cast<qint64>(frameCount), size - 1);
+            for (qint64 i = 1; i <= count; ++i)
+            {
+                const qint64 index = ((playhead + i * direction) % size + size) % size;
+                out += fileInfo.fileName(sequence[index]);
+            }
+            return out;
+        }
+
+        void FilePrefetch::Private::prune()
+        {
+            const QStringList files = aheadFiles();
+            outstandingBytes = 0;
+            for (auto i = prefetched.begin(); i != prefetched.end();)
+            {
+                if (files.contains(i->first))
+                {
+                    outstandingBytes += i->second;
+                    ++i;
+                }
+                else
+                {
+                    i = prefetched.erase(i);
+                }
+            }
+            idle = false;
+            cv.notify_one();
+        }
+
+        FilePrefetch::FilePrefetch() :
+            _p(new Private)
+        {
+            _p->thread = std::thread(&FilePrefetch::run, this);
+        }
+
+        FilePrefetch::~FilePrefetch()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->running = false;
+            }
+            _p->cv.notify_one();
+            _p->thread.join();
+        }
+
+        const FileInfo & FilePrefetch::fileInfo() const
+        {
+            return _p->fileInfo;
+        }
+
+        void FilePrefetch::setFileInfo(const FileInfo & value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->fileInfo = value;
+            _p->playhead = 0;
+            _p->prune();
+        }
+
+        qint64 FilePrefetch::playhead() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->playhead;
+        }
+
+        int FilePrefetch::direction() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->direction;
+        }
+
+        void FilePrefetch::setPlayhead(qint64 value, int direction)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            if (value == _p->playhead && direction == _p->direction && !_p->hasFrames)
+                return;
+            _p->playhead = value;
+            _p->direction = direction < 0 ? -1 : 1;
+            _p->frames.clear();
+            _p->hasFrames = false;
+            _p->prune();
+        }
+
+        FrameList FilePrefetch::frames() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->frames;
+        }
+
+        void FilePrefetch::setFrames(const FrameList & value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            if (value == _p->frames && _p->hasFrames)
+                return;
+            _p->frames = value;
+            _p->hasFrames = true;
+            _p->prune();
+        }
+
+        int FilePrefetch::frameCount() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->frameCount;
+        }
+
+        void FilePrefetch::setFrameCount(int value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->frameCount = std::max(value, 0);
+            _p->prune();
+        }
+
+        quint64 FilePrefetch::byteWindow() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->byteWindow;
+        }
+
+        void FilePrefetch::setByteWindow(quint64 value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->byteWindow = value;
+            _p->prune();
+        }
+
+        quint64 FilePrefetch::outstandingBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->outstandingBytes;
+        }
+
+        void FilePrefetch::wait()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->doneCV.wait(lock, [this] { return _p->idle; });
+        }
+
+        quint64 FilePrefetch::prefetch(const QString & fileName)
+        {
+            //DJV_DEBUG("FilePrefetch::prefetch");
+            //DJV_DEBUG_PRINT("file name = " << fileName);
+            quint64 size = 0;
+#if defined(DJV_WINDOWS)
+            HANDLE f = ::CreateFileW(
+                StringUtil::qToStdWString(fileName).data(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                0,
+                OPEN_EXISTING,
+                FILE_FLAG_SEQUENTIAL_SCAN,
+                0);
+            if (INVALID_HANDLE_VALUE == f)
+            {
+                return 0;
+            }
+            size = ::GetFileSize(f, 0);
+            std::vector<quint8> buf(readSize);
+            DWORD n = 0;
+            while (::ReadFile(f, buf.data(), static_cast<DWORD>(buf.size()), &n, 0) && n > 0)
+                ;
+            ::CloseHandle(f);
+#else // DJV_WINDOWS
+            const int f = ::open(fileName.toUtf8().data(), O_RDONLY);
+            if (-1 == f)
+            {
+                return 0;
+            }
+            struct stat info;
+            if (0 == ::fstat(f, &info))
+            {
+                size = info.st_size;
+            }
+#if defined(DJV_LINUX)
+            // Let the kernel read the file into the page cache without copying
+            // it to user space.
+            ::readahead(f, 0, size);
+#else // DJV_LINUX
+            std::vector<quint8> buf(readSize);
+            while (::read(f, buf.data(), buf.size()) > 0)
+                ;
+#endif // DJV_LINUX
+            ::close(f);
+#endif // DJV_WINDOWS
+            //DJV_DEBUG_PRINT("size = " << size);
+            return size;
+        }
+
+        int FilePrefetch::frameCountDefault()
+        {
+            return 24;
+        }
+
+        quint64 FilePrefetch::byteWindowDefault()
+        {
+            return 512 * Memory::megabyte;
+        }
+
+        void FilePrefetch::run()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (_p->running)
+            {
+                // Find the next file to prefetch. The window is checked against
+                // the size of the previous file so that it is not exceeded.
+                QString fileName;
+                if (_p->outstandingBytes + (_p->outstandingBytes ? _p->lastSize : 0) <= _p->byteWindow)
+                {
+                    Q_FOREACH(const QString & file, _p->aheadFiles())
+                    {
+                        if (_p->prefetched.find(file) == _p->prefetched.end())
+                        {
+                            fileName = file;
+                            break;
+                        }
+                    }
+                }
+                if (fileName.isEmpty())
+                {
+                    _p->idle = true;
+                    _p->doneCV.notify_all();
+                    _p->cv.wait(lock);
+                    continue;
+                }
+
+                // Prefetch the file without holding the lock.
+                lock.unlock();
+                const quint64 size = prefetch(fileName);
+                lock.lock();
+
+                // Check that the file is still ahead of the playhead, it may
+                // have changed while the file was being read.
+                _p->lastSize = size;
+                if (_p->aheadFiles().contains(fileName))
+                {
+                    _p->prefetched[fileName] = size;
+                    _p->outstandingBytes += size;
+                }
+            }
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/FileInfo.h>
+#include <djvCore/Sequence.h>
+#include <djvCore/Util.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides asynchronous prefetching of the files in a file
+        //! sequence. The files ahead of the playhead are read into the operating
+        //! system cache by a background thread, so that loading them later does
+        //! not wait on the storage. This hides the latency of network storage
+        //! when playing back sequences of large files such as DPX or OpenEXR.
+        class FilePrefetch
+        {
+        public:
+            FilePrefetch();
+
+            ~FilePrefetch();
+
+            //! Get the file sequence.
+            const FileInfo & fileInfo() const;
+
+            //! Set the file sequence. Setting a file that is not a sequence
+            //! stops prefetching.
+            void setFileInfo(const FileInfo &);
+
+            //! Get the playhead, as an index into the sequence frames.
+            qint64 playhead() const;
+
+            //! Get the playback direction.
+            int direction() const;
+
+            //! Set the playhead, as an index into the sequence frames, and the
+            //! playback direction (1 for forward, -1 for reverse). The frames past
+            //! the end of the sequence wrap around to the start.
+            void setPlayhead(qint64, int direction = 1);
+
+            //! Get the frames to prefetch.
+            FrameList frames() const;
+
+            //! Set the frames to prefetch instead of the frames ahead of the
+            //! playhead, as indices into the sequence frames in the order they
+            //! will be played. This is used when playback does not simply wrap
+            //! around the sequence, for example with an in/out range or ping-pong
+            //! looping. Only the first frame count frames are prefetched. Setting
+            //! the playhead goes back to prefetching the frames ahead of it.
+            void setFrames(const FrameList &);
+
+            //! Get the number of frames to prefetch ahead of the playhead.
+            int frameCount() const;
+
+            //! Set the number of frames to prefetch ahead of the playhead.
+            void setFrameCount(int);
+
+            //! Get the maximum number of bytes to prefetch ahead of the playhead.
+            quint64 byteWindow() const;
+
+            //! Set the maximum number of bytes to prefetch ahead of the playhead.
+            void setByteWindow(quint64);
+
+            //! Get the number of bytes that have been prefetched ahead of the
+            //! playhead.
+            quint64 outstandingBytes() const;
+
+            //! Wait until the background thread has prefetched the files ahead of
+            //! the playhead.
+            void wait();
+
+            //! Read a file into the operating system cache. This blocks until the
+            //! file has been read and returns the size of the file, or zero if the
+            //! file cannot be opened.
+            static quint64 prefetch(const QString & fileName);
+
+            //! Get the default number of frames to prefetch.
+            static int frameCountDefault();
+
+            //! Get the default maximum number of bytes to prefetch.
+            static quint64 byteWindowDefault();
+
+        private:
+            void run();
+
+            DJV_PRIVATE_COPY(FilePrefetch);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+} // namespace djv
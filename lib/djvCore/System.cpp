@@ -51,6 +51,7 @@
 #endif // DJV_WINDOWS
 
 #include <iostream>
+#include <thread>
 
 namespace djv
 {
@@ -209,6 +210,11 @@ namespace djv
             return out;
         }
 
+        int System::cpuCount()
+        {
+            return Math::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
         const QString & System::djvPathEnv()
         {
             static const QString var = "DJV_PATH";
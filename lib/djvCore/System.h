@@ -47,6 +47,9 @@ namespace djv
             //! Get system information.
             static QString info();
 
+            //! Get the number of threads the CPU can run at the same time.
+            static int cpuCount();
+
             //! Get the DJV_PATH environment variable name.
             static const QString & djvPathEnv();
 
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/ThreadPool.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/System.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        struct ThreadPool::Private
+        {
+            int threadCount = 1;
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::condition_variable doneCV;
+
+            // These members are protected by the mutex.
+            std::deque<std::function<void()> > queue;
+            bool running = true;
+        };
+
+        ThreadPool::ThreadPool(int threadCount) :
+            _p(new Private)
+        {
+            setThreadCount(threadCount);
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            setThreadCount(1);
+        }
+
+        int ThreadPool::threadCount() const
+        {
+            return _p->threadCount;
+        }
+
+        void ThreadPool::setThreadCount(int value)
+        {
+            //DJV_DEBUG("ThreadPool::setThreadCount");
+            //DJV_DEBUG_PRINT("value = " << value);
+            const int threadCount = value > 0 ? value : System::cpuCount();
+            if (threadCount == _p->threadCount && _p->threads.size())
+                return;
+
+            // Stop the current threads. Any work left in the queue is finished
+            // by the threads waiting in parallelFor().
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->running = false;
+            }
+            _p->cv.notify_all();
+            _p->doneCV.notify_all();
+            for (auto & i : _p->threads)
+            {
+                i.join();
+            }
+            _p->threads.clear();
+
+            _p->threadCount = threadCount;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->running = true;
+            }
+            for (int i = 1; i < threadCount; ++i)
+            {
+                _p->threads.push_back(std::thread([this] { run(); }));
+            }
+        }
+
+        void ThreadPool::parallelFor(int size, int bandMin, const std::function<void(int, int)> & fnc)
+        {
+            //DJV_DEBUG("ThreadPool::parallelFor");
+            //DJV_DEBUG_PRINT("size = " << size);
+            //DJV_DEBUG_PRINT("band min = " << bandMin);
+            if (size <= 0)
+                return;
+            const int bands = Math::min(_p->threadCount, Math::max(1, size / Math::max(1, bandMin)));
+            //DJV_DEBUG_PRINT("bands = " << bands);
+            if (bands < 2)
+            {
+                fnc(0, size);
+                return;
+            }
+            const int band = (size + bands - 1) / bands;
+
+            // Add the bands to the queue, except for the first band which is
+            // processed by this thread.
+            int remaining = 0;
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                for (int i = band; i < size; i += band)
+                {
+                    ++remaining;
+                    _p->queue.push_back([this, &fnc, &remaining, &error, i, band, size]
+                    {
+                        std::exception_ptr tmp;
+                        try
+                        {
+                            fnc(i, Math::min(i + band, size));
+                        }
+                        catch (...)
+                        {
+                            tmp = std::current_exception();
+                        }
+                        std::unique_lock<std::mutex> lock(_p->mutex);
+                        if (tmp)
+                        {
+                            error = tmp;
+                        }
+                        --remaining;
+                        _p->doneCV.notify_all();
+                    });
+                }
+            }
+            _p->cv.notify_all();
+            try
+            {
+                fnc(0, band);
+            }
+            catch (...)
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                error = std::current_exception();
+            }
+
+            // Help with the work in the queue until all of the bands are
+            // finished. This also keeps nested calls from dead-locking.
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                while (remaining > 0)
+                {
+                    if (!_p->queue.empty())
+                    {
+                        auto task = std::move(_p->queue.front());
+                        _p->queue.pop_front();
+                        lock.unlock();
+                        task();
+                        lock.lock();
+                    }
+                    else
+                    {
+                        _p->doneCV.wait(lock);
+                    }
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        ThreadPool * ThreadPool::global()
+        {
+            // The global pool is not deleted so that the threads are not
+            // joined while the application is exiting.
+            static ThreadPool * pool = new ThreadPool;
+            return pool;
+        }
+
+        void ThreadPool::run()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (_p->running)
+            {
+                if (!_p->queue.empty())
+                {
+                    auto task = std::move(_p->queue.front());
+                    _p->queue.pop_front();
+                    lock.unlock();
+                    task();
+                    lock.lock();
+                }
+                else
+                {
+                    _p->cv.wait(lock);
+                }
+            }
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <functional>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a pool of worker threads.
+        class ThreadPool
+        {
+        public:
+            //! Create a new thread pool. If the thread count is zero the CPU
+            //! count is used.
+            explicit ThreadPool(int threadCount = 0);
+
+            ~ThreadPool();
+
+            //! Get the number of threads. The thread that calls parallelFor()
+            //! is counted as one of the threads.
+            int threadCount() const;
+
+            //! Set the number of threads. If the thread count is zero the CPU
+            //! count is used. This should not be called while parallelFor() is
+            //! running.
+            void setThreadCount(int);
+
+            //! Run a function over a range of values split into bands, for
+            //! example the scanlines of an image. The function is given the
+            //! first value and one past the last value of a band. Each band has
+            //! at least the given minimum number of values, so small ranges are
+            //! processed serially on the calling thread. This function returns
+            //! when all of the bands have been processed.
+            void parallelFor(int size, int bandMin, const std::function<void(int, int)> &);
+
+            //! Get the global thread pool.
+            static ThreadPool * global();
+
+        private:
+            void run();
+
+            DJV_PRIVATE_COPY(ThreadPool);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+} // namespace djv
@@ -49,6 +49,16 @@ namespace djv
             return data;
         }
 
+        const QStringList & Cineon::readLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Graphics::Cineon", "Memory Map") <<
+                qApp->translate("djv::Graphics::Cineon", "Batch") <<
+                qApp->translate("djv::Graphics::Cineon", "Direct");
+            DJV_ASSERT(data.count() == READ_COUNT);
+            return data;
+        }
+
         PixelData Cineon::linearToFilmPrintLut(const LinearToFilmPrint & value)
         {
             //DJV_DEBUG("Cineon::linearToFilmPrintLut");
@@ -173,7 +183,8 @@ namespace djv
                 qApp->translate("djv::Graphics::Cineon", "Input Color Profile") <<
                 qApp->translate("djv::Graphics::Cineon", "Input Film Print") <<
                 qApp->translate("djv::Graphics::Cineon", "Output Color Profile") <<
-                qApp->translate("djv::Graphics::Cineon", "Output Film Print");
+                qApp->translate("djv::Graphics::Cineon", "Output Film Print") <<
+                qApp->translate("djv::Graphics::Cineon", "Input Read");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
@@ -250,5 +261,6 @@ namespace djv
     }
 
     _DJV_STRING_OPERATOR_LABEL(Graphics::Cineon::COLOR_PROFILE, Graphics::Cineon::colorProfileLabels())
+    _DJV_STRING_OPERATOR_LABEL(Graphics::Cineon::READ, Graphics::Cineon::readLabels())
 
 } // namespace djv
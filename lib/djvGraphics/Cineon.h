@@ -54,6 +54,19 @@ namespace djv
             //! Get the color profile labels.
             static const QStringList & colorProfileLabels();
 
+            //! This enumeration provides the methods used to read files.
+            enum READ
+            {
+                READ_MMAP,   //!< Memory-map each file
+                READ_BATCH,  //!< Read several files at once, see Core::FileBatchReader
+                READ_DIRECT, //!< Read each file without the file cache
+
+                READ_COUNT
+            };
+
+            //! Get the read method labels.
+            static const QStringList & readLabels();
+
             //! This struct provides options to convert from a linear color space to
             //! the Cineon film print color space.
             //!
@@ -118,6 +131,7 @@ namespace djv
                 INPUT_FILM_PRINT_OPTION,
                 OUTPUT_COLOR_PROFILE_OPTION,
                 OUTPUT_FILM_PRINT_OPTION,
+                INPUT_READ_OPTION,
 
                 OPTIONS_COUNT
             };
@@ -132,6 +146,7 @@ namespace djv
                 Cineon::FilmPrintToLinear inputFilmPrint;
                 Cineon::COLOR_PROFILE     outputColorProfile = Cineon::COLOR_PROFILE_FILM_PRINT;
                 Cineon::LinearToFilmPrint outputFilmPrint;
+                Cineon::READ              inputRead          = Cineon::READ_MMAP;
             };
         };
 
@@ -145,5 +160,6 @@ namespace djv
     DJV_STRING_OPERATOR(Graphics::Cineon::LinearToFilmPrint);
     DJV_STRING_OPERATOR(Graphics::Cineon::FilmPrintToLinear);
     DJV_STRING_OPERATOR(Graphics::Cineon::COLOR_PROFILE);
+    DJV_STRING_OPERATOR(Graphics::Cineon::READ);
 
 } // namespace djv
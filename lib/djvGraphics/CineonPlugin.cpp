@@ -78,6 +78,10 @@ namespace djv
             {
                 out << _options.outputFilmPrint;
             }
+            else if (0 == in.compare(options()[Cineon::INPUT_READ_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.inputRead;
+            }
             return out;
         }
 
@@ -131,6 +135,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[Cineon::INPUT_READ_OPTION], Qt::CaseInsensitive))
+                {
+                    Cineon::READ read = static_cast<Cineon::READ>(0);
+                    data >> read;
+                    if (read != _options.inputRead)
+                    {
+                        _options.inputRead = read;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -173,6 +187,11 @@ namespace djv
                     {
                         in >> _options.outputFilmPrint;
                     }
+                    else if (
+                        qApp->translate("djv::Graphics::CineonPlugin", "-cineon_input_read") == arg)
+                    {
+                        in >> _options.inputRead;
+                    }
                     else
                     {
                         tmp << arg;
@@ -196,6 +215,8 @@ namespace djv
             outputColorProfileLabel << _options.outputColorProfile;
             QStringList outputFilmPrintLabel;
             outputFilmPrintLabel << _options.outputFilmPrint;
+            QStringList inputReadLabel;
+            inputReadLabel << _options.inputRead;
             return qApp->translate("djv::Graphics::CineonPlugin",
                 "\n"
                 "Cineon Options\n"
@@ -211,13 +232,17 @@ namespace djv
                 "Default = %5.\n"
                 "    -cineon_output_film_print (black) (white) (gamma) (soft clip)\n"
                 "        Set the film print values used when saving Cineon images. Default = "
-                "%6.\n").
+                "%6.\n"
+                "    -cineon_input_read (value)\n"
+                "        Set the method used to read Cineon files: %7. Default = %8.\n").
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(inputColorProfileLabel.join(", ")).
                 arg(inputFilmPrintLabel.join(", ")).
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(outputColorProfileLabel.join(", ")).
-                arg(outputFilmPrintLabel.join(", "));
+                arg(outputFilmPrintLabel.join(", ")).
+                arg(Cineon::readLabels().join(", ")).
+                arg(inputReadLabel.join(", "));
         }
 
         ImageLoad * CineonPlugin::createLoad() const
@@ -68,6 +68,17 @@ namespace djv
 
             //DJV_DEBUG_PRINT("info = " << _info);
 
+            // Set the color profile. The lookup table is created once here
+            // instead of for every frame.
+            _colorProfile = ColorProfile();
+            if (Cineon::COLOR_PROFILE_FILM_PRINT == _options.outputColorProfile ||
+                Cineon::COLOR_PROFILE_AUTO == _options.outputColorProfile)
+            {
+                //DJV_DEBUG_PRINT("color profile");
+                _colorProfile.type = ColorProfile::LUT;
+                _colorProfile.lut = Cineon::linearToFilmPrintLut(_options.outputFilmPrint);
+            }
+
             _image.set(_info);
         }
 
@@ -77,16 +88,6 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
 
-            // Set the color profile.
-            ColorProfile colorProfile;
-            if (Cineon::COLOR_PROFILE_FILM_PRINT == _options.outputColorProfile ||
-                Cineon::COLOR_PROFILE_AUTO == _options.outputColorProfile)
-            {
-                //DJV_DEBUG_PRINT("color profile");
-                colorProfile.type = ColorProfile::LUT;
-                colorProfile.lut = Cineon::linearToFilmPrintLut(_options.outputFilmPrint);
-            }
-
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
             //DJV_DEBUG_PRINT("file name = " << fileName);
@@ -102,19 +103,20 @@ namespace djv
             const PixelData * p = &in;
             if (in.info() != _info ||
                 in.colorProfile.type != ColorProfile::RAW ||
-                colorProfile.type != ColorProfile::RAW)
+                _colorProfile.type != ColorProfile::RAW)
             {
                 //Core::_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
                 OpenGLImageOptions options;
-                options.colorProfile = colorProfile;
-                OpenGLImage().copy(*p, _image, options);
+                options.colorProfile = _colorProfile;
+                openGLImage().copy(*p, _image, options);
                 p = &_image;
             }
 
             // Write the file.
             io.set(p->data(), p->dataByteCount());
             _header.saveEnd(io);
+
+            io.close();
         }
 
     } // namespace Graphics
@@ -58,6 +58,7 @@ namespace djv
             CineonHeader    _header;
             PixelDataInfo   _info;
             Image           _image;
+            ColorProfile    _colorProfile;
         };
 
     } // namespace Graphics
@@ -114,7 +114,8 @@ namespace djv
                 qApp->translate("djv::Graphics::DPX", "Output Film Print") <<
                 qApp->translate("djv::Graphics::DPX", "Version") <<
                 qApp->translate("djv::Graphics::DPX", "Type") <<
-                qApp->translate("djv::Graphics::DPX", "Endian");
+                qApp->translate("djv::Graphics::DPX", "Endian") <<
+                qApp->translate("djv::Graphics::DPX", "Input Read");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
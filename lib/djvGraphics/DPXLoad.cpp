@@ -53,8 +53,10 @@ namespace djv
             //DJV_DEBUG("DPXLoad::open");
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
+            const QString fileName = _file.fileName(_file.sequence().start());
             Core::FileIO io;
-            _open(_file.fileName(_file.sequence().start()), info, io);
+            io.open(fileName, Core::FileIO::READ);
+            _open(fileName, info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
                 info.sequence.frames = _file.sequence().frames;
@@ -65,7 +67,6 @@ namespace djv
         {
             //DJV_DEBUG("DPXLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
-            io.open(in, Core::FileIO::READ);
             info.fileName = in;
             _filmPrint = false;
             DPXHeader header;
@@ -80,11 +81,17 @@ namespace djv
             //DJV_DEBUG_PRINT("frame = " << frame);
 
             // Open the file.
-            const QString fileName =
-                _file.fileName(frame.frame != -1 ? frame.frame : _file.sequence().start());
+            const qint64 frameNumber = frame.frame != -1 ? frame.frame : _file.sequence().start();
+            const QString fileName = _file.fileName(frameNumber);
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
             QScopedPointer<Core::FileIO> io(new Core::FileIO);
+            switch (_options.inputRead)
+            {
+            case Cineon::READ_BATCH:  batchOpen(_file, frameNumber, *io); break;
+            case Cineon::READ_DIRECT: io->openDirect(fileName); break;
+            default: io->open(fileName, Core::FileIO::READ); break;
+            }
             _open(fileName, info, *io);
             image.tags = info.tags;
 
@@ -107,26 +114,39 @@ namespace djv
 
             // Read the file.
             io->readAhead();
-            bool mmap = true;
-            if ((io->size() - io->pos()) < PixelDataUtil::dataByteCount(info))
-            {
-                mmap = false;
-            }
-            //DJV_DEBUG_PRINT("mmap = " << mmap);
-            if (mmap)
+            if (mapPixelData(frame.proxy ? _tmp : image, info, io))
             {
-                if (!frame.proxy)
-                {
-                    image.set(info, io->mmapP(), io.data());
-                    io.take();
-                }
-                else
+                if (frame.proxy)
                 {
-                    _tmp.set(info, io->mmapP());
                     info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
                     info.proxy = frame.proxy;
                     image.set(info);
                     PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                    _tmp.close();
+                }
+            }
+            else if (frame.proxy &&
+                PixelDataUtil::PROXY_FILTER_NEAREST == PixelDataUtil::proxyFilter())
+            {
+                // Only read the scanlines that are used by the proxy.
+                const quint64 pos = io->pos();
+                const int proxyScale = PixelDataUtil::proxyScale(frame.proxy);
+                const int pixelByteCount = Pixel::byteCount(info.pixel);
+                const quint64 scanlineByteCount = info.size.x * pixelByteCount;
+                std::vector<quint8> scanline(scanlineByteCount);
+                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                info.proxy = frame.proxy;
+                image.set(info);
+                for (int y = 0; y < info.size.y; ++y)
+                {
+                    io->setPos(pos + static_cast<quint64>(y) * proxyScale * scanlineByteCount);
+                    io->get(scanline.data(), scanlineByteCount);
+                    PixelDataUtil::proxyScaleScanline(
+                        scanline.data(),
+                        image.data(0, y),
+                        info.size.x,
+                        pixelByteCount,
+                        frame.proxy);
                 }
             }
             else
@@ -87,6 +87,10 @@ namespace djv
             {
                 out << _options.endian;
             }
+            else if (0 == in.compare(options()[DPX::INPUT_READ_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.inputRead;
+            }
 
             return out;
         }
@@ -168,6 +172,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[DPX::INPUT_READ_OPTION], Qt::CaseInsensitive))
+                {
+                    Cineon::READ read = static_cast<Cineon::READ>(0);
+                    data >> read;
+                    if (read != _options.inputRead)
+                    {
+                        _options.inputRead = read;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -225,6 +239,11 @@ namespace djv
                     {
                         in >> _options.endian;
                     }
+                    else if (
+                        qApp->translate("djv::Graphics::DPXPlugin", "-dpx_input_read") == arg)
+                    {
+                        in >> _options.inputRead;
+                    }
                     else
                     {
                         tmp << arg;
@@ -254,6 +273,8 @@ namespace djv
             typeLabel << _options.type;
             QStringList endianLabel;
             endianLabel << _options.endian;
+            QStringList inputReadLabel;
+            inputReadLabel << _options.inputRead;
             return qApp->translate("djv::Graphics::DPXPlugin",
                 "\n"
                 "DPX Options\n"
@@ -278,7 +299,9 @@ namespace djv
                 "Default = %10.\n"
                 "    -dpx_endian (value)\n"
                 "        Set the endian used when saving DPX images: %11. Default = "
-                "%12.\n").
+                "%12.\n"
+                "    -dpx_input_read (value)\n"
+                "        Set the method used to read DPX files: %13. Default = %14.\n").
                 arg(Cineon::colorProfileLabels().join(", ")).
                 arg(inputColorProfileLabel.join(", ")).
                 arg(inputFilmPrintLabel.join(", ")).
@@ -290,7 +313,9 @@ namespace djv
                 arg(DPX::typeLabels().join(", ")).
                 arg(typeLabel.join(", ")).
                 arg(DPX::endianLabels().join(", ")).
-                arg(endianLabel.join(", "));
+                arg(endianLabel.join(", ")).
+                arg(Cineon::readLabels().join(", ")).
+                arg(inputReadLabel.join(", "));
         }
 
         ImageLoad * DPXPlugin::createLoad() const
@@ -58,6 +58,7 @@ namespace djv
             DPXHeader      _header;
             PixelDataInfo  _info;
             Image          _image;
+            ColorProfile   _colorProfile;
         };
 
     } // namespace Graphics
@@ -94,7 +94,9 @@ namespace djv
 
         FFmpeg::Options::Options() :
             format(MPEG4),
-            quality(HIGH)
+            quality(HIGH),
+            threadCount(0),
+            decodeCache(4)
         {}
 
         const QString FFmpeg::staticName = "FFmpeg";
@@ -139,7 +141,9 @@ namespace djv
         {
             static const QStringList data = QStringList() <<
                 qApp->translate("djv::Graphics::FFmpeg", "Format") <<
-                qApp->translate("djv::Graphics::FFmpeg", "Quality");
+                qApp->translate("djv::Graphics::FFmpeg", "Quality") <<
+                qApp->translate("djv::Graphics::FFmpeg", "Thread Count") <<
+                qApp->translate("djv::Graphics::FFmpeg", "Decode Cache");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
@@ -90,6 +90,8 @@ namespace djv
             {
                 OPTIONS_FORMAT,
                 OPTIONS_QUALITY,
+                OPTIONS_THREAD_COUNT,
+                OPTIONS_DECODE_CACHE,
 
                 OPTIONS_COUNT
             };
@@ -142,6 +144,15 @@ namespace djv
 
                 FORMAT  format;
                 QUALITY quality;
+
+                //! The number of decoding threads, zero picks the number
+                //! automatically.
+                int     threadCount;
+
+                //! The number of decoded frames kept by the loader for random
+                //! access. Each frame is a full decoded picture, so this is kept
+                //! small by default.
+                int     decodeCache;
             };
         };
 
@@ -35,9 +35,12 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Debug.h>
 #include <djvCore/FileIOUtil.h>
+#include <djvCore/Math.h>
 
 #include <QCoreApplication>
 
+#include <limits>
+
 extern "C"
 {
 #include <libavutil/imgutils.h>
@@ -48,8 +51,9 @@ namespace djv
 {
     namespace Graphics
     {
-        FFmpegLoad::FFmpegLoad(const QPointer<Core::CoreContext> & context) :
-            ImageLoad(context)
+        FFmpegLoad::FFmpegLoad(const FFmpeg::Options & options, const QPointer<Core::CoreContext> & context) :
+            ImageLoad(context),
+            _options(options)
         {}
 
         FFmpegLoad::~FFmpegLoad()
@@ -129,6 +133,12 @@ namespace djv
                     FFmpeg::staticName,
                     FFmpeg::toString(r));
             }
+
+            // Enable frame and slice threading, the codec uses whichever it
+            // supports.
+            _avCodecContext->thread_count = _options.threadCount;
+            _avCodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+            //DJV_DEBUG_PRINT("thread count = " << _options.threadCount);
             r = avcodec_open2(_avCodecContext, avCodec, 0);
             if (r < 0)
             {
@@ -202,8 +212,10 @@ namespace djv
                     _avVideoStream,
                     0,
                     AVSEEK_FLAG_BACKWARD);
+                avcodec_flush_buffers(_avCodecContext);
             }
             //DJV_DEBUG_PRINT("nbFrames = " << static_cast<qint64>(nbFrames));
+            _frame = -1;
 
             _info.sequence = Core::Sequence(0, nbFrames - 1, 0, speed);
             info = _info;
@@ -216,15 +228,39 @@ namespace djv
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
-            PixelData * data = frame.proxy ? &_tmp : &image;
-            data->set(_info);
+
+            // Proxies are scaled by the software scaler at the same time as the
+            // color conversion, instead of converting the full size frame first.
+            PixelDataInfo info = _info;
+            SwsContext * swsContext = _swsContext;
+            if (frame.proxy)
+            {
+                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                info.proxy = frame.proxy;
+                _swsProxyContext = sws_getCachedContext(
+                    _swsProxyContext,
+                    _avCodecParameters->width,
+                    _avCodecParameters->height,
+                    static_cast<AVPixelFormat>(_avCodecParameters->format),
+                    info.size.x,
+                    info.size.y,
+                    AV_PIX_FMT_RGBA,
+                    PixelDataUtil::PROXY_FILTER_NEAREST == PixelDataUtil::proxyFilter() ?
+                        SWS_POINT :
+                        SWS_AREA,
+                    0,
+                    0,
+                    0);
+                swsContext = _swsProxyContext;
+            }
+            image.set(info);
             av_image_fill_arrays(
                 _avFrameRgb->data,
                 _avFrameRgb->linesize,
-                data->data(),
+                image.data(),
                 AV_PIX_FMT_RGBA,
-                data->w(),
-                data->h(),
+                image.w(),
+                image.h(),
                 1);
 
             int f = frame.frame;
@@ -234,58 +270,109 @@ namespace djv
             }
             //DJV_DEBUG_PRINT("frame = " << f);
 
-            AVStream * avStream = _avFormatContext->streams[_avVideoStream];
-            int64_t pts = 0;
-            if (f != _frame + 1)
+            // Frames that have already been decoded are taken from the cache.
+            AVFrame * avFrame = cachedFrame(f);
+            //DJV_DEBUG_PRINT("cached = " << (avFrame != nullptr));
+            if (!avFrame)
             {
-                const int64_t seek =
-                    (f * _info.sequence.speed.duration()) /
-                    static_cast<float>(_info.sequence.speed.scale()) *
-                    AV_TIME_BASE;
-                //DJV_DEBUG_PRINT("seek = " << static_cast<qint64>(seek));
-                int r = av_seek_frame(
-                    _avFormatContext,
-                    _avVideoStream,
-                    av_rescale_q(seek, FFmpeg::timeBaseQ(), avStream->time_base),
-                    AVSEEK_FLAG_BACKWARD);
-                //DJV_DEBUG_PRINT("r = " << FFmpeg::toString(r));
-                avcodec_flush_buffers(_avCodecContext);
-                while (readFrame(pts) && pts < seek)
-                    ;
-            }
-            else
-            {
-                readFrame(pts);
+                if (f > _frame && f - _frame <= Core::Math::max(_options.decodeCache, 1))
+                {
+                    // Decode forward to the frame, this is cheaper than seeking
+                    // for sequential reads and small jumps. Frames without a
+                    // time stamp are counted but not cached.
+                    int64_t pts = 0;
+                    while (_frame < f && readFrame(pts))
+                    {
+                        const int index = frameIndex(pts);
+                        _frame = index >= 0 ? index : _frame + 1;
+                        cacheFrame(index, _avFrame);
+                    }
+                }
+                else
+                {
+                    AVStream * avStream = _avFormatContext->streams[_avVideoStream];
+                    const int64_t seek =
+                        (f * _info.sequence.speed.duration()) /
+                        static_cast<float>(_info.sequence.speed.scale()) *
+                        AV_TIME_BASE;
+                    //DJV_DEBUG_PRINT("seek = " << static_cast<qint64>(seek));
+                    int r = av_seek_frame(
+                        _avFormatContext,
+                        _avVideoStream,
+                        av_rescale_q(seek, FFmpeg::timeBaseQ(), avStream->time_base),
+                        AVSEEK_FLAG_BACKWARD);
+                    //DJV_DEBUG_PRINT("r = " << FFmpeg::toString(r));
+                    avcodec_flush_buffers(_avCodecContext);
+
+                    // Decode forward from the key frame. The frames that are
+                    // decoded on the way are cached by their time stamps, so
+                    // that stepping backwards does not decode the group of
+                    // pictures again.
+                    _frame = f;
+                    int64_t pts = 0;
+                    bool decoded = false;
+                    while (readFrame(pts))
+                    {
+                        decoded = true;
+                        const int index = frameIndex(pts);
+                        if (index >= 0)
+                        {
+                            _frame = index;
+                        }
+                        cacheFrame(index, _avFrame);
+                        if (pts >= seek)
+                            break;
+                    }
+                    if (!decoded)
+                    {
+                        // Force a seek on the next read since the position of
+                        // the decoder is unknown.
+                        _frame = std::numeric_limits<int>::max();
+                        throw Core::Error(
+                            FFmpeg::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                    }
+                }
+
+                // Use the requested frame if it was decoded, otherwise use the
+                // last frame that was decoded.
+                avFrame = cachedFrame(f);
+                if (!avFrame)
+                {
+                    avFrame = _avFrame;
+                }
+                if (!avFrame->data[0])
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                }
             }
-            _frame = f;
 
             sws_scale(
-                _swsContext,
-                (uint8_t const * const *)_avFrame->data,
-                _avFrame->linesize,
+                swsContext,
+                (uint8_t const * const *)avFrame->data,
+                avFrame->linesize,
                 0,
                 _avCodecParameters->height,
                 _avFrameRgb->data,
                 _avFrameRgb->linesize);
-
-            if (frame.proxy)
-            {
-                PixelDataInfo info = _info;
-                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
-                info.proxy = frame.proxy;
-                image.set(info);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
-            }
         }
 
         void FFmpegLoad::close()
         {
             //DJV_DEBUG("FFmpegLoad::close");    
+            cacheClear();
             if (_swsContext)
             {
                 sws_freeContext(_swsContext);
                 _swsContext = nullptr;
             }
+            if (_swsProxyContext)
+            {
+                sws_freeContext(_swsProxyContext);
+                _swsProxyContext = nullptr;
+            }
             if (_avFrameRgb)
             {
                 av_frame_free(&_avFrameRgb);
@@ -317,11 +404,14 @@ namespace djv
         bool FFmpegLoad::readFrame(int64_t & pts)
         {
             //DJV_DEBUG("FFmpegLoad::readFrame");
-            FFmpeg::Packet packet;
-            int finished = 0;
-            while (!finished)
+
+            // With frame threading the decoder holds several frames, so check
+            // for a decoded frame before sending more packets.
+            int r = avcodec_receive_frame(_avCodecContext, _avFrame);
+            while (AVERROR(EAGAIN) == r)
             {
-                int r = av_read_frame(_avFormatContext, &packet());
+                FFmpeg::Packet packet;
+                r = av_read_frame(_avFormatContext, &packet());
                 //DJV_DEBUG_PRINT("packet");
                 //DJV_DEBUG_PRINT("  size = " << static_cast<qint64>(packet().size));
                 //DJV_DEBUG_PRINT("  pos = " << static_cast<qint64>(packet().pos));
@@ -333,34 +423,91 @@ namespace djv
                 //DJV_DEBUG_PRINT("  r = " << FFmpeg::toString(r));
                 if (r < 0)
                 {
-                    packet().data = nullptr;
-                    packet().size = 0;
+                    // Flush the decoder at the end of the file so that it
+                    // returns the frames it is holding.
+                    r = avcodec_send_packet(_avCodecContext, nullptr);
                 }
-                if (_avVideoStream == packet().stream_index)
+                else if (_avVideoStream == packet().stream_index)
                 {
-                    if (&packet())
-                    {
-                        r = avcodec_send_packet(_avCodecContext, &packet());
-                        if (r < 0)
-                        {
-                            break;
-                        }
-                    }
-                    r = avcodec_receive_frame(_avCodecContext, _avFrame);
-                    if (r < 0 && r != AVERROR(EAGAIN) && r != AVERROR_EOF)
-                        return r;
-                    if (r >= 0)
-                        finished = 1;
+                    r = avcodec_send_packet(_avCodecContext, &packet());
+                }
+                if (r < 0 && r != AVERROR_EOF)
+                {
+                    break;
                 }
+                r = avcodec_receive_frame(_avCodecContext, _avFrame);
+            }
+            if (r < 0)
+            {
+                return false;
             }
             pts = _avFrame->pts;
             //DJV_DEBUG_PRINT("pts = " << static_cast<qint64>(pts));
-            pts = av_rescale_q(
-                pts,
-                _avFormatContext->streams[_avVideoStream]->time_base,
-                FFmpeg::timeBaseQ());
+            if (pts != AV_NOPTS_VALUE)
+            {
+                pts = av_rescale_q(
+                    pts,
+                    _avFormatContext->streams[_avVideoStream]->time_base,
+                    FFmpeg::timeBaseQ());
+            }
             //DJV_DEBUG_PRINT("pts = " << static_cast<qint64>(pts));
-            return finished;
+            return true;
+        }
+
+        int FFmpegLoad::frameIndex(int64_t pts) const
+        {
+            if (AV_NOPTS_VALUE == pts)
+                return -1;
+
+            // This is the inverse of the mapping used to seek to a frame.
+            return Core::Math::round(
+                pts / static_cast<double>(AV_TIME_BASE) *
+                _info.sequence.speed.scale() /
+                static_cast<double>(_info.sequence.speed.duration()));
+        }
+
+        AVFrame * FFmpegLoad::cachedFrame(int frame) const
+        {
+            for (const auto & i : _cache)
+            {
+                if (frame == i.first)
+                {
+                    return i.second;
+                }
+            }
+            return nullptr;
+        }
+
+        void FFmpegLoad::cacheFrame(int frame, AVFrame * avFrame)
+        {
+            if (frame < 0 || _options.decodeCache <= 0)
+                return;
+            for (auto i = _cache.begin(); i != _cache.end(); ++i)
+            {
+                if (frame == i->first)
+                {
+                    av_frame_free(&i->second);
+                    _cache.erase(i);
+                    break;
+                }
+            }
+            // The frames share the decoder's buffers, so this does not copy
+            // the image data.
+            _cache.push_back(std::make_pair(frame, av_frame_clone(avFrame)));
+            while (static_cast<int>(_cache.size()) > _options.decodeCache)
+            {
+                av_frame_free(&_cache.front().second);
+                _cache.pop_front();
+            }
+        }
+
+        void FFmpegLoad::cacheClear()
+        {
+            for (auto & i : _cache)
+            {
+                av_frame_free(&i.second);
+            }
+            _cache.clear();
         }
 
     } // namespace Graphics
@@ -34,15 +34,22 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <deque>
+#include <utility>
+
 namespace djv
 {
     namespace Graphics
     {
         //! This class provides a FFmpeg loader.
+        //!
+        //! The frames that are decoded are kept in a small cache, so that
+        //! stepping backwards and small jumps do not need to seek and decode
+        //! the group of pictures again.
         class FFmpegLoad : public ImageLoad
         {
         public:
-            explicit FFmpegLoad(const QPointer<Core::CoreContext> &);
+            FFmpegLoad(const FFmpeg::Options &, const QPointer<Core::CoreContext> &);
             virtual ~FFmpegLoad();
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
@@ -52,9 +59,18 @@ namespace djv
         private:
             bool readFrame(int64_t & pts);
 
+            //! Get the frame index of a time stamp, or -1 if the time stamp
+            //! is unknown.
+            int frameIndex(int64_t pts) const;
+
+            AVFrame * cachedFrame(int frame) const;
+            void cacheFrame(int frame, AVFrame *);
+            void cacheClear();
+
+            FFmpeg::Options _options;
             ImageIOInfo _info;
-            int _frame = 0;
-            PixelData _tmp;
+            int _frame = -1;
+            std::deque<std::pair<int, AVFrame *> > _cache;
 
             AVFormatContext * _avFormatContext = nullptr;
             int _avVideoStream = -1;
@@ -63,6 +79,7 @@ namespace djv
             AVFrame * _avFrame = nullptr;
             AVFrame * _avFrameRgb = nullptr;
             SwsContext * _swsContext = nullptr;
+            SwsContext * _swsProxyContext = nullptr;
         };
 
     } // namespace Graphics
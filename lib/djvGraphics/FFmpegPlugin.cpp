@@ -142,6 +142,14 @@ namespace djv
             {
                 out << _options.quality;
             }
+            else if (0 == in.compare(list[FFmpeg::OPTIONS_THREAD_COUNT], Qt::CaseInsensitive))
+            {
+                out << _options.threadCount;
+            }
+            else if (0 == in.compare(list[FFmpeg::OPTIONS_DECODE_CACHE], Qt::CaseInsensitive))
+            {
+                out << _options.decodeCache;
+            }
             return out;
         }
 
@@ -170,6 +178,26 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(list[FFmpeg::OPTIONS_THREAD_COUNT], Qt::CaseInsensitive))
+                {
+                    int threadCount = 0;
+                    data >> threadCount;
+                    if (threadCount != _options.threadCount)
+                    {
+                        _options.threadCount = threadCount;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(list[FFmpeg::OPTIONS_DECODE_CACHE], Qt::CaseInsensitive))
+                {
+                    int decodeCache = 0;
+                    data >> decodeCache;
+                    if (decodeCache != _options.decodeCache)
+                    {
+                        _options.decodeCache = decodeCache;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (QString)
             {
@@ -200,6 +228,14 @@ namespace djv
                     {
                         in >> _options.quality;
                     }
+                    else if (qApp->translate("djv::Graphics::FFmpegPlugin", "-ffmpeg_thread_count") == arg)
+                    {
+                        in >> _options.threadCount;
+                    }
+                    else if (qApp->translate("djv::Graphics::FFmpegPlugin", "-ffmpeg_decode_cache") == arg)
+                    {
+                        in >> _options.decodeCache;
+                    }
                     else
                     {
                         tmp << arg;
@@ -219,6 +255,10 @@ namespace djv
             formatLabel << _options.format;
             QStringList qualityLabel;
             qualityLabel << _options.quality;
+            QStringList threadCountLabel;
+            threadCountLabel << _options.threadCount;
+            QStringList decodeCacheLabel;
+            decodeCacheLabel << _options.decodeCache;
             return qApp->translate("djv::Graphics::FFmpegPlugin",
                 "\n"
                 "FFmpeg Options\n"
@@ -229,16 +269,24 @@ namespace djv
                 "    -ffmpeg_quality (value)\n"
                 "        Set the quality used when saving FFmpeg movies: %3. "
                 "Default = %4.\n"
+                "    -ffmpeg_thread_count (value)\n"
+                "        Set the number of threads used when loading FFmpeg movies, "
+                "zero picks the number automatically. Default = %5.\n"
+                "    -ffmpeg_decode_cache (value)\n"
+                "        Set the number of decoded frames kept when loading FFmpeg "
+                "movies. Default = %6.\n"
             ).
                 arg(FFmpeg::formatLabels().join(", ")).
                 arg(formatLabel.join(", ")).
                 arg(FFmpeg::qualityLabels().join(", ")).
-                arg(qualityLabel.join(", "));
+                arg(qualityLabel.join(", ")).
+                arg(threadCountLabel.join(", ")).
+                arg(decodeCacheLabel.join(", "));
         }
 
         ImageLoad * FFmpegPlugin::createLoad() const
         {
-            return new FFmpegLoad(context());
+            return new FFmpegLoad(_options, context());
         }
 
         ImageSave * FFmpegPlugin::createSave() const
@@ -43,6 +43,7 @@ namespace djv
         //! Supported features:
         //!
         //! - 8-bit RGBA
+        //! - Multi-threaded decoding
         //!
         //! References:
         //!
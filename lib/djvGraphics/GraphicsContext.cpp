@@ -39,6 +39,8 @@
 #include <djvGraphics/OpenGLImage.h>
 #include <djvGraphics/PICPlugin.h>
 #include <djvGraphics/PPMPlugin.h>
+#include <djvGraphics/PixelDataPool.h>
+#include <djvGraphics/PixelDataUtil.h>
 #include <djvGraphics/TargaPlugin.h>
 #include <djvGraphics/RLAPlugin.h>
 #include <djvGraphics/SGIPlugin.h>
@@ -59,7 +61,10 @@
 #endif // FFMPEG_FOUND
 
 #include <djvCore/DebugLog.h>
+#include <djvCore/FileBatchReader.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/Error.h>
+#include <djvCore/Memory.h>
 
 #include <QCoreApplication>
 #include <QMetaType>
@@ -93,6 +98,18 @@ namespace djv
             qRegisterMetaType<Image>("djv::Graphics::Image");
             qRegisterMetaType<ImageIOInfo>("djv::Graphics::ImageIOInfo");
 
+            // Batched and direct file reads share buffers with the pixel data.
+            const auto allocate = [](quint64 size)
+            {
+                return PixelDataPool::global()->acquire(size);
+            };
+            const auto release = [](quint8 * p, quint64 size)
+            {
+                PixelDataPool::global()->release(p, size);
+            };
+            Core::FileBatchReader::global()->setAllocator(allocate, release);
+            Core::FileIO::setDirectAllocator(allocate, release);
+
             // Create the default OpenGL context.
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Creating the default OpenGL context...");
 
@@ -116,38 +133,59 @@ namespace djv
             _p->offscreenSurface->create();
             _p->openGLContext.reset(new QOpenGLContext);
             _p->openGLContext->setFormat(surfaceFormat);
-            if (!_p->openGLContext->create())
+
+            // When software rendering is enabled a missing OpenGL context is not
+            // an error, image copies are done on the CPU instead.
+            if (Core::System::env("DJV_RENDER_SOFTWARE").size())
             {
-                throw Core::Error(
-                    "djv::Graphics::GraphicsContext",
-                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot create OpenGL context, found version %1.%2").
-                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+                OpenGLImage::setSoftwareCopy(true);
             }
-            _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
-            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
-                QString("OpenGL context valid = %1").arg(_p->openGLContext->isValid()));
-            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
-                QString("OpenGL version = %1.%2").
-                arg(_p->openGLContext->format().majorVersion()).
-                arg(_p->openGLContext->format().minorVersion()));
-            if (!_p->openGLContext->versionFunctions<QOpenGLFunctions_3_3_Core>())
+            try
             {
-                throw Core::Error(
-                    "djv::Graphics::GraphicsContext",
-                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot find OpenGL 3.3 functions, found version %1.%2").
-                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
-            }
+                if (!_p->openGLContext->create())
+                {
+                    throw Core::Error(
+                        "djv::Graphics::GraphicsContext",
+                        qApp->translate("djv::Graphics::GraphicsContext", "Cannot create OpenGL context, found version %1.%2").
+                        arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+                }
+                _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
+                DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                    QString("OpenGL context valid = %1").arg(_p->openGLContext->isValid()));
+                DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                    QString("OpenGL version = %1.%2").
+                    arg(_p->openGLContext->format().majorVersion()).
+                    arg(_p->openGLContext->format().minorVersion()));
+                if (!_p->openGLContext->versionFunctions<QOpenGLFunctions_3_3_Core>())
+                {
+                    throw Core::Error(
+                        "djv::Graphics::GraphicsContext",
+                        qApp->translate("djv::Graphics::GraphicsContext", "Cannot find OpenGL 3.3 functions, found version %1.%2").
+                        arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+                }
 
-            _p->openGLDebugLogger.reset(new QOpenGLDebugLogger);
-            connect(
-                _p->openGLDebugLogger.data(),
-                &QOpenGLDebugLogger::messageLogged,
-                this,
-                &GraphicsContext::debugLogMessage);
-            if (_p->openGLContext->format().testOption(QSurfaceFormat::DebugContext))
+                _p->openGLDebugLogger.reset(new QOpenGLDebugLogger);
+                connect(
+                    _p->openGLDebugLogger.data(),
+                    &QOpenGLDebugLogger::messageLogged,
+                    this,
+                    &GraphicsContext::debugLogMessage);
+                if (_p->openGLContext->format().testOption(QSurfaceFormat::DebugContext))
+                {
+                    _p->openGLDebugLogger->initialize();
+                    _p->openGLDebugLogger->startLogging();
+                }
+            }
+            catch (const Core::Error & error)
             {
-                _p->openGLDebugLogger->initialize();
-                _p->openGLDebugLogger->startLogging();
+                if (!OpenGLImage::softwareCopy())
+                {
+                    throw error;
+                }
+                _p->openGLContext->doneCurrent();
+                _p->openGLContext.reset(new QOpenGLContext);
+                DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                    "No OpenGL context, using software rendering");
             }
 
             //! Create the image I/O plugins.
@@ -206,7 +244,10 @@ namespace djv
 
         void GraphicsContext::makeGLContextCurrent()
         {
-            _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
+            if (_p->openGLContext->isValid())
+            {
+                _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
+            }
         }
 
         QString GraphicsContext::info() const
@@ -218,10 +259,17 @@ namespace djv
                 "\n"
                 "    Version: %2.%3\n"
                 "    Render filter: %4, %5\n"
+                "    Render software: %6\n"
                 "\n"
                 "Image I/O\n"
                 "\n"
-                "    Plugins: %6\n");
+                "    Plugins: %7\n"
+                "\n"
+                "Pixel Data Pool\n"
+                "\n"
+                "    Budget: %8\n"
+                "    Hits: %9, misses: %10\n"
+                "    Outstanding: %11, pooled: %12\n");
             QStringList filterMinLabel;
             filterMinLabel << OpenGLImageFilter::filter().min;
             QStringList filterMagLabel;
@@ -232,7 +280,13 @@ namespace djv
                 arg(_p->openGLContext->format().minorVersion()).
                 arg(filterMinLabel.join(", ")).
                 arg(filterMagLabel.join(", ")).
-                arg(_p->imageIOFactory->names().join(", "));
+                arg(Core::StringUtil::boolLabels()[OpenGLImage::softwareCopy()]).
+                arg(_p->imageIOFactory->names().join(", ")).
+                arg(Core::Memory::sizeLabel(PixelDataPool::global()->budget())).
+                arg(PixelDataPool::global()->hits()).
+                arg(PixelDataPool::global()->misses()).
+                arg(Core::Memory::sizeLabel(PixelDataPool::global()->outstandingBytes())).
+                arg(Core::Memory::sizeLabel(PixelDataPool::global()->pooledBytes()));
         }
 
         bool GraphicsContext::commandLineParse(QStringList & in)
@@ -268,6 +322,28 @@ namespace djv
                     {
                         OpenGLImageFilter::setFilter(OpenGLImageFilter::filterHighQuality());
                     }
+                    else if (qApp->translate("djv::Graphics::GraphicsContext", "-render_software") == arg)
+                    {
+                        OpenGLImage::setSoftwareCopy(true);
+                    }
+
+                    // Image options.
+                    else if (qApp->translate("djv::Graphics::GraphicsContext", "-proxy_filter") == arg)
+                    {
+                        PixelDataUtil::PROXY_FILTER value = static_cast<PixelDataUtil::PROXY_FILTER>(0);
+                        in >> value;
+                        PixelDataUtil::setProxyFilter(value);
+                    }
+                    else if (qApp->translate("djv::Graphics::GraphicsContext", "-pixel_pool") == arg)
+                    {
+                        int value = 0;
+                        in >> value;
+                        PixelDataPool::global()->setBudget(value * Core::Memory::megabyte);
+                    }
+                    else if (qApp->translate("djv::Graphics::GraphicsContext", "-pixel_pool_huge_pages") == arg)
+                    {
+                        PixelDataPool::global()->setHugePages(true);
+                    }
 
                     // Leftovers.
                     else
@@ -303,7 +379,21 @@ namespace djv
                 "        Set the render filter: %2. Default = %3, %4.\n"
                 "    -render_filter_high\n"
                 "        Set the render filter to high quality settings (%5, %6).\n"
-                "%7");
+                "    -render_software\n"
+                "        Convert images on the CPU instead of with OpenGL. Software rendering\n"
+                "        may also be enabled with the DJV_RENDER_SOFTWARE environment variable.\n"
+                "\n"
+                "Image Options\n"
+                "\n"
+                "    -proxy_filter (value)\n"
+                "        Set the filter used to proxy scale images: %7. The box filter is\n"
+                "        slower and reads files at full resolution. Default = %8.\n"
+                "    -pixel_pool (value)\n"
+                "        Set the maximum size of the pool used to re-use image memory in\n"
+                "        megabytes. Default = %9.\n"
+                "    -pixel_pool_huge_pages\n"
+                "        Use huge pages for image memory where supported.\n"
+                "%10");
             QStringList filterMinLabel;
             filterMinLabel << OpenGLImageFilter::filter().min;
             QStringList filterMagLabel;
@@ -312,6 +402,8 @@ namespace djv
             filterHighQualityMinLabel << OpenGLImageFilter::filterHighQuality().min;
             QStringList filterHighQualityMagLabel;
             filterHighQualityMagLabel << OpenGLImageFilter::filterHighQuality().mag;
+            QStringList proxyFilterLabel;
+            proxyFilterLabel << PixelDataUtil::proxyFilter();
             return QString(label).
                 arg(imageIOHelp).
                 arg(OpenGLImageFilter::filterLabels().join(", ")).
@@ -319,6 +411,9 @@ namespace djv
                 arg(filterMagLabel.join(", ")).
                 arg(filterHighQualityMinLabel.join(", ")).
                 arg(filterHighQualityMagLabel.join(", ")).
+                arg(PixelDataUtil::proxyFilterLabels().join(", ")).
+                arg(proxyFilterLabel.join(", ")).
+                arg(PixelDataPool::global()->budget() / Core::Memory::megabyte).
                 arg(Core::CoreContext::commandLineHelp());
         }
 
@@ -39,6 +39,76 @@ namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! This struct provides the location of a compressed tile.
+            struct Tile
+            {
+                Tile(const quint8 * p, quint32 size, quint16 xmin, quint16 ymin, quint16 xmax, quint16 ymax) :
+                    p(p),
+                    end(p + size),
+                    xmin(xmin),
+                    ymin(ymin),
+                    xmax(xmax),
+                    ymax(ymax)
+                {}
+
+                const quint8 * p;
+                const quint8 * end;
+                quint16        xmin;
+                quint16        ymin;
+                quint16        xmax;
+                quint16        ymax;
+            };
+
+            //! Map the 16-bit channel bytes from BGRA to RGBA.
+            const int rgb16MapLSB[] = { 0, 2, 4, 1, 3, 5 };
+            const int rgba16MapLSB[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+            const int rgb16MapMSB[] = { 1, 3, 5, 0, 2, 4 };
+            const int rgba16MapMSB[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+
+            //! Decode a compressed tile. The channels are stored one after
+            //! another, starting with the last one.
+            void decodeTile(
+                const Tile & tile,
+                quint8 *     data,
+                quint64      scanlineByteCount,
+                int          byteCount,
+                int          channels,
+                const int *  map)
+            {
+                const quint32 tw = tile.xmax - tile.xmin + 1;
+                const quint32 th = tile.ymax - tile.ymin + 1;
+                std::vector<quint8> in(tw * th);
+                const quint8 * p = tile.p;
+                for (int c = channels - 1; c >= 0; --c)
+                {
+                    // Uncompress.
+                    p += IFF::readRle(p, in.data(), tw * th);
+
+                    const int mc = map ? map[c] : c;
+                    const quint8 * inP = in.data();
+                    for (quint16 py = tile.ymin; py <= tile.ymax; py++)
+                    {
+                        quint8 * outP = data + py * scanlineByteCount + tile.xmin * byteCount + mc;
+                        for (quint16 px = tile.xmin; px <= tile.xmax; px++, outP += byteCount)
+                        {
+                            *outP = *inP++;
+                        }
+                    }
+                }
+
+                // Test.
+                if (p != tile.end)
+                {
+                    throw Core::Error(
+                        IFF::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+                }
+            }
+
+        } // namespace
+
         IFFLoad::IFFLoad(const QPointer<Core::CoreContext> & context) :
             ImageLoad(context)
         {}
@@ -97,6 +167,7 @@ namespace djv
             PixelData * data = frame.proxy ? &_tmp : &image;
             data->set(info);
             tilesRgba = _tiles;
+            std::vector<Tile> tiles;
 
             // Read FOR4 <size> TBMP block
             for (;;)
@@ -223,46 +294,10 @@ namespace djv
                                     // Tile compress.
                                     if (tile_compress)
                                     {
-                                        // Set bytes.
-                                        const quint8 * p = io.mmapP();
-
-                                        // Map: RGB(A)8 BGRA to RGBA
-                                        for (int c = (channels * channelByteCount) - 1;
-                                            c >= 0;
-                                            --c)
-                                        {
-                                            std::vector<quint8> in(tw * th);
-                                            quint8 * inP = in.data();
-
-                                            // Uncompress.
-                                            p += IFF::readRle(p, in.data(), tw * th);
-
-                                            for (quint16 py = ymin; py <= ymax; py++)
-                                            {
-                                                quint8 * out_dy = data->data(0, py);
-
-                                                for (
-                                                    quint16 px = xmin;
-                                                    px <= xmax;
-                                                    px++)
-                                                {
-                                                    quint8 * outP =
-                                                        out_dy + px * byteCount + c;
-                                                    *outP++ = *inP++;
-                                                }
-                                            }
-                                        }
-
-                                        // Seek
+                                        // The tiles are decoded after all
+                                        // of them have been found.
+                                        tiles.push_back(Tile(io.mmapP(), imageSize - 8, xmin, ymin, xmax, ymax));
                                         io.seek(imageSize - 8);
-
-                                        // Test.
-                                        if (p != io.mmapP())
-                                        {
-                                            throw Core::Error(
-                                                IFF::staticName,
-                                                ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
-                                        }
                                     }
                                     else
                                     {
@@ -312,81 +347,10 @@ namespace djv
                                 {
                                     if (tile_compress)
                                     {
-
-                                        // Set bytes.
-                                        const quint8 * p = io.mmapP();
-
-                                        // Set map.
-                                        int* map = NULL;
-
-                                        if (Core::Memory::endian() == Core::Memory::LSB)
-                                        {
-                                            int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                            int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                            if (info.pixel == Pixel::RGB_U16)
-                                            {
-                                                map = rgb16;
-                                            }
-                                            else
-                                            {
-                                                map = rgba16;
-                                            }
-                                        }
-                                        else
-                                        {
-                                            int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                            int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                            if (info.pixel == Pixel::RGB_U16)
-                                            {
-                                                map = rgb16;
-                                            }
-                                            else
-                                            {
-                                                map = rgba16;
-                                            }
-                                        }
-
-                                        // Map: RGB(A)8 BGRA to RGBA
-                                        for (int c = (channels * channelByteCount) - 1;
-                                            c >= 0;
-                                            --c)
-                                        {
-                                            int mc = map[c];
-
-                                            std::vector<quint8> in(tw * th);
-                                            quint8 * inP = in.data();
-
-                                            // Uncompress.
-                                            p += IFF::readRle(p, in.data(), tw * th);
-
-                                            for (quint16 py = ymin; py <= ymax; py++)
-                                            {
-                                                quint8 * out_dy = data->data(0, py);
-
-                                                for (
-                                                    quint16 px = xmin;
-                                                    px <= xmax;
-                                                    px++)
-                                                {
-                                                    quint8 * outP =
-                                                        out_dy + px * byteCount + mc;
-                                                    *outP++ = *inP++;
-                                                }
-                                            }
-                                        }
-
-                                        // Seek
+                                        // The tiles are decoded after all
+                                        // of them have been found.
+                                        tiles.push_back(Tile(io.mmapP(), imageSize - 8, xmin, ymin, xmax, ymax));
                                         io.seek(imageSize - 8);
-
-                                        // Test.
-                                        if (p != io.mmapP())
-                                        {
-                                            throw Core::Error(
-                                                IFF::staticName,
-                                                ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
-                                        }
                                     }
                                     else
                                     {
@@ -482,6 +446,33 @@ namespace djv
                 }
             }
 
+            // Decode the compressed tiles in parallel.
+            if (tiles.size())
+            {
+                const int tileChannels = Pixel::channels(info.pixel) * channelByteCount;
+                const int * map = 0;
+                const bool lsb = Core::Memory::LSB == Core::Memory::endian();
+                switch (info.pixel)
+                {
+                case Pixel::RGB_U16:  map = lsb ? rgb16MapLSB : rgb16MapMSB;   break;
+                case Pixel::RGBA_U16: map = lsb ? rgba16MapLSB : rgba16MapMSB; break;
+                default: break;
+                }
+                quint8 * const dataP = data->data();
+                const quint64  scanlineByteCount = data->scanlineByteCount();
+                const Tile &   tile = tiles[0];
+                parallelDecode(
+                    static_cast<int>(tiles.size()),
+                    (tile.xmax - tile.xmin + 1) * (tile.ymax - tile.ymin + 1),
+                    [&](int i0, int i1)
+                {
+                    for (int i = i0; i < i1; ++i)
+                    {
+                        decodeTile(tiles[i], dataP, scanlineByteCount, byteCount, tileChannels, map);
+                    }
+                });
+            }
+
             if (frame.proxy)
             {
                 info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
@@ -38,6 +38,291 @@ namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! Encode a tile. The tile data is returned along with the chunk
+            //! length and the length of the tile data.
+            void encodeTile(
+                const PixelData &     p,
+                quint16               xmin,
+                quint16               ymin,
+                quint16               xmax,
+                quint16               ymax,
+                bool                  compress,
+                quint32 &             length,
+                std::vector<quint8> & tile,
+                quint32 &             tileLength)
+            {
+                const int channels = Pixel::channels(p.info().pixel);
+                const int channelByteCount = Pixel::channelByteCount(p.info().pixel);
+                const int byteCount = Pixel::byteCount(p.info().pixel);
+                //DJV_DEBUG_PRINT("channels = " << channels);
+                //DJV_DEBUG_PRINT("channelByteCount = " << channelByteCount);
+                //DJV_DEBUG_PRINT("byteCount = " << byteCount);
+
+                // Set width and height.
+                quint32 tw = xmax - xmin + 1;
+                quint32 th = ymax - ymin + 1;
+
+                // Length.
+                length = tw * th * byteCount;
+
+                // Tile length.
+                tileLength = length;
+
+                // Align.
+                length = IFF::alignSize(length, 4);
+
+                // Append xmin, xmax, ymin and ymax.
+                length += 8;
+
+                // Tile compression.
+                bool tile_compress = compress;
+
+                // Set bytes.
+                tile.resize(tileLength);
+                quint8 * outP = tile.data();
+
+                // Handle 8-bit data.
+                if (p.info().pixel == Pixel::RGB_U8 ||
+                    p.info().pixel == Pixel::RGBA_U8)
+                {
+                    if (tile_compress)
+                    {
+                        quint32 index = 0, size = 0;
+
+                        // Set bytes.
+                        // NOTE: prevent buffer overrun.
+                        std::vector<quint8> tmp(tileLength * 2);
+
+                        // Map: RGB(A)8 RGBA to BGRA
+                        for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
+                        {
+                            std::vector<quint8> in(tw * th);
+                            quint8 * inP = in.data();
+
+                            // Data.
+                            for (quint16 py = ymin; py <= ymax; py++)
+                            {
+                                const quint8 * inDy = p.data(0, py);
+
+                                for (quint16 px = xmin; px <= xmax; px++)
+                                {
+                                    // Get pixel.
+                                    quint8 pixel;
+                                    const quint8 * inDx = inDy + px * byteCount + c;
+                                    memcpy(&pixel, inDx, 1);
+                                    // Set pixel.
+                                    *inP++ = pixel;
+                                }
+                            }
+
+                            // Compress
+                            size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
+                            index += size;
+                        }
+
+                        // If size exceeds tile length use uncompressed.
+                        if (index < tileLength)
+                        {
+                            memcpy(tile.data(), tmp.data(), index);
+
+                            // Set tile length.
+                            tileLength = index;
+
+                            // Append xmin, xmax, ymin and ymax.
+                            length = index + 8;
+
+                            // Set length.
+                            quint32 align = IFF::alignSize(length, 4);
+
+                            if (align > length)
+                            {
+                                outP = tile.data() + index;
+
+                                // Pad.
+                                for (int i = 0;
+                                    i < static_cast<int>(align - length);
+                                    i++)
+                                {
+                                    *outP++ = '\0';
+                                    tileLength++;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            tile_compress = false;
+                        }
+                    }
+
+                    if (!tile_compress)
+                    {
+                        for (quint16 py = ymin; py <= ymax; py++)
+                        {
+                            const quint8 * inDy = p.data(0, py);
+
+                            for (quint16 px = xmin; px <= xmax; px++)
+                            {
+                                // Map: RGB(A)8 RGBA to BGRA
+                                for (int c = channels - 1; c >= 0; --c)
+                                {
+                                    // Get pixel.
+                                    quint8 pixel;
+                                    const quint8 * inDx =
+                                        inDy + px * byteCount + c * channelByteCount;
+                                    memcpy(&pixel, inDx, 1);
+                                    // Set pixel.
+                                    *outP++ = pixel;
+                                }
+                            }
+                        }
+                    }
+                }
+                // Handle 16-bit data.
+                else if (
+                    p.info().pixel == Pixel::RGB_U16 ||
+                    p.info().pixel == Pixel::RGBA_U16)
+                {
+                    if (tile_compress)
+                    {
+                        quint32 index = 0, size = 0;
+
+                        // Set bytes.
+                        // NOTE: prevent buffer overrun.
+                        std::vector<quint8> tmp(tileLength * 2);
+
+                        // Set map.
+                        const int * map = NULL;
+
+                        if (Core::Memory::endian() == Core::Memory::LSB)
+                        {
+                            static const int rgb16[] = { 0, 2, 4, 1, 3, 5 };
+                            static const int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+
+                            if (p.info().pixel == Pixel::RGB_U16)
+                            {
+                                map = rgb16;
+                            }
+                            else
+                            {
+                                map = rgba16;
+                            }
+                        }
+                        else
+                        {
+                            static const int rgb16[] = { 1, 3, 5, 0, 2, 4 };
+                            static const int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+
+                            if (p.info().pixel == Pixel::RGB_U16)
+                            {
+                                map = rgb16;
+                            }
+                            else
+                            {
+                                map = rgba16;
+                            }
+                        }
+
+                        // Map: RGB(A)16 RGBA to BGRA
+                        for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
+                        {
+                            int mc = map[c];
+                            std::vector<quint8> in(tw * th);
+                            quint8 * inP = in.data();
+
+                            // Data.
+                            for (quint16 py = ymin; py <= ymax; py++)
+                            {
+                                const quint8 * inDy = p.data(0, py);
+
+                                for (quint16 px = xmin; px <= xmax; px++)
+                                {
+                                    // Get pixel.
+                                    quint8 pixel;
+                                    const quint8 * inDx = inDy + px * byteCount + mc;
+                                    memcpy(&pixel, inDx, 1);
+                                    // Set pixel.
+                                    *inP++ = pixel;
+                                }
+                            }
+
+                            // Compress
+                            size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
+                            index += size;
+                        }
+
+                        // If size exceeds tile length use uncompressed.
+                        if (index < tileLength)
+                        {
+                            memcpy(tile.data(), tmp.data(), index);
+
+                            // Set tile length.
+                            tileLength = index;
+
+                            // Append xmin, xmax, ymin and ymax.
+                            length = index + 8;
+
+                            // Set length.
+                            quint32 align = IFF::alignSize(length, 4);
+
+                            if (align > length)
+                            {
+                                outP = tile.data() + index;
+
+                                // Pad.
+                                for (
+                                    int i = 0;
+                                    i < static_cast<int>(align - length);
+                                    i++)
+                                {
+                                    *outP++ = '\0';
+                                    tileLength++;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            tile_compress = false;
+                        }
+                    }
+
+                    if (!tile_compress)
+                    {
+                        for (quint16 py = ymin; py <= ymax; py++)
+                        {
+                            const quint8 * inDy = p.data(0, py);
+
+                            for (quint16 px = xmin; px <= xmax; px++)
+                            {
+                                // Map: RGB(A)16 RGBA to BGRA
+                                for (int c = channels - 1; c >= 0; --c)
+                                {
+                                    quint16 pixel;
+                                    const quint8 * inDx =
+                                        inDy + px * byteCount + c * channelByteCount;
+
+                                    if (Core::Memory::endian() == Core::Memory::LSB)
+                                    {
+                                        Core::Memory::convertEndian(inDx, &pixel, 1, 2);
+                                    }
+                                    else
+                                    {
+                                        memcpy(&pixel, inDx, 2);
+                                    }
+
+                                    // Set pixel.
+                                    *outP++ = pixel;
+                                    outP++;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+        } // namespace
+
         IFFSave::IFFSave(const IFF::Options & options, const QPointer<Core::CoreContext> & context) :
             ImageSave(context),
             _options(options)
@@ -104,25 +389,17 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
             // Write the file.
             const int w = p->w(), h = p->h();
-            const int channels = Pixel::channels(p->info().pixel);
-            const int channelByteCount = Pixel::channelByteCount(p->info().pixel);
-            const int byteCount = Pixel::byteCount(p->info().pixel);
 
             const bool compress = _options.compression ? true : false;
 
             quint32 length = 0;
 
-            //DJV_DEBUG_PRINT("channels = " << channels);
-            //DJV_DEBUG_PRINT("channelByteCount = " << channelByteCount);
-            //DJV_DEBUG_PRINT("byteCount = " << byteCount);
-
             quint64 pos = 0;
             pos = io.pos();
 
@@ -147,302 +424,76 @@ namespace djv
             // Write tiles.
             glm::ivec2 size = IFF::tileSize(w, h);
 
+            // Encode the tiles in parallel and then write them in order, so
+            // the file is the same for any number of threads.
+            struct Tile
+            {
+                quint16             xmin = 0;
+                quint16             ymin = 0;
+                quint16             xmax = 0;
+                quint16             ymax = 0;
+                quint32             length = 0;
+                std::vector<quint8> data;
+                quint32             dataLength = 0;
+            };
+            std::vector<Tile> tiles(size.x * size.y);
+
             // Y order.
             for (int y = 0; y < size.y; y++)
             {
                 // X order.
                 for (int x = 0; x < size.x; x++)
                 {
-                    // Set tile coordinates.
-                    quint16 xmin, xmax, ymin, ymax;
+                    Tile & tile = tiles[y * size.x + x];
 
                     // Set xmin and xmax.
-                    xmin = x * IFF::tileWidth();
-                    xmax = Core::Math::min(xmin + IFF::tileWidth(), w) - 1;
+                    tile.xmin = x * IFF::tileWidth();
+                    tile.xmax = Core::Math::min(tile.xmin + IFF::tileWidth(), w) - 1;
 
                     // Set ymin and ymax.
-                    ymin = y * IFF::tileHeight();
-                    ymax = Core::Math::min(ymin + IFF::tileHeight(), h) - 1;
-
-                    // Set width and height.
-                    quint32 tw = xmax - xmin + 1;
-                    quint32 th = ymax - ymin + 1;
-
-                    // Set type.
-                    io.setU8('R');
-                    io.setU8('G');
-                    io.setU8('B');
-                    io.setU8('A');
-
-                    // Length.
-                    quint32 length = tw * th * byteCount;
-
-                    // Tile length.
-                    quint32 tileLength = length;
-
-                    // Align.
-                    length = IFF::alignSize(length, 4);
-
-                    // Append xmin, xmax, ymin and ymax.
-                    length += 8;
-
-                    // Tile compression.
-                    bool tile_compress = compress;
-
-                    // Set bytes.
-                    std::vector<quint8> tile(tileLength);
-                    quint8 * outP = tile.data();
-
-                    // Handle 8-bit data.
-                    if (p->info().pixel == Pixel::RGB_U8 ||
-                        p->info().pixel == Pixel::RGBA_U8)
-                    {
-                        if (tile_compress)
-                        {
-                            quint32 index = 0, size = 0;
-
-                            // Set bytes.
-                            // NOTE: prevent buffer overrun.
-                            std::vector<quint8> tmp(tileLength * 2);
-
-                            // Map: RGB(A)8 RGBA to BGRA
-                            for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                            {
-                                std::vector<quint8> in(tw * th);
-                                quint8 * inP = in.data();
-
-                                // Data.
-                                for (quint16 py = ymin; py <= ymax; py++)
-                                {
-                                    const quint8 * inDy = p->data(0, py);
-
-                                    for (quint16 px = xmin; px <= xmax; px++)
-                                    {
-                                        // Get pixel.
-                                        quint8 pixel;
-                                        const quint8 * inDx = inDy + px * byteCount + c;
-                                        memcpy(&pixel, inDx, 1);
-                                        // Set pixel.
-                                        *inP++ = pixel;
-                                    }
-                                }
-
-                                // Compress
-                                size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
-                                index += size;
-                            }
-
-                            // If size exceeds tile length use uncompressed.
-                            if (index < tileLength)
-                            {
-                                memcpy(tile.data(), tmp.data(), index);
-
-                                // Set tile length.
-                                tileLength = index;
-
-                                // Append xmin, xmax, ymin and ymax.
-                                length = index + 8;
-
-                                // Set length.
-                                quint32 align = IFF::alignSize(length, 4);
-
-                                if (align > length)
-                                {
-                                    outP = tile.data() + index;
-
-                                    // Pad.
-                                    for (int i = 0;
-                                        i < static_cast<int>(align - length);
-                                        i++)
-                                    {
-                                        *outP++ = '\0';
-                                        tileLength++;
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                tile_compress = false;
-                            }
-                        }
-
-                        if (!tile_compress)
-                        {
-                            for (quint16 py = ymin; py <= ymax; py++)
-                            {
-                                const quint8 * inDy = p->data(0, py);
-
-                                for (quint16 px = xmin; px <= xmax; px++)
-                                {
-                                    // Map: RGB(A)8 RGBA to BGRA
-                                    for (int c = channels - 1; c >= 0; --c)
-                                    {
-                                        // Get pixel.
-                                        quint8 pixel;
-                                        const quint8 * inDx =
-                                            inDy + px * byteCount + c * channelByteCount;
-                                        memcpy(&pixel, inDx, 1);
-                                        // Set pixel.
-                                        *outP++ = pixel;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    // Handle 16-bit data.
-                    else if (
-                        p->info().pixel == Pixel::RGB_U16 ||
-                        p->info().pixel == Pixel::RGBA_U16)
-                    {
-                        if (tile_compress)
-                        {
-                            quint32 index = 0, size = 0;
-
-                            // Set bytes.
-                            // NOTE: prevent buffer overrun.
-                            std::vector<quint8> tmp(tileLength * 2);
-
-                            // Set map.
-                            int* map = NULL;
-
-                            if (Core::Memory::endian() == Core::Memory::LSB)
-                            {
-                                int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                if (_info.pixel == Pixel::RGB_U16)
-                                {
-                                    map = rgb16;
-                                }
-                                else
-                                {
-                                    map = rgba16;
-                                }
-                            }
-                            else
-                            {
-                                int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                if (_info.pixel == Pixel::RGB_U16)
-                                {
-                                    map = rgb16;
-                                }
-                                else
-                                {
-                                    map = rgba16;
-                                }
-                            }
-
-                            // Map: RGB(A)16 RGBA to BGRA
-                            for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                            {
-                                int mc = map[c];
-                                std::vector<quint8> in(tw * th);
-                                quint8 * inP = in.data();
-
-                                // Data.
-                                for (quint16 py = ymin; py <= ymax; py++)
-                                {
-                                    const quint8 * inDy = p->data(0, py);
-
-                                    for (quint16 px = xmin; px <= xmax; px++)
-                                    {
-                                        // Get pixel.
-                                        quint8 pixel;
-                                        const quint8 * inDx = inDy + px * byteCount + mc;
-                                        memcpy(&pixel, inDx, 1);
-                                        // Set pixel.
-                                        *inP++ = pixel;
-                                    }
-                                }
-
-                                // Compress
-                                size = IFF::writeRle(in.data(), tmp.data() + index, tw * th);
-                                index += size;
-                            }
-
-                            // If size exceeds tile length use uncompressed.
-                            if (index < tileLength)
-                            {
-                                memcpy(tile.data(), tmp.data(), index);
-
-                                // Set tile length.
-                                tileLength = index;
-
-                                // Append xmin, xmax, ymin and ymax.
-                                length = index + 8;
-
-                                // Set length.
-                                quint32 align = IFF::alignSize(length, 4);
-
-                                if (align > length)
-                                {
-                                    outP = tile.data() + index;
-
-                                    // Pad.
-                                    for (
-                                        int i = 0;
-                                        i < static_cast<int>(align - length);
-                                        i++)
-                                    {
-                                        *outP++ = '\0';
-                                        tileLength++;
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                tile_compress = false;
-                            }
-                        }
-
-                        if (!tile_compress)
-                        {
-                            for (quint16 py = ymin; py <= ymax; py++)
-                            {
-                                const quint8 * inDy = p->data(0, py);
-
-                                for (quint16 px = xmin; px <= xmax; px++)
-                                {
-                                    // Map: RGB(A)16 RGBA to BGRA
-                                    for (int c = channels - 1; c >= 0; --c)
-                                    {
-                                        quint16 pixel;
-                                        const quint8 * inDx =
-                                            inDy + px * byteCount + c * channelByteCount;
-
-                                        if (Core::Memory::endian() == Core::Memory::LSB)
-                                        {
-                                            Core::Memory::convertEndian(inDx, &pixel, 1, 2);
-                                        }
-                                        else
-                                        {
-                                            memcpy(&pixel, inDx, 2);
-                                        }
-
-                                        // Set pixel.
-                                        *outP++ = pixel;
-                                        outP++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    // Set length.
-                    io.setU32(length);
-
-                    // Set xmin, xmax, ymin and ymax.
-                    io.setU16(xmin);
-                    io.setU16(ymin);
-                    io.setU16(xmax);
-                    io.setU16(ymax);
-
-                    // Write.
-                    io.set(tile.data(), tileLength);
+                    tile.ymin = y * IFF::tileHeight();
+                    tile.ymax = Core::Math::min(tile.ymin + IFF::tileHeight(), h) - 1;
                 }
             }
+            parallelEncode(
+                static_cast<int>(tiles.size()),
+                IFF::tileWidth() * IFF::tileHeight(),
+                [&](int i0, int i1)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    Tile & tile = tiles[i];
+                    encodeTile(
+                        *p,
+                        tile.xmin,
+                        tile.ymin,
+                        tile.xmax,
+                        tile.ymax,
+                        compress,
+                        tile.length,
+                        tile.data,
+                        tile.dataLength);
+                }
+            });
+
+            // Write the type, length, xmin, ymin, xmax, ymax, and the data of
+            // each tile.
+            static const quint8 type[] = { 'R', 'G', 'B', 'A' };
+            std::vector<quint16> bounds(tiles.size() * 4);
+            std::vector<Core::FileIO::Block> blocks;
+            for (size_t i = 0; i < tiles.size(); ++i)
+            {
+                const Tile & tile = tiles[i];
+                bounds[i * 4 + 0] = tile.xmin;
+                bounds[i * 4 + 1] = tile.ymin;
+                bounds[i * 4 + 2] = tile.xmax;
+                bounds[i * 4 + 3] = tile.ymax;
+                blocks.push_back(Core::FileIO::Block(type, 4));
+                blocks.push_back(Core::FileIO::Block(&tile.length, 1, 4));
+                blocks.push_back(Core::FileIO::Block(&bounds[i * 4], 4, 2));
+                blocks.push_back(Core::FileIO::Block(tile.data.data(), tile.dataLength));
+            }
+            io.set(blocks);
 
             // Set FOR4 CIMG and FOR4 TBMP size
             quint32 p0 = io.pos() - 8;
@@ -455,6 +506,8 @@ namespace djv
             // NOTE: FOR4 <size> TBMP
             io.setPos(pos + 4);
             io.setU32(p1);
+
+            io.close();
         }
 
     } // namespace Graphics
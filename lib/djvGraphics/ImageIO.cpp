@@ -30,17 +30,25 @@
 #include <djvGraphics/ImageIO.h>
 
 #include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/OpenGLImage.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Debug.h>
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
+#include <djvCore/FileBatchReader.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Math.h>
+#include <djvCore/ThreadPool.h>
 
 #include <QCoreApplication>
 #include <QDir>
 #include <QMap>
 #include <QPointer>
+#include <QSet>
 
 #include <algorithm>
 
@@ -48,6 +56,23 @@ namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! Run the rows or tiles of an image codec in parallel with the
+            //! global thread pool. Encoding and decoding are more expensive per
+            //! pixel than the pixel conversions, so the bands can be smaller
+            //! than in PixelDataUtil.
+            void parallelCodec(int size, int pixelCount, const std::function<void(int, int)> & fnc)
+            {
+                const int pixelsMin = 16384;
+                Core::ThreadPool::global()->parallelFor(
+                    size,
+                    Core::Math::max(1, pixelsMin / Core::Math::max(1, pixelCount)),
+                    fnc);
+            }
+
+        } // namespace
+
         ImageIOInfo::ImageIOInfo() :
             _info(1)
         {}
@@ -102,6 +127,12 @@ namespace djv
         struct ImageLoad::Private
         {
             QPointer<Core::CoreContext> context;
+
+            //! The file sequence and the index of the last frame that was opened
+            //! with the batch reader, and the files that were submitted for it.
+            Core::FileInfo batchFileInfo;
+            int            batchIndex = -1;
+            QSet<QString>  batchFileNames;
         };
 
         ImageLoad::ImageLoad(const QPointer<Core::CoreContext> & context) :
@@ -111,19 +142,108 @@ namespace djv
         }
 
         ImageLoad::~ImageLoad()
-        {}
+        {
+            batchClear();
+        }
+
+        void ImageLoad::readLayers(
+            const QVector<Image *> & images,
+            const QVector<int> &     layers,
+            const ImageIOFrameInfo & frame)
+        {
+            for (int i = 0; i < layers.count(); ++i)
+            {
+                read(*images[i], ImageIOFrameInfo(frame.frame, layers[i], frame.proxy));
+            }
+        }
 
         void ImageLoad::close()
-        {}
+        {
+            batchClear();
+        }
 
         const QPointer<Core::CoreContext> & ImageLoad::context() const
         {
             return _p->context;
         }
 
+        void ImageLoad::batchOpen(const Core::FileInfo & fileInfo, qint64 frame, Core::FileIO & io)
+        {
+            //DJV_DEBUG("ImageLoad::batchOpen");
+            //DJV_DEBUG_PRINT("file info = " << fileInfo);
+            //DJV_DEBUG_PRINT("frame = " << frame);
+            Core::FileBatchReader * reader = Core::FileBatchReader::global();
+            if (fileInfo != _p->batchFileInfo || fileInfo.sequence() != _p->batchFileInfo.sequence())
+            {
+                batchClear();
+                _p->batchFileInfo = fileInfo;
+            }
+            if (Core::FileInfo::SEQUENCE == fileInfo.type())
+            {
+                // Submit the frames that follow in the direction of playback,
+                // which is taken from the last frame that was opened.
+                const Core::FrameList & frames = fileInfo.sequence().frames;
+                const int index = frames.indexOf(frame);
+                if (index != -1)
+                {
+                    const int step = (_p->batchIndex != -1 && index < _p->batchIndex) ? -1 : 1;
+                    _p->batchIndex = index;
+                    QStringList fileNames;
+                    for (int i = index + step;
+                        i >= 0 && i < frames.count() && Core::Math::abs(i - index) <= reader->queueDepth();
+                        i += step)
+                    {
+                        const QString fileName = fileInfo.fileName(frames[i]);
+                        fileNames += fileName;
+                        _p->batchFileNames.insert(fileName);
+                    }
+                    reader->submit(fileNames);
+                }
+            }
+            const QString fileName = fileInfo.fileName(frame);
+            _p->batchFileNames.remove(fileName);
+            reader->open(fileName, io);
+        }
+
+        void ImageLoad::batchClear()
+        {
+            if (_p->batchFileNames.count())
+            {
+                Core::FileBatchReader::global()->clear(_p->batchFileNames.toList());
+                _p->batchFileNames.clear();
+            }
+            _p->batchFileInfo = Core::FileInfo();
+            _p->batchIndex = -1;
+        }
+
+        bool ImageLoad::mapPixelData(
+            PixelData &                    data,
+            const PixelDataInfo &          info,
+            QScopedPointer<Core::FileIO> & io)
+        {
+            //DJV_DEBUG("ImageLoad::mapPixelData");
+            //DJV_DEBUG_PRINT("info = " << info);
+            const quint8 * p = io->mmapP();
+            if (!p || static_cast<quint64>(io->mmapEnd() - p) < PixelDataUtil::dataByteCount(info))
+            {
+                return false;
+            }
+            data.set(info, p, io.take());
+            return true;
+        }
+
+        void ImageLoad::parallelDecode(
+            int                                   size,
+            int                                   pixelCount,
+            const std::function<void(int, int)> & fnc)
+        {
+            parallelCodec(size, pixelCount, fnc);
+        }
+
         struct ImageSave::Private
         {
             QPointer<Core::CoreContext> context;
+            std::unique_ptr<OpenGLImage> openGLImage;
         };
 
         ImageSave::ImageSave(const QPointer<Core::CoreContext> & context) :
@@ -143,6 +263,23 @@ namespace djv
             return _p->context;
         }
 
+        OpenGLImage & ImageSave::openGLImage()
+        {
+            if (!_p->openGLImage)
+            {
+                _p->openGLImage.reset(new OpenGLImage);
+            }
+            return *_p->openGLImage;
+        }
+
+        void ImageSave::parallelEncode(
+            int                                   size,
+            int                                   pixelCount,
+            const std::function<void(int, int)> & fnc)
+        {
+            parallelCodec(size, pixelCount, fnc);
+        }
+
         ImageIO::ImageIO(const QPointer<Core::CoreContext> & context) :
             Core::Plugin(context)
         {}
@@ -38,8 +38,11 @@
 
 #include <QMetaType>
 #include <QObject>
+#include <QScopedPointer>
 #include <QStringList>
+#include <QVector>
 
+#include <functional>
 #include <memory>
 
 #if defined DJV_WINDOWS
@@ -52,12 +55,14 @@ namespace djv
     {
         class CoreContext;
         class FileInfo;
+        class FileIO;
 
     } // namespace Core
 
     namespace Graphics
     {
         class Image;
+        class OpenGLImage;
 
         //! This class provides image I/O information.
         class ImageIOInfo : public PixelDataInfo
@@ -132,6 +137,18 @@ namespace djv
             //! - Core::Error
             virtual void read(Image &, const ImageIOFrameInfo & = ImageIOFrameInfo()) = 0;
 
+            //! Load several layers of an image, one image for each layer.
+            //! Loaders that can decode the layers with a single pass over the
+            //! file re-implement this, the default loads each layer separately.
+            //! The layer of the frame information is ignored.
+            //!
+            //! Throws:
+            //! - Core::Error
+            virtual void readLayers(
+                const QVector<Image *> &,
+                const QVector<int> &     layers,
+                const ImageIOFrameInfo & = ImageIOFrameInfo());
+
             //! Close the image.
             //!
             //! Throws:
@@ -141,6 +158,36 @@ namespace djv
             //! Get the context.
             const QPointer<Core::CoreContext> & context() const;
 
+        protected:
+            //! Open a frame of a file sequence with the global batch reader, and
+            //! submit the reads for the frames that follow it in the direction
+            //! of playback.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void batchOpen(const Core::FileInfo &, qint64 frame, Core::FileIO &);
+
+            //! Release the reads that were submitted by batchOpen() and have not
+            //! been opened. This is called when the loader is closed.
+            void batchClear();
+
+            //! Set the pixel data to reference the data at the current position of
+            //! the file instead of copying it. This requires a file that is in
+            //! memory, either memory-mapped or read with Core::FileBatchReader or
+            //! Core::FileIO::openDirect(), and an on-disk layout that matches the
+            //! pixel data information. The pixel data takes ownership of the file.
+            //! Returns false if the file is not in memory or does not hold enough
+            //! data, in which case neither is changed.
+            static bool mapPixelData(PixelData &, const PixelDataInfo &, QScopedPointer<Core::FileIO> &);
+
+            //! Decode a range of independent rows or tiles in parallel with the
+            //! global thread pool, for example the scanlines of an RLE image
+            //! that has an offset table. The function is given the first value
+            //! and one past the last value of a band, and the pixel count is
+            //! the number of pixels in each row or tile. Exceptions thrown by
+            //! the function are passed on to the caller.
+            static void parallelDecode(int size, int pixelCount, const std::function<void(int, int)> &);
+
         private:
             struct Private;
             std::unique_ptr<Private> _p;
@@ -174,6 +221,19 @@ namespace djv
             //! Get the context.
             const QPointer<Core::CoreContext> & context() const;
 
+        protected:
+            //! Get the image converter. The converter is kept for the lifetime of
+            //! the saver so that the OpenGL state is reused between frames.
+            OpenGLImage & openGLImage();
+
+            //! Encode a range of independent rows or tiles in parallel with the
+            //! global thread pool. The encoded data should be kept for each row
+            //! or tile and written in order afterwards, so the output does not
+            //! depend on the number of threads. The function is given the first
+            //! value and one past the last value of a band, and the pixel count
+            //! is the number of pixels in each row or tile.
+            static void parallelEncode(int size, int pixelCount, const std::function<void(int, int)> &);
+
         private:
             struct Private;
             std::unique_ptr<Private> _p;
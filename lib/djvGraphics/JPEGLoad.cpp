@@ -108,17 +108,16 @@ namespace djv
                 _file.fileName(frame.frame != -1 ? frame.frame : _file.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
-            _open(fileName, info);
+            _open(fileName, info, frame.proxy);
             image.tags = info.tags;
 
             // Read the file.
-            PixelData * data = frame.proxy ? &_tmp : &image;
-            data->set(info);
+            image.set(info);
             for (int y = 0; y < info.size.y; ++y)
             {
                 if (!jpegScanline(
                     &_jpeg,
-                    data->data(0, data->h() - 1 - y),
+                    image.data(0, image.h() - 1 - y),
                     &_jpegError))
                 {
                     throw Core::Error(JPEG::staticName, _jpegError.msg);
@@ -129,14 +128,6 @@ namespace djv
                 throw Core::Error(JPEG::staticName, _jpegError.msg);
             }
 
-            if (frame.proxy)
-            {
-                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
-                info.proxy = frame.proxy;
-                image.set(info);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
-            }
-
             //DJV_DEBUG_PRINT("image = " << image);
             close();
         }
@@ -173,6 +164,7 @@ namespace djv
             bool jpegOpen(
                 FILE *                   f,
                 jpeg_decompress_struct * jpeg,
+                int                      scale,
                 JPEGErrorStruct *        error)
             {
                 if (::setjmp(error->jump))
@@ -185,6 +177,8 @@ namespace djv
                 {
                     return false;
                 }
+                jpeg->scale_num = 1;
+                jpeg->scale_denom = scale;
                 if (!jpeg_start_decompress(jpeg))
                 {
                     return false;
@@ -194,10 +188,14 @@ namespace djv
 
         } // namespace
 
-        void JPEGLoad::_open(const QString & in, ImageIOInfo & info)
+        void JPEGLoad::_open(
+            const QString &      in,
+            ImageIOInfo &        info,
+            PixelDataInfo::PROXY proxy)
         {
             //DJV_DEBUG("JPEGLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
+            //DJV_DEBUG_PRINT("proxy = " << proxy);
 
             close();
 
@@ -224,7 +222,10 @@ namespace djv
                     JPEG::staticName,
                     ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
             }
-            if (!jpegOpen(_f, &_jpeg, &_jpegError))
+            // The proxy is decoded directly by libjpeg with DCT scaling, so only
+            // the reduced image is ever produced. The output size is rounded up
+            // the same way as PixelDataUtil::proxyScale().
+            if (!jpegOpen(_f, &_jpeg, PixelDataUtil::proxyScale(proxy), &_jpegError))
             {
                 throw Core::Error(JPEG::staticName, _jpegError.msg);
             }
@@ -232,6 +233,7 @@ namespace djv
             // Information.
             info.fileName = in;
             info.size = glm::ivec2(_jpeg.output_width, _jpeg.output_height);
+            info.proxy = proxy;
             if (!Pixel::pixel(_jpeg.out_color_components, 8, Pixel::INTEGER, info.pixel))
             {
                 throw Core::Error(
@@ -50,14 +50,16 @@ namespace djv
             void close()  override;
 
         private:
-            void _open(const QString &, ImageIOInfo &);
+            void _open(
+                const QString &,
+                ImageIOInfo &,
+                PixelDataInfo::PROXY = PixelDataInfo::PROXY_NONE);
 
             Core::FileInfo         _file;
             FILE *                 _f = nullptr;
             jpeg_decompress_struct _jpeg;
             bool                   _jpegInit = false;
             JPEGErrorStruct        _jpegError;
-            PixelData              _tmp;
         };
 
     } // namespace Graphics
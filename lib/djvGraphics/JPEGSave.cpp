@@ -125,8 +125,7 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
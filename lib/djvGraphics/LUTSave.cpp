@@ -104,8 +104,7 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
@@ -120,6 +119,8 @@ namespace djv
                 break;
             default: break;
             }
+
+            io.close();
         }
 
     } // namespace Graphics
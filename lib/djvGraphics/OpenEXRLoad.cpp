@@ -36,18 +36,46 @@
 #include <djvCore/BoxUtil.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
 
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfRgbaYca.h>
+#include <ImfTestFile.h>
+
+#include <ImathFun.h>
 
 #include <algorithm>
+#include <vector>
 
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! Get a key that identifies the names, types and sampling of
+            //! the channels.
+            QByteArray channelsKey(const Imf::ChannelList & in)
+            {
+                QByteArray out;
+                for (auto i = in.begin(); i != in.end(); ++i)
+                {
+                    const Imf::Channel & channel = i.channel();
+                    out += i.name();
+                    out += '\0';
+                    out += static_cast<char>(channel.type);
+                    out += static_cast<char>(channel.xSampling);
+                    out += static_cast<char>(channel.ySampling);
+                    out += static_cast<char>(channel.pLinear);
+                }
+                return out;
+            }
+
+        } // namespace
+
         MemoryMappedIStream::MemoryMappedIStream(const char fileName[]) :
             IStream(fileName)
         {
@@ -127,10 +155,49 @@ namespace djv
             }
         }
 
+        //! This struct provides a layer that is being read.
+        struct OpenEXRLoad::Plane
+        {
+            Image *           image     = nullptr;
+            PixelDataInfo     info;
+            int               layer     = 0;
+            PixelData *       data      = nullptr;
+            int               channels  = 0;
+            int               byteCount = 0;
+            int               cb        = 0;
+            std::vector<char> buf;
+        };
+
         void OpenEXRLoad::read(Image & image, const ImageIOFrameInfo & frame)
         {
             //DJV_DEBUG("OpenEXRLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            _read(QVector<Image *>() << &image, QVector<int>() << frame.layer, frame);
+        }
+
+        void OpenEXRLoad::readLayers(
+            const QVector<Image *> & images,
+            const QVector<int> &     layers,
+            const ImageIOFrameInfo & frame)
+        {
+            //DJV_DEBUG("OpenEXRLoad::readLayers");
+            //DJV_DEBUG_PRINT("frame = " << frame);
+            //DJV_DEBUG_PRINT("layers = " << layers.count());
+            _read(images, layers, frame);
+        }
+
+        void OpenEXRLoad::close()
+        {
+            _t.reset(nullptr);
+            _f.reset(nullptr);
+            _s.reset(nullptr);
+        }
+
+        void OpenEXRLoad::_read(
+            const QVector<Image *> & images,
+            const QVector<int> &     layers,
+            const ImageIOFrameInfo & frame)
+        {
             try
             {
                 // Open the file.
@@ -139,149 +206,455 @@ namespace djv
                 //DJV_DEBUG_PRINT("file name = " << fileName);
                 ImageIOInfo info;
                 _open(fileName, info);
-                if (frame.layer < 0 || frame.layer >= _layers.count())
+                const Imf::Header & header = _t ? _t->header() : _f->header();
+                const bool flip = Imf::DECREASING_Y == header.lineOrder();
+                //DJV_DEBUG_PRINT("flip = " << flip);
+                if (_tmp.size() < static_cast<size_t>(layers.count()))
                 {
-                    throw Core::Error(
-                        OpenEXR::staticName,
-                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                    _tmp.resize(layers.count());
                 }
-                PixelDataInfo pixelDataInfo = info[frame.layer];
-                const bool flip = Imf::DECREASING_Y == _f->header().lineOrder();
-                //DJV_DEBUG_PRINT("flip = " << flip);
-                pixelDataInfo.mirror.y = !flip;
-                //DJV_DEBUG_PRINT("pixel data info = " << pixelDataInfo);
+                std::vector<Plane> planes(layers.count());
+                for (int i = 0; i < layers.count(); ++i)
+                {
+                    if (layers[i] < 0 || layers[i] >= _layers.count())
+                    {
+                        throw Core::Error(
+                            OpenEXR::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                    }
+                    Plane & plane = planes[i];
+                    plane.image = images[i];
+                    plane.info = info[layers[i]];
+                    plane.info.mirror.y = !flip;
+                    //DJV_DEBUG_PRINT("pixel data info = " << plane.info);
+                    plane.layer = layers[i];
+                    plane.channels = Pixel::channels(plane.info.pixel);
+                    plane.byteCount = Pixel::channelByteCount(plane.info.pixel);
+                    plane.cb = plane.channels * plane.byteCount;
 
-                //! Set the image tags.
-                image.tags = info.tags;
+                    //! Set the image tags.
+                    Image & image = *plane.image;
+                    image.tags = info.tags;
 
-                //! Set the color profile.
-                if (_options.inputColorProfile != OpenEXR::COLOR_PROFILE_NONE)
-                {
-                    //DJV_DEBUG_PRINT("color profile");
-                    switch (_options.inputColorProfile)
+                    //! Set the color profile.
+                    if (_options.inputColorProfile != OpenEXR::COLOR_PROFILE_NONE)
+                    {
+                        //DJV_DEBUG_PRINT("color profile");
+                        switch (_options.inputColorProfile)
+                        {
+                        case OpenEXR::COLOR_PROFILE_GAMMA:
+                            //DJV_DEBUG_PRINT("gamma = " << _options.inputGamma);
+                            image.colorProfile.type = ColorProfile::GAMMA;
+                            break;
+                        case OpenEXR::COLOR_PROFILE_EXPOSURE:
+                            image.colorProfile.type = ColorProfile::EXPOSURE;
+                            break;
+                        default: break;
+                        }
+                        image.colorProfile.gamma = _options.inputGamma;
+                        image.colorProfile.exposure = _options.inputExposure;
+                    }
+                    else
                     {
-                    case OpenEXR::COLOR_PROFILE_GAMMA:
-                        //DJV_DEBUG_PRINT("gamma = " << _options.inputGamma);
-                        image.colorProfile.type = ColorProfile::GAMMA;
-                        break;
-                    case OpenEXR::COLOR_PROFILE_EXPOSURE:
-                        image.colorProfile.type = ColorProfile::EXPOSURE;
-                        break;
-                    default: break;
+                        image.colorProfile = ColorProfile();
                     }
-                    image.colorProfile.gamma = _options.inputGamma;
-                    image.colorProfile.exposure = _options.inputExposure;
+                }
+
+                // Read the file. All of the layers are decoded with a single
+                // pass since they share the same frame buffer.
+                if (_t)
+                {
+                    _readTiles(planes, frame.proxy);
                 }
                 else
                 {
-                    image.colorProfile = ColorProfile();
+                    _readScanlines(planes, frame.proxy);
                 }
+            }
+            catch (const std::exception & error)
+            {
+                throw Core::Error(
+                    OpenEXR::staticName,
+                    error.what());
+            }
+            //DJV_DEBUG_PRINT("image = " << *images[0]);
 
-                // Read the file.
-                PixelData * data = frame.proxy ? &_tmp : &image;
-                data->set(pixelDataInfo);
-                const int channels = Pixel::channels(pixelDataInfo.pixel);
-                const int byteCount = Pixel::channelByteCount(pixelDataInfo.pixel);
-                //DJV_DEBUG_PRINT("channels = " << channels);
-                //DJV_DEBUG_PRINT("byteCount = " << byteCount);
-                const int cb = channels * byteCount;
-                const int scb = pixelDataInfo.size.x * channels * byteCount;
-                //DJV_DEBUG_PRINT("fast = " << _fast);
-                if (_fast)
+            close();
+        }
+
+        void OpenEXRLoad::_insert(
+            Imf::FrameBuffer & frameBuffer,
+            const Plane &      plane,
+            char *             p,
+            size_t             yStride)
+        {
+            for (int c = 0; c < plane.channels; ++c)
+            {
+                const QString & channel = _layers[plane.layer].channels[c].name;
+                //DJV_DEBUG_PRINT("channel = " << channel);
+                const glm::ivec2 sampling = _layers[plane.layer].channels[c].sampling;
+                //DJV_DEBUG_PRINT("sampling = " << sampling);
+                frameBuffer.insert(
+                    channel.toUtf8().data(),
+                    Imf::Slice(
+                        OpenEXR::pixelTypeToImf(Pixel::type(plane.info.pixel)),
+                        p + (c * plane.byteCount),
+                        plane.cb,
+                        yStride,
+                        sampling.x,
+                        sampling.y,
+                        0.f));
+            }
+        }
+
+        void OpenEXRLoad::_readScanlines(std::vector<Plane> & planes, PixelDataInfo::PROXY proxy)
+        {
+            //DJV_DEBUG("OpenEXRLoad::_readScanlines");
+
+            // With the nearest proxy filter only the scanlines that are used
+            // by the proxy are read.
+            const bool proxyScanlines =
+                proxy &&
+                PixelDataUtil::PROXY_FILTER_NEAREST == PixelDataUtil::proxyFilter();
+            //DJV_DEBUG_PRINT("proxy scanlines = " << proxyScanlines);
+            const int proxyScale = proxyScanlines ? PixelDataUtil::proxyScale(proxy) : 1;
+            for (size_t i = 0; i < planes.size(); ++i)
+            {
+                Plane & plane = planes[i];
+                if (proxyScanlines)
                 {
-                    Imf::FrameBuffer frameBuffer;
-                    for (int c = 0; c < channels; ++c)
+                    plane.info.size = PixelDataUtil::proxyScale(plane.info.size, proxy);
+                    plane.info.proxy = proxy;
+                }
+                plane.data = proxy && !proxyScanlines ? &_tmp[i] : plane.image;
+                plane.data->set(plane.info);
+            }
+            const int h = planes[0].data->h();
+            //DJV_DEBUG_PRINT("fast = " << _fast);
+            const int intersectedY1 = _intersectedWindow.y + _intersectedWindow.size.y - 1;
+            const bool intersected = _intersectedWindow.size.x > 0 && _intersectedWindow.size.y > 0;
+            if (_fast && !proxyScanlines)
+            {
+                // The data window fits horizontally inside the display
+                // window, so the intersected scanlines are read with a
+                // single call straight into the image. The base pointers
+                // are offset by the display window origin.
+                Imf::FrameBuffer frameBuffer;
+                for (const auto & plane : planes)
+                {
+                    const int cb = plane.cb;
+                    const int scb = plane.data->w() * cb;
+                    _insert(
+                        frameBuffer,
+                        plane,
+                        (char *)plane.data->data() -
+                            (_displayWindow.x * cb) -
+                            (static_cast<qint64>(_displayWindow.y) * scb),
+                        scb);
+                    for (int i = 0; i < h; ++i)
                     {
-                        const QString & channel = _layers[frame.layer].channels[c].name;
-                        //DJV_DEBUG_PRINT("channel = " << channel);
-                        const glm::ivec2 sampling = _layers[frame.layer].channels[c].sampling;
-                        //DJV_DEBUG_PRINT("sampling = " << sampling);
-                        frameBuffer.insert(
-                            channel.toUtf8().data(),
-                            Imf::Slice(
-                                OpenEXR::pixelTypeToImf(Pixel::type(data->pixel())),
-                                (char *)data->data() + (c * byteCount),
-                                cb,
-                                scb,
-                                sampling.x,
-                                sampling.y,
-                                0.f));
+                        const int y = _displayWindow.y + i;
+                        quint8 * p = plane.data->data() + (i * scb);
+                        quint8 * end = p + scb;
+                        if (intersected && y >= _intersectedWindow.y && y <= intersectedY1)
+                        {
+                            memset(p, 0, (_intersectedWindow.x - _displayWindow.x) * cb);
+                            p += (_intersectedWindow.x - _displayWindow.x + _intersectedWindow.size.x) * cb;
+                        }
+                        memset(p, 0, end - p);
                     }
+                }
+                if (intersected)
+                {
                     _f->setFrameBuffer(frameBuffer);
-                    _f->readPixels(
-                        _displayWindow.y,
-                        _displayWindow.y + _displayWindow.size.y - 1);
+                    _f->readPixels(_intersectedWindow.y, intersectedY1);
                 }
-                else
+            }
+            else
+            {
+                // Read the intersected scanlines in large blocks so that
+                // the OpenEXR thread pool can decode the chunks of each
+                // block in parallel. The blocks are aligned with the data
+                // window so that chunks are not decoded more than once.
+                //
+                // With the nearest proxy filter each block is a single
+                // scanline that is used by the proxy instead, so that the
+                // chunks in between are not decoded.
+                quint64 rowByteCount = 0;
+                for (const auto & plane : planes)
+                {
+                    rowByteCount += _dataWindow.size.x * plane.cb;
+                }
+                const quint64 blockByteCount = 64 * Core::Memory::megabyte;
+                const int blockAlign = 256;
+                const int blockRows = Core::Math::max(
+                    blockAlign,
+                    static_cast<int>(blockByteCount / Core::Math::max(rowByteCount, quint64(1))) /
+                    blockAlign * blockAlign);
+                //DJV_DEBUG_PRINT("block rows = " << blockRows);
+                for (auto & plane : planes)
+                {
+                    plane.buf.resize(
+                        intersected ?
+                        Core::Math::min(blockRows, _intersectedWindow.size.y) * _dataWindow.size.x * plane.cb :
+                        0);
+                }
+                std::vector<quint8> scanline;
+                int i = 0;
+                int y0 = _intersectedWindow.y;
+                while (i < h)
                 {
-                    Imf::FrameBuffer frameBuffer;
-                    std::vector<char> buf(_dataWindow.size.x * cb);
-                    for (int c = 0; c < channels; ++c)
+                    if (proxyScanlines)
                     {
-                        const QString & channel = _layers[frame.layer].channels[c].name;
-                        //DJV_DEBUG_PRINT("channel = " << channel);
-                        const glm::ivec2 sampling = _layers[frame.layer].channels[c].sampling;
-                        //DJV_DEBUG_PRINT("sampling = " << sampling);
-                        frameBuffer.insert(
-                            channel.toUtf8().data(),
-                            Imf::Slice(
-                                OpenEXR::pixelTypeToImf(Pixel::type(data->pixel())),
-                                buf.data() - (_dataWindow.x * cb) + (c * byteCount),
-                                cb,
-                                0,
-                                sampling.x,
-                                sampling.y,
-                                0.f));
+                        y0 = _displayWindow.y + i * proxyScale;
                     }
-                    _f->setFrameBuffer(frameBuffer);
-                    for (
-                        int y = _displayWindow.y;
-                        y < _displayWindow.y + _displayWindow.size.y;
-                        ++y)
+                    int y1 = y0 - 1;
+                    if (intersected && y0 >= _intersectedWindow.y && y0 <= intersectedY1)
                     {
-                        quint8 * p = data->data() + ((y - _displayWindow.y) * scb);
-                        quint8 * end = p + scb;
-                        if (y >= _intersectedWindow.y &&
-                            y < _intersectedWindow.y + _intersectedWindow.size.y)
+                        y1 = proxyScanlines ? y0 : Core::Math::min(
+                            _dataWindow.y + ((y0 - _dataWindow.y) / blockRows + 1) * blockRows - 1,
+                            intersectedY1);
+                        //DJV_DEBUG_PRINT("block = " << y0 << " " << y1);
+                        Imf::FrameBuffer frameBuffer;
+                        for (const auto & plane : planes)
                         {
-                            quint64 size = (_intersectedWindow.x - _displayWindow.x) * cb;
-                            memset(p, 0, size);
-                            p += size;
-                            size = _intersectedWindow.size.x * cb;
-                            _f->readPixels(y, y);
-                            memcpy(
-                                p,
-                                buf.data() + Core::Math::max(_displayWindow.x - _dataWindow.x, 0) * cb,
-                                size);
-                            p += size;
+                            // The sampled channels are packed at the start of
+                            // the rows.
+                            for (int c = 0; c < plane.channels; ++c)
+                            {
+                                const QString & channel = _layers[plane.layer].channels[c].name;
+                                //DJV_DEBUG_PRINT("channel = " << channel);
+                                const glm::ivec2 sampling = _layers[plane.layer].channels[c].sampling;
+                                //DJV_DEBUG_PRINT("sampling = " << sampling);
+                                const quint64 planeRowByteCount = _dataWindow.size.x * plane.cb;
+                                frameBuffer.insert(
+                                    channel.toUtf8().data(),
+                                    Imf::Slice(
+                                        OpenEXR::pixelTypeToImf(Pixel::type(plane.info.pixel)),
+                                        (char *)plane.buf.data() -
+                                            (Imath::divp(_dataWindow.x, sampling.x) * plane.cb) -
+                                            (static_cast<qint64>(Imath::divp(y0, sampling.y)) * planeRowByteCount) +
+                                            (c * plane.byteCount),
+                                        plane.cb,
+                                        planeRowByteCount,
+                                        sampling.x,
+                                        sampling.y,
+                                        0.f));
+                            }
                         }
-                        memset(p, 0, end - p);
+                        _f->setFrameBuffer(frameBuffer);
+                        _f->readPixels(y0, y1);
                     }
+
+                    // Copy the scanlines of the block into the images.
+                    int iEnd = i;
+                    if (proxyScanlines)
+                    {
+                        iEnd = i + 1;
+                    }
+                    else
+                    {
+                        while (iEnd < h && !(_displayWindow.y + iEnd * proxyScale > y1 && y0 <= y1))
+                        {
+                            ++iEnd;
+                        }
+                    }
+                    for (const auto & plane : planes)
+                    {
+                        const int cb = plane.cb;
+                        const int scb = _displayWindow.size.x * cb;
+                        const quint64 planeRowByteCount = _dataWindow.size.x * cb;
+                        if (proxyScanlines)
+                        {
+                            scanline.resize(scb);
+                        }
+                        for (int j = i; j < iEnd; ++j)
+                        {
+                            const int y = _displayWindow.y + j * proxyScale;
+                            quint8 * p = proxyScanlines ? scanline.data() : (plane.data->data() + (j * scb));
+                            quint8 * end = p + scb;
+                            if (y >= y0 && y <= y1)
+                            {
+                                quint64 size = (_intersectedWindow.x - _displayWindow.x) * cb;
+                                memset(p, 0, size);
+                                p += size;
+                                size = _intersectedWindow.size.x * cb;
+                                memcpy(
+                                    p,
+                                    plane.buf.data() +
+                                        (y - y0) * planeRowByteCount +
+                                        Core::Math::max(_displayWindow.x - _dataWindow.x, 0) * cb,
+                                    size);
+                                p += size;
+                            }
+                            memset(p, 0, end - p);
+                            if (proxyScanlines)
+                            {
+                                PixelDataUtil::proxyScaleScanline(
+                                    scanline.data(),
+                                    plane.data->data(0, j),
+                                    plane.data->w(),
+                                    cb,
+                                    proxy);
+                            }
+                        }
+                    }
+                    i = iEnd;
+                    y0 = y1 + 1;
                 }
-                if (frame.proxy)
+            }
+            if (proxy && !proxyScanlines)
+            {
+                //DJV_DEBUG_PRINT("proxy");
+                for (size_t i = 0; i < planes.size(); ++i)
                 {
-                    //DJV_DEBUG_PRINT("proxy");
-                    pixelDataInfo.size = PixelDataUtil::proxyScale(pixelDataInfo.size, frame.proxy);
-                    pixelDataInfo.proxy = frame.proxy;
-                    image.set(pixelDataInfo);
-                    PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                    Plane & plane = planes[i];
+                    plane.info.size = PixelDataUtil::proxyScale(plane.info.size, proxy);
+                    plane.info.proxy = proxy;
+                    plane.image->set(plane.info);
+                    PixelDataUtil::proxyScale(_tmp[i], *plane.image, proxy);
                 }
             }
-            catch (const std::exception & error)
+        }
+
+        void OpenEXRLoad::_readTiles(std::vector<Plane> & planes, PixelDataInfo::PROXY proxy)
+        {
+            //DJV_DEBUG("OpenEXRLoad::_readTiles");
+
+            // Find the level that matches the proxy. Only the part of the
+            // proxy that is not covered by the levels is scaled afterwards.
+            int levels = 1;
+            switch (_t->levelMode())
             {
-                throw Core::Error(
-                    OpenEXR::staticName,
-                    error.what());
+            case Imf::MIPMAP_LEVELS: levels = _t->numLevels(); break;
+            case Imf::RIPMAP_LEVELS: levels = Core::Math::min(_t->numXLevels(), _t->numYLevels()); break;
+            default: break;
+            }
+            const int level = Core::Math::min(static_cast<int>(proxy), levels - 1);
+            const PixelDataInfo::PROXY levelProxy = static_cast<PixelDataInfo::PROXY>(level);
+            const PixelDataInfo::PROXY scaleProxy = static_cast<PixelDataInfo::PROXY>(proxy - level);
+            const int scale = PixelDataUtil::proxyScale(levelProxy);
+            const Core::Box2i levelWindow = OpenEXR::imfToBox(_t->dataWindowForLevel(level, level));
+            //DJV_DEBUG_PRINT("level = " << level);
+            //DJV_DEBUG_PRINT("level window = " << levelWindow);
+            for (size_t i = 0; i < planes.size(); ++i)
+            {
+                Plane & plane = planes[i];
+                plane.info.size = PixelDataUtil::proxyScale(plane.info.size, levelProxy);
+                plane.info.proxy = levelProxy;
+                plane.data = scaleProxy ? &_tmp[i] : plane.image;
+                plane.data->set(plane.info);
             }
-            //DJV_DEBUG_PRINT("image = " << image);
+            const int w = planes[0].data->w();
+            const int h = planes[0].data->h();
 
-            close();
-        }
+            // Map the columns and rows of the images onto the level, -1 is
+            // outside of the data window.
+            std::vector<int> columns(w);
+            std::vector<int> rows(h);
+            const int intersectedX1 = _intersectedWindow.x + _intersectedWindow.size.x - 1;
+            const int intersectedY1 = _intersectedWindow.y + _intersectedWindow.size.y - 1;
+            for (int i = 0; i < w; ++i)
+            {
+                const int x = _displayWindow.x + i * scale;
+                columns[i] = x >= _intersectedWindow.x && x <= intersectedX1 ?
+                    Core::Math::min((x - _dataWindow.x) / scale, levelWindow.size.x - 1) :
+                    -1;
+            }
+            for (int i = 0; i < h; ++i)
+            {
+                const int y = _displayWindow.y + i * scale;
+                rows[i] = y >= _intersectedWindow.y && y <= intersectedY1 ?
+                    Core::Math::min((y - _dataWindow.y) / scale, levelWindow.size.y - 1) :
+                    -1;
+            }
+            const auto column0 = std::find_if(columns.begin(), columns.end(), [](int i) { return i >= 0; });
+            const auto row0 = std::find_if(rows.begin(), rows.end(), [](int i) { return i >= 0; });
+            if (column0 == columns.end() || row0 == rows.end())
+            {
+                for (const auto & plane : planes)
+                {
+                    memset(plane.data->data(), 0, plane.data->dataByteCount());
+                }
+            }
+            else
+            {
+                // Read all of the tiles with a single call so that the OpenEXR
+                // thread pool can decode them in parallel.
+                const int tileW = _t->tileXSize();
+                const int tileH = _t->tileYSize();
+                const int tx0 = *column0 / tileW;
+                const int tx1 = *std::find_if(columns.rbegin(), columns.rend(), [](int i) { return i >= 0; }) / tileW;
+                const int ty0 = *row0 / tileH;
+                const int ty1 = *std::find_if(rows.rbegin(), rows.rend(), [](int i) { return i >= 0; }) / tileH;
+                //DJV_DEBUG_PRINT("tiles = " << tx0 << " " << tx1 << " " << ty0 << " " << ty1);
+                const Core::Box2i bounds(
+                    tx0 * tileW,
+                    ty0 * tileH,
+                    Core::Math::min((tx1 + 1) * tileW, levelWindow.size.x) - tx0 * tileW,
+                    Core::Math::min((ty1 + 1) * tileH, levelWindow.size.y) - ty0 * tileH);
+                Imf::FrameBuffer frameBuffer;
+                for (auto & plane : planes)
+                {
+                    const quint64 rowByteCount = bounds.size.x * plane.cb;
+                    plane.buf.resize(bounds.size.y * rowByteCount);
+                    _insert(
+                        frameBuffer,
+                        plane,
+                        plane.buf.data() -
+                            ((levelWindow.x + bounds.x) * plane.cb) -
+                            (static_cast<qint64>(levelWindow.y + bounds.y) * rowByteCount),
+                        rowByteCount);
+                }
+                _t->setFrameBuffer(frameBuffer);
+                _t->readTiles(tx0, tx1, ty0, ty1, level, level);
 
-        void OpenEXRLoad::close()
-        {
-            _f.reset(nullptr);
-            _s.reset(nullptr);
+                // Copy the tiles into the images.
+                for (const auto & plane : planes)
+                {
+                    const int cb = plane.cb;
+                    const int scb = w * cb;
+                    const quint64 rowByteCount = bounds.size.x * cb;
+                    for (int y = 0; y < h; ++y)
+                    {
+                        quint8 * p = plane.data->data() + (y * scb);
+                        if (rows[y] < 0)
+                        {
+                            memset(p, 0, scb);
+                            continue;
+                        }
+                        const char * in = plane.buf.data() + (rows[y] - bounds.y) * rowByteCount;
+                        for (int x = 0; x < w;)
+                        {
+                            if (columns[x] < 0)
+                            {
+                                memset(p + x * cb, 0, cb);
+                                ++x;
+                                continue;
+                            }
+                            int size = 1;
+                            while (x + size < w && columns[x + size] == columns[x] + size)
+                            {
+                                ++size;
+                            }
+                            memcpy(p + x * cb, in + (columns[x] - bounds.x) * cb, size * cb);
+                            x += size;
+                        }
+                    }
+                }
+            }
+            if (scaleProxy)
+            {
+                //DJV_DEBUG_PRINT("proxy");
+                for (size_t i = 0; i < planes.size(); ++i)
+                {
+                    Plane & plane = planes[i];
+                    plane.info.size = PixelDataUtil::proxyScale(plane.info.size, scaleProxy);
+                    plane.info.proxy = proxy;
+                    plane.image->set(plane.info);
+                    PixelDataUtil::proxyScale(_tmp[i], *plane.image, scaleProxy);
+                }
+            }
         }
 
         void OpenEXRLoad::_open(const QString & in, ImageIOInfo & info)
@@ -296,58 +669,92 @@ namespace djv
                 // Open the file.
                 //_f.reset(new Imf::InputFile(in.toUtf8().data()));
                 _s.reset(new MemoryMappedIStream(in.toUtf8().data()));
-                _f.reset(new Imf::InputFile(*_s.get()));
+                bool tiled = false;
+                Imf::isOpenExrFile(*_s.get(), tiled);
+                //DJV_DEBUG_PRINT("tiled = " << tiled);
+                if (tiled)
+                {
+                    _t.reset(new Imf::TiledInputFile(*_s.get()));
+                }
+                else
+                {
+                    _f.reset(new Imf::InputFile(*_s.get()));
+                }
+                const Imf::Header & header = tiled ? _t->header() : _f->header();
 
                 // Get the display and data windows.
-                _displayWindow = OpenEXR::imfToBox(_f->header().displayWindow());
-                _dataWindow = OpenEXR::imfToBox(_f->header().dataWindow());
+                _displayWindow = OpenEXR::imfToBox(header.displayWindow());
+                _dataWindow = OpenEXR::imfToBox(header.dataWindow());
                 _intersectedWindow = Core::BoxUtil::intersect(_displayWindow, _dataWindow);
                 //DJV_DEBUG_PRINT("display window = " << _displayWindow);
                 //DJV_DEBUG_PRINT("data window = " << _dataWindow);
                 //DJV_DEBUG_PRINT("intersected window = " << _intersectedWindow);
-                _fast = _displayWindow == _dataWindow;
 
-                // Get the layers.
-                _layers = OpenEXR::layer(_f->header().channels(), _options.channels);
+                // The image can be read directly when the data window fits
+                // horizontally inside the display window.
+                _fast =
+                    _dataWindow.x >= _displayWindow.x &&
+                    _dataWindow.x + _dataWindow.size.x <= _displayWindow.x + _displayWindow.size.x;
+
+                // Get the layers. Every frame of a sequence usually has the
+                // same channels, so the layers are only rebuilt when the
+                // channels change.
+                const QByteArray key = channelsKey(header.channels());
+                if (key != _channelsKey)
+                {
+                    //DJV_DEBUG_PRINT("channels changed");
+                    _channelsKey.clear();
+                    _layers = OpenEXR::layer(header.channels(), _options.channels);
+                    _layerInfo.clear();
+                    _sampled = false;
+                    for (int i = 0; i < _layers.count(); ++i)
+                    {
+                        //DJV_DEBUG_PRINT("layer = " << _layers[i].name);
+                        const glm::ivec2 sampling(
+                            _layers[i].channels[0].sampling.x,
+                            _layers[i].channels[0].sampling.y);
+                        //DJV_DEBUG_PRINT("sampling = " << sampling);
+                        if (sampling.x != 1 || sampling.y != 1)
+                            _sampled = true;
+                        PixelDataInfo pixelDataInfo;
+                        pixelDataInfo.layerName = _layers[i].name;
+                        Pixel::FORMAT format = static_cast<Pixel::FORMAT>(0);
+                        if (!Pixel::format(_layers[i].channels.count(), format))
+                        {
+                            throw Core::Error(
+                                OpenEXR::staticName,
+                                ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+                        }
+                        //DJV_DEBUG_PRINT("format = " << format);
+                        if (!Pixel::pixel(
+                            format,
+                            _layers[i].channels[0].type,
+                            pixelDataInfo.pixel))
+                        {
+                            throw Core::Error(
+                                OpenEXR::staticName,
+                                ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+                        }
+                        //DJV_DEBUG_PRINT("pixel = " << pixelDataInfo.pixel);
+                        _layerInfo += pixelDataInfo;
+                    }
+                    _channelsKey = key;
+                }
                 info.setLayerCount(_layers.count());
                 //DJV_DEBUG_PRINT("layers = " << _layers.count());
                 for (int i = 0; i < _layers.count(); ++i)
                 {
-                    //DJV_DEBUG_PRINT("layer = " << _layers[i].name);
-                    const glm::ivec2 sampling(
-                        _layers[i].channels[0].sampling.x,
-                        _layers[i].channels[0].sampling.y);
-                    //DJV_DEBUG_PRINT("sampling = " << sampling);
-                    if (sampling.x != 1 || sampling.y != 1)
-                        _fast = false;
-                    PixelDataInfo pixelDataInfo;
+                    PixelDataInfo pixelDataInfo = _layerInfo[i];
                     pixelDataInfo.fileName = in;
-                    pixelDataInfo.layerName = _layers[i].name;
                     pixelDataInfo.size = _displayWindow.size;
-                    Pixel::FORMAT format = static_cast<Pixel::FORMAT>(0);
-                    if (!Pixel::format(_layers[i].channels.count(), format))
-                    {
-                        throw Core::Error(
-                            OpenEXR::staticName,
-                            ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
-                    }
-                    //DJV_DEBUG_PRINT("format = " << format);
-                    if (!Pixel::pixel(
-                        format,
-                        _layers[i].channels[0].type,
-                        pixelDataInfo.pixel))
-                    {
-                        throw Core::Error(
-                            OpenEXR::staticName,
-                            ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
-                    }
-                    //DJV_DEBUG_PRINT("pixel = " << pixelDataInfo.pixel);
                     info[i] = pixelDataInfo;
                 }
+                if (_sampled)
+                    _fast = false;
                 //DJV_DEBUG_PRINT("fast = " << _fast);
 
                 // Get the image tags.
-                OpenEXR::loadTags(_f->header(), info);
+                OpenEXR::loadTags(header, info);
             }
             catch (const std::exception & error)
             {
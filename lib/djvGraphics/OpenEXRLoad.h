@@ -36,6 +36,9 @@
 #include <djvCore/FileInfo.h>
 
 #include <ImfInputFile.h>
+#include <ImfTiledInputFile.h>
+
+#include <vector>
 
 namespace djv
 {
@@ -69,20 +72,34 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            void readLayers(
+                const QVector<Image *> &,
+                const QVector<int> & layers,
+                const ImageIOFrameInfo & = ImageIOFrameInfo()) override;
             void close() override;
 
         private:
+            struct Plane;
+
             void _open(const QString &, ImageIOInfo &);
+            void _read(const QVector<Image *> &, const QVector<int> & layers, const ImageIOFrameInfo &);
+            void _insert(Imf::FrameBuffer &, const Plane &, char *, size_t yStride);
+            void _readScanlines(std::vector<Plane> &, PixelDataInfo::PROXY);
+            void _readTiles(std::vector<Plane> &, PixelDataInfo::PROXY);
 
             OpenEXR::Options                     _options;
             Core::FileInfo                       _file;
             std::unique_ptr<MemoryMappedIStream> _s;
             std::unique_ptr<Imf::InputFile>      _f;
+            std::unique_ptr<Imf::TiledInputFile> _t;
             Core::Box2i                          _displayWindow;
             Core::Box2i                          _dataWindow;
             Core::Box2i                          _intersectedWindow;
             QVector<OpenEXR::Layer>              _layers;
-            PixelData                            _tmp;
+            QVector<PixelDataInfo>               _layerInfo;
+            QByteArray                           _channelsKey;
+            bool                                 _sampled = false;
+            std::vector<PixelData>               _tmp;
             bool                                 _fast = false;
         };
 
@@ -103,8 +103,7 @@ namespace djv
                 if (p->info() != _info)
                 {
                     //DJV_DEBUG_PRINT("convert = " << _tmp);
-                    _tmp.zero();
-                    OpenGLImage().copy(in, _tmp);
+                    openGLImage().copy(in, _tmp);
                     p = &_tmp;
                 }
 
@@ -220,40 +220,32 @@ namespace djv
 
         OpenGLImage::OpenGLImage() :
             _p(new Private)
-        {
-            _p->texture.reset(new OpenGLTexture);
-            _p->shader.reset(new OpenGLShader);
-            _p->scaleXContrib.reset(new OpenGLTexture);
-            _p->scaleYContrib.reset(new OpenGLTexture);
-            _p->scaleXShader.reset(new OpenGLShader);
-            _p->scaleYShader.reset(new OpenGLShader);
-            _p->lutColorProfile.reset(new OpenGLLUT);
-            _p->lutDisplayProfile.reset(new OpenGLLUT);
-            _p->mesh.reset(new OpenGLImageMesh);
-        }
+        {}
 
         OpenGLImage::~OpenGLImage()
         {}
 
-        namespace
+        bool initAlpha(const Pixel::PIXEL & input, const Pixel::PIXEL & output)
         {
-            bool initAlpha(const Pixel::PIXEL & input, const Pixel::PIXEL & output)
+            switch (Pixel::format(input))
             {
-                switch (Pixel::format(input))
+            case Pixel::L:
+            case Pixel::RGB:
+                switch (Pixel::format(output))
                 {
-                case Pixel::L:
-                case Pixel::RGB:
-                    switch (Pixel::format(output))
-                    {
-                    case Pixel::LA:
-                    case Pixel::RGBA: return true;
-                    default: break;
-                    }
-                    break;
+                case Pixel::LA:
+                case Pixel::RGBA: return true;
                 default: break;
                 }
-                return false;
+                break;
+            default: break;
             }
+            return false;
+        }
+
+        namespace
+        {
+            bool _softwareCopy = false;
 
         } // namespace
 
@@ -267,6 +259,12 @@ namespace djv
             //DJV_DEBUG_PRINT("output = " << output);
             //DJV_DEBUG_PRINT("scale = " << options.xform.scale);
 
+            if (_softwareCopy || !QOpenGLContext::currentContext())
+            {
+                _p->copySoftware(input, output, options);
+                return;
+            }
+
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
 
             if (!_p->buffer || (_p->buffer && _p->buffer->info() != output.info()))
@@ -322,6 +320,16 @@ namespace djv
             }
         }
 
+        bool OpenGLImage::softwareCopy()
+        {
+            return _softwareCopy;
+        }
+
+        void OpenGLImage::setSoftwareCopy(bool value)
+        {
+            _softwareCopy = value;
+        }
+
         void OpenGLImage::stateUnpack(const PixelDataInfo & in, const glm::ivec2 & offset)
         {
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
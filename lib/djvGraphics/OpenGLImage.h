@@ -220,7 +220,8 @@ namespace djv
                 const OpenGLImageOptions & options = OpenGLImageOptions(),
                 Pixel::FORMAT              outputFormat = Pixel::RGBA);
 
-            //! Copy pixel data.
+            //! Copy pixel data. The copy is rendered with OpenGL unless the
+            //! software path is enabled or there is no current OpenGL context.
             //!
             //! Throws:
             //! - Core::Error
@@ -229,6 +230,12 @@ namespace djv
                 PixelData &                output,
                 const OpenGLImageOptions & options = OpenGLImageOptions());
 
+            //! Get whether pixel data is copied on the CPU instead of with OpenGL.
+            static bool softwareCopy();
+
+            //! Set whether pixel data is copied on the CPU instead of with OpenGL.
+            static void setSoftwareCopy(bool);
+
             //! Setup OpenGL state for image drawing.
             static void stateUnpack(
                 const PixelDataInfo & info,
@@ -337,80 +337,80 @@ namespace djv
                 return Core::Math::clamp(in, 0, size - 1);
             }
 
-            void scaleContrib(
-                int                       input,
-                int                       output,
-                OpenGLImageFilter::FILTER filter,
-                PixelData &               data)
+        } // namespace
+
+        void scaleContrib(
+            int                       input,
+            int                       output,
+            OpenGLImageFilter::FILTER filter,
+            PixelData &               data)
+        {
+            //DJV_DEBUG("scaleContrib");
+            //DJV_DEBUG_PRINT("scale = " << input << " " << output);
+            //DJV_DEBUG_PRINT("filter = " << filter);
+
+            // Filter function.
+            FilterFnc * fnc = filterFnc(filter);
+            const float support = filterSupport(filter);
+            //DJV_DEBUG_PRINT("support = " << support);
+            const float scale = static_cast<float>(output) / static_cast<float>(input);
+            //DJV_DEBUG_PRINT("scale = " << scale);
+            const float radius = support * (scale >= 1.f ? 1.f : (1.f / scale));
+            //DJV_DEBUG_PRINT("radius = " << radius);
+
+            // Initialize.
+            const int width = Core::Math::ceil(radius * 2.f + 1.f);
+            //DJV_DEBUG_PRINT("width = " << width);
+            data.set(PixelDataInfo(output, width, Pixel::LA_F32));
+
+            // Work.
+            for (int i = 0; i < output; ++i)
             {
-                //DJV_DEBUG("scaleContrib");
-                //DJV_DEBUG_PRINT("scale = " << input << " " << output);
-                //DJV_DEBUG_PRINT("filter = " << filter);
-
-                // Filter function.
-                FilterFnc * fnc = filterFnc(filter);
-                const float support = filterSupport(filter);
-                //DJV_DEBUG_PRINT("support = " << support);
-                const float scale = static_cast<float>(output) / static_cast<float>(input);
-                //DJV_DEBUG_PRINT("scale = " << scale);
-                const float radius = support * (scale >= 1.f ? 1.f : (1.f / scale));
-                //DJV_DEBUG_PRINT("radius = " << radius);
-
-                // Initialize.
-                const int width = Core::Math::ceil(radius * 2.f + 1.f);
-                //DJV_DEBUG_PRINT("width = " << width);
-                data.set(PixelDataInfo(output, width, Pixel::LA_F32));
-
-                // Work.
-                for (int i = 0; i < output; ++i)
+                const float center = i / scale;
+                const int   left   = Core::Math::ceil(center - radius);
+                const int   right  = Core::Math::floor(center + radius);
+                //DJV_DEBUG_PRINT(i << " = " << left << " " << center << " " << right);
+
+                float sum = 0.f;
+                int   pixel = 0;
+                int j = 0;
+                for (int k = left; j < width && k <= right; ++j, ++k)
                 {
-                    const float center = i / scale;
-                    const int   left   = Core::Math::ceil(center - radius);
-                    const int   right  = Core::Math::floor(center + radius);
-                    //DJV_DEBUG_PRINT(i << " = " << left << " " << center << " " << right);
-
-                    float sum = 0.f;
-                    int   pixel = 0;
-                    int j = 0;
-                    for (int k = left; j < width && k <= right; ++j, ++k)
-                    {
-                        Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-                        pixel = edge(k, input);
-                        const float x = (center - k) * (scale < 1.f ? scale : 1.f);
-                        const float w = (scale < 1.f) ? ((*fnc)(x) * scale) : (*fnc)(x);
-                        //DJV_DEBUG_PRINT("w = " << w);
-                        p[0] = static_cast<Pixel::F32_T>(pixel / static_cast<float>(input));
-                        p[1] = static_cast<Pixel::F32_T>(w);
-                        sum += w;
-                    }
+                    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
+                    pixel = edge(k, input);
+                    const float x = (center - k) * (scale < 1.f ? scale : 1.f);
+                    const float w = (scale < 1.f) ? ((*fnc)(x) * scale) : (*fnc)(x);
+                    //DJV_DEBUG_PRINT("w = " << w);
+                    p[0] = static_cast<Pixel::F32_T>(pixel / static_cast<float>(input));
+                    p[1] = static_cast<Pixel::F32_T>(w);
+                    sum += w;
+                }
 
-                    for (; j < width; ++j)
-                    {
-                        Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-                        p[0] = static_cast<Pixel::F32_T>(pixel / static_cast<float>(input));
-                        p[1] = 0.f;
-                    }
+                for (; j < width; ++j)
+                {
+                    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
+                    p[0] = static_cast<Pixel::F32_T>(pixel / static_cast<float>(input));
+                    p[1] = 0.f;
+                }
 
-                    for (j = 0; j < width; ++j)
-                    {
-                        Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-                        //DJV_DEBUG_PRINT(p[0] << " = " << p[1]);
-                    }
-                    //DJV_DEBUG_PRINT("sum = " << sum);
+                for (j = 0; j < width; ++j)
+                {
+                    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
+                    //DJV_DEBUG_PRINT(p[0] << " = " << p[1]);
+                }
+                //DJV_DEBUG_PRINT("sum = " << sum);
 
-                    //! \todo Why is it necessary to average the scale contributions?
-                    //! Without this the values don't always add up to zero causing image
-                    //! artifacts.
-                    for (j = 0; j < width; ++j)
-                    {
-                        Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-                        p[1] /= static_cast<Pixel::F32_T>(sum);
-                        //DJV_DEBUG_PRINT(p[1]);
-                    }
+                //! \todo Why is it necessary to average the scale contributions?
+                //! Without this the values don't always add up to zero causing image
+                //! artifacts.
+                for (j = 0; j < width; ++j)
+                {
+                    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
+                    p[1] /= static_cast<Pixel::F32_T>(sum);
+                    //DJV_DEBUG_PRINT(p[1]);
                 }
             }
-
-        } // namespace
+        }
 
         namespace
         {
@@ -770,28 +770,33 @@ namespace djv
                 return Core::Math::log(x * f + 1.f) / f;
             }
 
-            float knee2(float x, float y)
+        } // namespace
+
+        float knee2(float x, float y)
+        {
+            float f0 = 0.f, f1 = 1.f;
+            while (knee(x, f1) > y)
+            {
+                f0 = f1;
+                f1 = f1 * 2.f;
+            }
+            for (int i = 0; i < 30; ++i)
             {
-                float f0 = 0.f, f1 = 1.f;
-                while (knee(x, f1) > y)
+                const float f2 = (f0 + f1) / 2.f;
+                if (knee(x, f2) < y)
                 {
-                    f0 = f1;
-                    f1 = f1 * 2.f;
+                    f1 = f2;
                 }
-                for (int i = 0; i < 30; ++i)
+                else
                 {
-                    const float f2 = (f0 + f1) / 2.f;
-                    if (knee(x, f2) < y)
-                    {
-                        f1 = f2;
-                    }
-                    else
-                    {
-                        f0 = f2;
-                    }
+                    f0 = f2;
                 }
-                return (f0 + f1) / 2.f;
             }
+            return (f0 + f1) / 2.f;
+        }
+
+        namespace
+        {
 
             void colorProfileInit(
                 const OpenGLImageOptions & options,
@@ -936,6 +941,21 @@ namespace djv
             //DJV_DEBUG_PRINT("filter mag = " << options.filter.mag);
             //DJV_DEBUG_PRINT("filter = " << filter);
 
+            // The OpenGL objects are created on first use so that the software
+            // path never requires an OpenGL context.
+            if (!_p->mesh)
+            {
+                _p->texture.reset(new OpenGLTexture);
+                _p->shader.reset(new OpenGLShader);
+                _p->scaleXContrib.reset(new OpenGLTexture);
+                _p->scaleYContrib.reset(new OpenGLTexture);
+                _p->scaleXShader.reset(new OpenGLShader);
+                _p->scaleYShader.reset(new OpenGLShader);
+                _p->lutColorProfile.reset(new OpenGLLUT);
+                _p->lutDisplayProfile.reset(new OpenGLLUT);
+                _p->mesh.reset(new OpenGLImageMesh);
+            }
+
             if (!_p->init || _p->info != info || _p->options != options)
             {
                 _p->init = true;
@@ -50,7 +50,26 @@ namespace djv
             std::unique_ptr<OpenGLLUT> lutDisplayProfile;
             std::unique_ptr<OpenGLImageMesh> mesh;
             std::unique_ptr<OpenGLOffscreenBuffer> buffer;
+
+            //! Copy pixel data on the CPU.
+            void copySoftware(
+                const PixelData &          input,
+                PixelData &                output,
+                const OpenGLImageOptions & options);
         };
 
+        //! Calculate the filter contributions for scaling.
+        void scaleContrib(
+            int                       input,
+            int                       output,
+            OpenGLImageFilter::FILTER filter,
+            PixelData &               data);
+
+        //! Calculate the exposure knee.
+        float knee2(float x, float y);
+
+        //! Get whether the alpha channel is initialized when copying pixel data.
+        bool initAlpha(const Pixel::PIXEL & input, const Pixel::PIXEL & output);
+
     } // namespace Graphics
 } // namespace djv
@@ -0,0 +1,670 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/OpenGLImage.h>
+
+#include <djvGraphics/ColorUtil.h>
+#include <djvGraphics/OpenGLImagePrivate.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/ThreadPool.h>
+
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            //! The minimum number of scanlines given to a thread.
+            const int threadScanlinesMin = 16;
+
+            //! Process scanlines in parallel. The function is given the first
+            //! scanline and one past the last scanline of a band.
+            void parallelScanlines(int h, const std::function<void(int, int)> & fnc)
+            {
+                Core::ThreadPool::global()->parallelFor(h, threadScanlinesMin, fnc);
+            }
+
+            int wordSize(Pixel::PIXEL pixel)
+            {
+                return Pixel::RGB_U10 == pixel ? 4 : Pixel::channelByteCount(pixel);
+            }
+
+            //! Read a scanline and convert it to the given pixel.
+            void readScanline(
+                const PixelData &     in,
+                int                   y,
+                Pixel::PIXEL          pixel,
+                Pixel::F32_T *        out,
+                std::vector<quint8> & tmp)
+            {
+                const PixelDataInfo & info = in.info();
+                const quint8 * p = in.data(0, y);
+                const int size = wordSize(info.pixel);
+                if (info.endian != Core::Memory::endian() && size > 1)
+                {
+                    const quint64 byteCount = info.size.x * in.pixelByteCount();
+                    tmp.resize(byteCount);
+                    Core::Memory::convertEndian(p, tmp.data(), byteCount / size, size);
+                    p = tmp.data();
+                }
+                Pixel::convert(p, info.pixel, out, pixel, info.size.x, 1, info.bgr);
+            }
+
+            //! Convert a scanline from the given pixel and write it.
+            void writeScanline(
+                const Pixel::F32_T *  in,
+                Pixel::PIXEL          pixel,
+                const PixelDataInfo & info,
+                quint8 *              out)
+            {
+                Pixel::convert(in, pixel, out, info.pixel, info.size.x, 1, info.bgr);
+                const int size = wordSize(info.pixel);
+                if (info.endian != Core::Memory::endian() && size > 1)
+                {
+                    Core::Memory::convertEndian(
+                        out,
+                        info.size.x * Pixel::byteCount(info.pixel) / size,
+                        size);
+                }
+            }
+
+            //! This struct provides a floating-point RGBA image.
+            struct Buffer
+            {
+                void init(const glm::ivec2 & size)
+                {
+                    this->size = size;
+                    data.resize(static_cast<size_t>(size.x) * size.y * Pixel::channelsMax);
+                }
+
+                Pixel::F32_T * scanline(int y)
+                {
+                    return data.data() + static_cast<size_t>(y) * size.x * Pixel::channelsMax;
+                }
+
+                const Pixel::F32_T * scanline(int y) const
+                {
+                    return data.data() + static_cast<size_t>(y) * size.x * Pixel::channelsMax;
+                }
+
+                glm::ivec2                size = glm::ivec2(0, 0);
+                std::vector<Pixel::F32_T> data;
+            };
+
+            //! This struct provides a lookup table.
+            struct LUT
+            {
+                int                       size     = 0;
+                int                       channels = 0;
+                std::vector<Pixel::F32_T> data;
+            };
+
+            void lutInit(const PixelData & in, LUT & out)
+            {
+                out.size = in.w();
+                out.channels = in.channels();
+                out.data.resize(out.size * out.channels);
+                if (out.size)
+                {
+                    std::vector<quint8> tmp;
+                    readScanline(
+                        in,
+                        0,
+                        Pixel::pixel(Pixel::format(in.pixel()), Pixel::F32),
+                        out.data.data(),
+                        tmp);
+                }
+            }
+
+            //! Look up a value the same way as a nearest neighbor, clamp to edge
+            //! texture.
+            inline Pixel::F32_T lutValue(const LUT & lut, Pixel::F32_T value, int channel)
+            {
+                const int i = Core::Math::clamp(
+                    static_cast<int>(Core::Math::clamp(value, 0.f, 1.f) * lut.size),
+                    0,
+                    lut.size - 1);
+                return lut.data[i * lut.channels + channel];
+            }
+
+            void lutApply(const LUT & lut, Pixel::F32_T * p)
+            {
+                if (!lut.size)
+                    return;
+                switch (lut.channels)
+                {
+                case 1:
+                    p[0] = lutValue(lut, p[0], 0);
+                    p[1] = lutValue(lut, p[1], 0);
+                    p[2] = lutValue(lut, p[2], 0);
+                    break;
+                case 2:
+                    p[0] = lutValue(lut, p[0], 0);
+                    p[1] = lutValue(lut, p[1], 0);
+                    p[2] = lutValue(lut, p[2], 0);
+                    p[3] = lutValue(lut, p[3], 1);
+                    break;
+                case 3:
+                    p[0] = lutValue(lut, p[0], 0);
+                    p[1] = lutValue(lut, p[1], 1);
+                    p[2] = lutValue(lut, p[2], 2);
+                    break;
+                case 4:
+                    p[0] = lutValue(lut, p[0], 0);
+                    p[1] = lutValue(lut, p[1], 1);
+                    p[2] = lutValue(lut, p[2], 2);
+                    //! \todo The shader looks up the alpha channel with the blue
+                    //! channel, do the same here so the results match.
+                    p[3] = lutValue(lut, p[2], 3);
+                    break;
+                default: break;
+                }
+            }
+
+            //! This struct provides color profile data.
+            struct ColorProfileData
+            {
+                ColorProfile::PROFILE type  = ColorProfile::RAW;
+                LUT                   lut;
+                float                 gamma = 1.f;
+                float                 v     = 0.f;
+                float                 d     = 0.f;
+                float                 k     = 0.f;
+                float                 f     = 0.f;
+            };
+
+            void colorProfileInit(const ColorProfile & in, ColorProfileData & out)
+            {
+                out.type = in.type;
+                switch (in.type)
+                {
+                case ColorProfile::LUT:
+                    lutInit(in.lut, out.lut);
+                    break;
+                case ColorProfile::GAMMA:
+                    out.gamma = 1.f / in.gamma;
+                    break;
+                case ColorProfile::EXPOSURE:
+                    out.v = Core::Math::pow(2.f, in.exposure.value + 2.47393f);
+                    out.d = in.exposure.defog;
+                    out.k = Core::Math::pow(2.f, in.exposure.kneeLow);
+                    out.f = knee2(
+                        Core::Math::pow(2.f, in.exposure.kneeHigh) - out.k,
+                        Core::Math::pow(2.f, 3.5f) - out.k);
+                    break;
+                default: break;
+                }
+            }
+
+            void colorProfileApply(const ColorProfileData & data, Pixel::F32_T * p)
+            {
+                switch (data.type)
+                {
+                case ColorProfile::LUT:
+                    lutApply(data.lut, p);
+                    break;
+                case ColorProfile::GAMMA:
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        if (p[c] >= 0.f)
+                        {
+                            p[c] = Core::Math::pow(p[c], data.gamma);
+                        }
+                    }
+                    break;
+                case ColorProfile::EXPOSURE:
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        p[c] = Core::Math::max(0.f, p[c] - data.d) * data.v;
+                        if (p[c] > data.k)
+                        {
+                            p[c] = data.k + Core::Math::log((p[c] - data.k) * data.f + 1.f) / data.f;
+                        }
+                        p[c] *= .332f;
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            //! This struct provides display profile data.
+            struct DisplayProfileData
+            {
+                bool        lut         = false;
+                LUT         lutData;
+                bool        color       = false;
+                glm::mat4x4 colorMatrix;
+                bool        levels      = false;
+                bool        levelsGamma = false;
+                float       in0         = 0.f;
+                float       in1         = 1.f;
+                float       gamma       = 1.f;
+                float       out0        = 0.f;
+                float       out1        = 1.f;
+                bool        softClip    = false;
+                float       softClipValue = 0.f;
+            };
+
+            void displayProfileInit(const OpenGLImageDisplayProfile & in, DisplayProfileData & out)
+            {
+                if (in.lut.isValid())
+                {
+                    out.lut = true;
+                    lutInit(in.lut, out.lutData);
+                }
+                if (in.color != OpenGLImageDisplayProfile().color)
+                {
+                    out.color = true;
+                    out.colorMatrix = OpenGLImageColor::colorMatrix(in.color);
+                }
+                if (in.levels != OpenGLImageDisplayProfile().levels)
+                {
+                    out.levels = true;
+                    out.levelsGamma = !Core::Math::fuzzyCompare(in.levels.gamma, 1.f);
+                    out.in0 = in.levels.inLow;
+                    out.in1 = in.levels.inHigh - in.levels.inLow;
+                    out.gamma = 1.f / in.levels.gamma;
+                    out.out0 = in.levels.outLow;
+                    out.out1 = in.levels.outHigh - in.levels.outLow;
+                }
+                if (in.softClip != OpenGLImageDisplayProfile().softClip)
+                {
+                    out.softClip = true;
+                    out.softClipValue = in.softClip;
+                }
+            }
+
+            void displayProfileApply(const DisplayProfileData & data, Pixel::F32_T * p)
+            {
+                if (data.lut)
+                {
+                    lutApply(data.lutData, p);
+                }
+                if (data.color)
+                {
+                    const glm::vec4 tmp = glm::vec4(p[0], p[1], p[2], 1.f) * data.colorMatrix;
+                    p[0] = tmp[0];
+                    p[1] = tmp[1];
+                    p[2] = tmp[2];
+                }
+                if (data.levels)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float tmp = (p[c] - data.in0) / data.in1;
+                        if (data.levelsGamma && tmp >= 0.f)
+                        {
+                            tmp = Core::Math::pow(tmp, data.gamma);
+                        }
+                        p[c] = tmp * data.out1 + data.out0;
+                    }
+                }
+                if (data.softClip)
+                {
+                    const float tmp = 1.f - data.softClipValue;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        if (p[c] > tmp)
+                        {
+                            p[c] = tmp + (1.f - Core::Math::exp(-(p[c] - tmp) / data.softClipValue)) * data.softClipValue;
+                        }
+                    }
+                }
+            }
+
+            //! This struct provides the filter contributions for scaling.
+            struct Contrib
+            {
+                int                       width = 0;
+                std::vector<int>          index;
+                std::vector<Pixel::F32_T> weight;
+            };
+
+            void contribInit(int input, int output, OpenGLImageFilter::FILTER filter, Contrib & out)
+            {
+                PixelData tmp;
+                scaleContrib(input, output, filter, tmp);
+                const PixelData & data = tmp;
+                out.width = data.h();
+                out.index.resize(output * out.width);
+                out.weight.resize(output * out.width);
+                for (int i = 0; i < output; ++i)
+                {
+                    for (int j = 0; j < out.width; ++j)
+                    {
+                        const Pixel::F32_T * p = reinterpret_cast<const Pixel::F32_T *>(data.data(i, j));
+                        out.index[i * out.width + j] = Core::Math::clamp(
+                            Core::Math::round(p[0] * input),
+                            0,
+                            input - 1);
+                        out.weight[i * out.width + j] = p[1];
+                    }
+                }
+            }
+
+            //! Scale horizontally, mirroring the result.
+            void scaleX(
+                const Buffer &                in,
+                const Contrib &               contrib,
+                const PixelDataInfo::Mirror & mirror,
+                Buffer &                      out)
+            {
+                parallelScanlines(out.size.y, [&](int y0, int y1)
+                {
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        const Pixel::F32_T * inP = in.scanline(mirror.y ? (in.size.y - 1 - y) : y);
+                        Pixel::F32_T * outP = out.scanline(y);
+                        for (int x = 0; x < out.size.x; ++x, outP += Pixel::channelsMax)
+                        {
+                            const int i = (mirror.x ? (out.size.x - 1 - x) : x) * contrib.width;
+                            const int * index = contrib.index.data() + i;
+                            const Pixel::F32_T * weight = contrib.weight.data() + i;
+                            outP[0] = outP[1] = outP[2] = outP[3] = 0.f;
+                            for (int j = 0; j < contrib.width; ++j)
+                            {
+                                const Pixel::F32_T * p = inP + index[j] * Pixel::channelsMax;
+                                outP[0] += weight[j] * p[0];
+                                outP[1] += weight[j] * p[1];
+                                outP[2] += weight[j] * p[2];
+                                outP[3] += weight[j] * p[3];
+                            }
+                        }
+                    }
+                });
+            }
+
+            //! Scale vertically.
+            void scaleY(
+                const Buffer &  in,
+                const Contrib & contrib,
+                Buffer &        out)
+            {
+                parallelScanlines(out.size.y, [&](int y0, int y1)
+                {
+                    const int size = out.size.x * Pixel::channelsMax;
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        Pixel::F32_T * outP = out.scanline(y);
+                        std::fill(outP, outP + size, 0.f);
+                        const int * index = contrib.index.data() + y * contrib.width;
+                        const Pixel::F32_T * weight = contrib.weight.data() + y * contrib.width;
+                        for (int j = 0; j < contrib.width; ++j)
+                        {
+                            const Pixel::F32_T * inP = in.scanline(index[j]);
+                            for (int i = 0; i < size; ++i)
+                            {
+                                outP[i] += weight[j] * inP[i];
+                            }
+                        }
+                    }
+                });
+            }
+
+            void sampleNearest(const Buffer & in, float u, float v, Pixel::F32_T * out)
+            {
+                const int x = Core::Math::clamp(Core::Math::floor(u * in.size.x), 0, in.size.x - 1);
+                const int y = Core::Math::clamp(Core::Math::floor(v * in.size.y), 0, in.size.y - 1);
+                const Pixel::F32_T * p = in.scanline(y) + x * Pixel::channelsMax;
+                out[0] = p[0];
+                out[1] = p[1];
+                out[2] = p[2];
+                out[3] = p[3];
+            }
+
+            void sampleLinear(const Buffer & in, float u, float v, Pixel::F32_T * out)
+            {
+                const float x = u * in.size.x - .5f;
+                const float y = v * in.size.y - .5f;
+                const int   x0 = Core::Math::floor(x);
+                const int   y0 = Core::Math::floor(y);
+                const float a = x - x0;
+                const float b = y - y0;
+                const int   xa = Core::Math::clamp(x0, 0, in.size.x - 1) * Pixel::channelsMax;
+                const int   xb = Core::Math::clamp(x0 + 1, 0, in.size.x - 1) * Pixel::channelsMax;
+                const Pixel::F32_T * ya = in.scanline(Core::Math::clamp(y0, 0, in.size.y - 1));
+                const Pixel::F32_T * yb = in.scanline(Core::Math::clamp(y0 + 1, 0, in.size.y - 1));
+                for (int c = 0; c < Pixel::channelsMax; ++c)
+                {
+                    out[c] =
+                        (ya[xa + c] * (1.f - a) + ya[xb + c] * a) * (1.f - b) +
+                        (yb[xa + c] * (1.f - a) + yb[xb + c] * a) * b;
+                }
+            }
+
+        } // namespace
+
+        void OpenGLImage::Private::copySoftware(
+            const PixelData &          input,
+            PixelData &                output,
+            const OpenGLImageOptions & options)
+        {
+            //DJV_DEBUG("OpenGLImage::Private::copySoftware");
+            //DJV_DEBUG_PRINT("input = " << input);
+            //DJV_DEBUG_PRINT("output = " << output);
+            //DJV_DEBUG_PRINT("scale = " << options.xform.scale);
+
+            const PixelDataInfo & info = input.info();
+            const PixelDataInfo & outputInfo = output.info();
+
+            OpenGLImageOptions _options = options;
+            if (outputInfo.mirror.x)
+            {
+                _options.xform.mirror.x = !_options.xform.mirror.x;
+            }
+            if (outputInfo.mirror.y)
+            {
+                _options.xform.mirror.y = !_options.xform.mirror.y;
+            }
+
+            // Use the same scale, filter, and mirroring as OpenGLImage::draw().
+            const int proxyScale =
+                _options.proxyScale ?
+                PixelDataUtil::proxyScale(info.proxy) :
+                1;
+            const glm::ivec2 scale(
+                Core::Math::ceil(_options.xform.scale.x * info.size.x * proxyScale),
+                Core::Math::ceil(_options.xform.scale.y * info.size.y * proxyScale));
+            const OpenGLImageFilter::FILTER filter =
+                info.size == scale ? OpenGLImageFilter::NEAREST :
+                (scale.x * scale.y < info.size.x * info.size.y ?
+                    _options.filter.min : _options.filter.mag);
+            const PixelDataInfo::Mirror mirror(
+                info.mirror.x ? (!_options.xform.mirror.x) : _options.xform.mirror.x,
+                info.mirror.y ? (!_options.xform.mirror.y) : _options.xform.mirror.y);
+            //DJV_DEBUG_PRINT("scale = " << scale);
+            //DJV_DEBUG_PRINT("filter = " << filter);
+
+            ColorProfileData colorProfile;
+            colorProfileInit(_options.colorProfile, colorProfile);
+            DisplayProfileData displayProfile;
+            displayProfileInit(_options.displayProfile, displayProfile);
+
+            // Convert the input to floating-point RGBA.
+            Buffer source;
+            source.init(info.size);
+            parallelScanlines(info.size.y, [&](int y0, int y1)
+            {
+                std::vector<quint8> tmp;
+                for (int y = y0; y < y1; ++y)
+                {
+                    readScanline(input, y, Pixel::RGBA_F32, source.scanline(y), tmp);
+                }
+            });
+
+            // Filter the input.
+            OpenGLImageXform xform = _options.xform;
+            glm::vec2 meshSize(0.f, 0.f);
+            PixelDataInfo::Mirror meshMirror;
+            bool linear = false;
+            bool sampleColorProfile = false;
+            switch (filter)
+            {
+            case OpenGLImageFilter::NEAREST:
+            case OpenGLImageFilter::LINEAR:
+            {
+                meshSize = glm::vec2(info.size * proxyScale);
+                meshMirror = mirror;
+                linear = OpenGLImageFilter::LINEAR == filter;
+                sampleColorProfile = true;
+            }
+            break;
+            case OpenGLImageFilter::BOX:
+            case OpenGLImageFilter::TRIANGLE:
+            case OpenGLImageFilter::BELL:
+            case OpenGLImageFilter::BSPLINE:
+            case OpenGLImageFilter::LANCZOS3:
+            case OpenGLImageFilter::CUBIC:
+            case OpenGLImageFilter::MITCHELL:
+            {
+                if (scale.x > 0 && scale.y > 0)
+                {
+                    parallelScanlines(info.size.y, [&](int y0, int y1)
+                    {
+                        for (int y = y0; y < y1; ++y)
+                        {
+                            Pixel::F32_T * p = source.scanline(y);
+                            for (int x = 0; x < info.size.x; ++x, p += Pixel::channelsMax)
+                            {
+                                colorProfileApply(colorProfile, p);
+                            }
+                        }
+                    });
+
+                    Contrib contrib;
+                    contribInit(info.size.x, scale.x, filter, contrib);
+                    Buffer tmp;
+                    tmp.init(glm::ivec2(scale.x, info.size.y));
+                    scaleX(source, contrib, mirror, tmp);
+
+                    contribInit(info.size.y, scale.y, filter, contrib);
+                    source.init(scale);
+                    scaleY(tmp, contrib, source);
+
+                    meshSize = glm::vec2(scale);
+                    xform.scale = glm::vec2(1.f, 1.f);
+                }
+            }
+            break;
+            default: break;
+            }
+
+            // Render the output.
+            const glm::mat4x4 inverse = glm::inverse(OpenGLImageXform::xformMatrix(xform));
+            Color background(Pixel::RGB_F32);
+            ColorUtil::convert(_options.background, background);
+            const Pixel::F32_T clear[] =
+            {
+                background.f32(0),
+                background.f32(1),
+                background.f32(2),
+                initAlpha(info.pixel, outputInfo.pixel) ? 1.f : 0.f
+            };
+            const Pixel::FORMAT outputFormat = Pixel::format(outputInfo.pixel);
+            const int outputChannels = Pixel::channels(outputFormat);
+            const Pixel::PIXEL outputPixel = Pixel::pixel(outputFormat, Pixel::F32);
+            quint8 * outputP = output.data();
+            const quint64 scanlineByteCount = outputInfo.size.x * output.pixelByteCount();
+            parallelScanlines(outputInfo.size.y, [&](int y0, int y1)
+            {
+                std::vector<Pixel::F32_T> scanline(outputInfo.size.x * outputChannels);
+                for (int y = y0; y < y1; ++y)
+                {
+                    Pixel::F32_T * scanlineP = scanline.data();
+                    for (int x = 0; x < outputInfo.size.x; ++x, scanlineP += outputChannels)
+                    {
+                        Pixel::F32_T p[Pixel::channelsMax];
+                        const glm::vec4 position = inverse * glm::vec4(x + .5f, y + .5f, 0.f, 1.f);
+                        if (position.x >= 0.f && position.x < meshSize.x &&
+                            position.y >= 0.f && position.y < meshSize.y)
+                        {
+                            float u = position.x / meshSize.x;
+                            float v = position.y / meshSize.y;
+                            if (meshMirror.x)
+                            {
+                                u = 1.f - u;
+                            }
+                            if (meshMirror.y)
+                            {
+                                v = 1.f - v;
+                            }
+                            if (linear)
+                            {
+                                sampleLinear(source, u, v, p);
+                            }
+                            else
+                            {
+                                sampleNearest(source, u, v, p);
+                            }
+                            if (sampleColorProfile)
+                            {
+                                colorProfileApply(colorProfile, p);
+                            }
+                            displayProfileApply(displayProfile, p);
+                            if (_options.channel)
+                            {
+                                const Pixel::F32_T value = p[_options.channel - 1];
+                                p[0] = p[1] = p[2] = p[3] = value;
+                            }
+                            switch (outputFormat)
+                            {
+                            case Pixel::L:  p[1] = p[2] = p[3] = p[0]; break;
+                            case Pixel::LA: p[1] = p[2] = p[3]; break;
+                            default: break;
+                            }
+                        }
+                        else
+                        {
+                            p[0] = clear[0];
+                            p[1] = clear[1];
+                            p[2] = clear[2];
+                            p[3] = clear[3];
+                        }
+                        for (int c = 0; c < outputChannels; ++c)
+                        {
+                            scanlineP[c] = p[c];
+                        }
+                    }
+                    writeScanline(scanline.data(), outputPixel, outputInfo, outputP + y * scanlineByteCount);
+                }
+            });
+        }
+
+    } // namespace Graphics
+} // namespace djv
@@ -111,8 +111,7 @@ namespace djv
             const PixelData * p = &in;
             if (in.info() != _image.info())
             {
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
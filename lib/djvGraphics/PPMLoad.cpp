@@ -86,8 +86,11 @@ namespace djv
                         PPM::staticName,
                         ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                 }
-                data->set(info, io->mmapP(), io.data());
-                io.take();
+                if (!mapPixelData(*data, info, io))
+                {
+                    data->set(info);
+                    io->get(data->data(), PixelDataUtil::dataByteCount(info));
+                }
             }
             else
             {
@@ -131,6 +134,7 @@ namespace djv
                 info.proxy = frame.proxy;
                 image.set(info);
                 PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                _tmp.close();
             }
 
             //DJV_DEBUG_PRINT("image = " << image);
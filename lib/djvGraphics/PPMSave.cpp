@@ -115,8 +115,7 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
@@ -168,6 +167,8 @@ namespace djv
                     }
                 }
             }
+
+            io.close();
         }
 
         void PPMSave::_open(const QString & in, Core::FileIO & io)
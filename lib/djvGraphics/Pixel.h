@@ -285,6 +285,29 @@ namespace djv
                 int          size = 1,
                 int          stride = 1,
                 bool         bgr = false);
+
+            //! This enumeration provides the SIMD instruction sets used to convert
+            //! pixel data.
+            enum SIMD
+            {
+                SIMD_NONE,  //!< Scalar code
+                SIMD_SSE4,  //!< SSE4.1
+                SIMD_AVX2,  //!< AVX2 and F16C
+
+                SIMD_COUNT
+            };
+            Q_ENUM(SIMD);
+
+            //! Get the best SIMD instruction set supported by the CPU.
+            static SIMD cpuSIMD();
+
+            //! Get the SIMD instruction set used to convert pixel data. This
+            //! defaults to the best instruction set supported by the CPU.
+            static SIMD convertSIMD();
+
+            //! Set the SIMD instruction set used to convert pixel data. The value
+            //! is limited to the instruction sets supported by the CPU.
+            static void setConvertSIMD(SIMD);
         };
 
     } // namespace Graphics
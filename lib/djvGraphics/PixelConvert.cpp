@@ -31,6 +31,20 @@
 
 #include <djvCore/Memory.h>
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DJV_PIXEL_SIMD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else // _MSC_VER
+#include <cpuid.h>
+#endif // _MSC_VER
+#include <immintrin.h>
+#endif
+
 namespace djv
 {
     namespace Graphics
@@ -157,8 +171,25 @@ namespace djv
 
             typedef void (Fnc)(_FNC_ARGS);
 
+// The bgr flag is a template parameter so that it is not tested for every
+// pixel.
+#define _FNC_BGR(NAME) \
+    void NAME(_FNC_ARGS) \
+    { \
+        if (bgr) \
+        { \
+            NAME##_<true>(in, out, size, stride); \
+        } \
+        else \
+        { \
+            NAME##_<false>(in, out, size, stride); \
+        } \
+    }
+
 #define _FNC(IN_FORMAT, IN_TYPE, OUT_FORMAT, OUT_TYPE) \
-    void _##IN_FORMAT##_##IN_TYPE##_##OUT_FORMAT##_##OUT_TYPE(_FNC_ARGS) \
+    template<bool bgr> \
+    void _##IN_FORMAT##_##IN_TYPE##_##OUT_FORMAT##_##OUT_TYPE##_( \
+        const void * in, void * out, int size, int stride) \
     { \
         const Pixel::IN_TYPE##_T * inP = reinterpret_cast<const Pixel::IN_TYPE##_T *>(in); \
         Pixel::OUT_TYPE##_T * outP = reinterpret_cast<Pixel::OUT_TYPE##_T *>(out); \
@@ -168,7 +199,8 @@ namespace djv
         { \
             _##IN_FORMAT##_##OUT_FORMAT(inP, IN_TYPE, outP, OUT_TYPE) \
         } \
-    }
+    } \
+    _FNC_BGR(_##IN_FORMAT##_##IN_TYPE##_##OUT_FORMAT##_##OUT_TYPE)
 
 #define _FNC_DEFINE(OUT_FORMAT, OUT_TYPE) \
     _FNC(L, U8, OUT_FORMAT, OUT_TYPE) \
@@ -205,15 +237,23 @@ namespace djv
             _FNC_DEFINE(RGBA, F16)
             _FNC_DEFINE(RGBA, F32)
 
-            void _RGB_U10_RGB_U10(_FNC_ARGS)
+            template<bool bgr>
+            void _RGB_U10_RGB_U10_(const void * in, void * out, int size, int stride)
             {
                 const Pixel::U10_S * inP = reinterpret_cast<const Pixel::U10_S *>(in);
                 Pixel::U10_S * outP = reinterpret_cast<Pixel::U10_S *>(out);
-                _RGB_RGB_(inP->r, inP->g, inP->b, U10, outP->r, outP->g, outP->b, U10);
+                for (int i = 0; i < size; ++i, inP += stride, ++outP)
+                {
+                    _RGB_RGB_(bgr ? inP->b : inP->r, inP->g, bgr ? inP->r : inP->b, U10,
+                        outP->r, outP->g, outP->b, U10);
+                }
             }
+            _FNC_BGR(_RGB_U10_RGB_U10)
 
 #define _FNC_RGB_U10(OUT_FORMAT, OUT_TYPE) \
-    void _RGB_U10_##OUT_FORMAT##_##OUT_TYPE(_FNC_ARGS) \
+    template<bool bgr> \
+    void _RGB_U10_##OUT_FORMAT##_##OUT_TYPE##_( \
+        const void * in, void * out, int size, int stride) \
     { \
         const Pixel::U10_S * inP = reinterpret_cast<const Pixel::U10_S *>(in); \
         Pixel::OUT_TYPE##_T * outP = reinterpret_cast<Pixel::OUT_TYPE##_T *>(out); \
@@ -223,7 +263,8 @@ namespace djv
         { \
             _RGB_U10_##OUT_FORMAT(inP, U10, outP, OUT_TYPE) \
         } \
-    }
+    } \
+    _FNC_BGR(_RGB_U10_##OUT_FORMAT##_##OUT_TYPE)
 
             _FNC_RGB_U10(L, U8)
             _FNC_RGB_U10(L, U16)
@@ -243,7 +284,9 @@ namespace djv
             _FNC_RGB_U10(RGBA, F32)
 
 #define _FNC2_RGB_U10(IN_FORMAT, IN_TYPE) \
-    void _##IN_FORMAT##_##IN_TYPE##_RGB_U10(_FNC_ARGS) \
+    template<bool bgr> \
+    void _##IN_FORMAT##_##IN_TYPE##_RGB_U10_( \
+        const void * in, void * out, int size, int stride) \
     { \
         const Pixel::IN_TYPE##_T * inP = reinterpret_cast<const Pixel::IN_TYPE##_T *>(in); \
         Pixel::U10_S * outP = reinterpret_cast<Pixel::U10_S *>(out); \
@@ -252,7 +295,8 @@ namespace djv
         { \
             _##IN_FORMAT##_RGB_U10(inP, IN_TYPE, outP, U10) \
         } \
-    }
+    } \
+    _FNC_BGR(_##IN_FORMAT##_##IN_TYPE##_RGB_U10)
 
             _FNC2_RGB_U10(L, U8)
             _FNC2_RGB_U10(L, U16)
@@ -314,8 +358,936 @@ namespace djv
                 _FNC_TABLE(RGBA_F32)
             };
 
+#if defined(DJV_PIXEL_SIMD)
+
+            void cpuid(int info[4], int leaf)
+            {
+#if defined(_MSC_VER)
+                __cpuidex(info, leaf, 0);
+#else // _MSC_VER
+                unsigned int a = 0, b = 0, c = 0, d = 0;
+                __cpuid_count(leaf, 0, a, b, c, d);
+                info[0] = static_cast<int>(a);
+                info[1] = static_cast<int>(b);
+                info[2] = static_cast<int>(c);
+                info[3] = static_cast<int>(d);
+#endif // _MSC_VER
+            }
+
+            quint64 xgetbv()
+            {
+#if defined(_MSC_VER)
+                return _xgetbv(0);
+#else // _MSC_VER
+                quint32 a = 0, d = 0;
+                __asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+                return (static_cast<quint64>(d) << 32) | a;
+#endif // _MSC_VER
+            }
+
+            //! This struct provides information about a pixel type.
+            template<Pixel::TYPE>
+            struct Type;
+
+#define _TYPE(TYPE, MAX, BITS, INTEGER) \
+    template<> \
+    struct Type<Pixel::TYPE> \
+    { \
+        typedef Pixel::TYPE##_T T; \
+        static const int  max     = MAX; \
+        static const int  bits    = BITS; \
+        static const bool integer = INTEGER; \
+    };
+
+            _TYPE(U8, Pixel::u8Max, 8, true)
+            _TYPE(U10, Pixel::u10Max, 10, true)
+            _TYPE(U16, Pixel::u16Max, 16, true)
+            _TYPE(F16, 1, 16, false)
+            _TYPE(F32, 1, 32, false)
+
+            //! Convert a value with the scalar code.
+            template<Pixel::TYPE IN, Pixel::TYPE OUT>
+            inline typename Type<OUT>::T value(typename Type<IN>::T);
+
+#define _VALUE(IN_TYPE, OUT_TYPE) \
+    template<> \
+    inline Pixel::OUT_TYPE##_T value<Pixel::IN_TYPE, Pixel::OUT_TYPE>(Pixel::IN_TYPE##_T in) \
+    { \
+        return PIXEL_##IN_TYPE##_TO_##OUT_TYPE(in); \
+    }
+
+            _VALUE(U8, U10)
+            _VALUE(U8, U16)
+            _VALUE(U8, F16)
+            _VALUE(U8, F32)
+            _VALUE(U10, U8)
+            _VALUE(U10, U16)
+            _VALUE(U10, F16)
+            _VALUE(U10, F32)
+            _VALUE(U16, U8)
+            _VALUE(U16, U10)
+            _VALUE(U16, F16)
+            _VALUE(U16, F32)
+            _VALUE(F16, U8)
+            _VALUE(F16, U10)
+            _VALUE(F16, U16)
+            _VALUE(F16, F32)
+            _VALUE(F32, U8)
+            _VALUE(F32, U10)
+            _VALUE(F32, U16)
+            _VALUE(F32, F16)
+
+            //! This enumeration provides the kinds of type conversions. Each kind
+            //! reproduces the arithmetic of the scalar code exactly.
+            enum CATEGORY
+            {
+                DOWN,           //!< Integer to a smaller integer with a bit shift
+                UP,             //!< Integer to a larger integer with the LUT formula
+                INT_TO_FLOAT,   //!< Integer to floating point
+                FLOAT_TO_INT,   //!< Floating point to integer with rounding
+                FLOAT_TO_FLOAT  //!< Floating point to floating point
+            };
+
+            template<Pixel::TYPE IN, Pixel::TYPE OUT>
+            struct Category
+            {
+                static const int value =
+                    Type<IN>::integer ?
+                    (Type<OUT>::integer ?
+                        (Type<IN>::bits > Type<OUT>::bits ? DOWN : UP) :
+                        INT_TO_FLOAT) :
+                    (Type<OUT>::integer ? FLOAT_TO_INT : FLOAT_TO_FLOAT);
+            };
+
+            template<int>
+            struct CategoryTag
+            {};
+
+#if defined(__GNUC__)
+#define _TARGET_SSE4 __attribute__((target("ssse3,sse4.1")))
+#define _TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#else // __GNUC__
+#define _TARGET_SSE4
+#define _TARGET_AVX2
+#endif // __GNUC__
+
+// The type conversion kernels are the same for each instruction set, only the
+// vector operations differ.
+#define _TYPE_KERNELS(TARGET) \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET inline void lanes(const typename Type<IN>::T * in, typename Type<OUT>::T * out, CategoryTag<DOWN>) \
+    { \
+        storeI16(out, srli16(loadI16(in), Type<IN>::bits - Type<OUT>::bits)); \
+    } \
+    \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET inline void lanes(const typename Type<IN>::T * in, typename Type<OUT>::T * out, CategoryTag<UP>) \
+    { \
+        storeI(out, truncate(mul(div(loadF(in), static_cast<float>(Type<IN>::max)), static_cast<float>(Type<OUT>::max)))); \
+    } \
+    \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET inline void lanes(const typename Type<IN>::T * in, typename Type<OUT>::T * out, CategoryTag<INT_TO_FLOAT>) \
+    { \
+        storeF(out, div(loadF(in), static_cast<float>(Type<IN>::max))); \
+    } \
+    \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET inline void lanes(const typename Type<IN>::T * in, typename Type<OUT>::T * out, CategoryTag<FLOAT_TO_INT>) \
+    { \
+        storeI(out, roundClamp(mul(loadF(in), static_cast<float>(Type<OUT>::max)), Type<OUT>::max)); \
+    } \
+    \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET inline void lanes(const typename Type<IN>::T * in, typename Type<OUT>::T * out, CategoryTag<FLOAT_TO_FLOAT>) \
+    { \
+        storeF(out, loadF(in)); \
+    } \
+    \
+    template<Pixel::TYPE IN, Pixel::TYPE OUT> \
+    TARGET void type(const void * in, void * out, int size) \
+    { \
+        const typename Type<IN>::T * inP = reinterpret_cast<const typename Type<IN>::T *>(in); \
+        typename Type<OUT>::T * outP = reinterpret_cast<typename Type<OUT>::T *>(out); \
+        int i = 0; \
+        for (; i <= size - laneCount; i += laneCount) \
+        { \
+            lanes<IN, OUT>(inP + i, outP + i, CategoryTag<Category<IN, OUT>::value>()); \
+        } \
+        for (; i < size; ++i) \
+        { \
+            outP[i] = value<IN, OUT>(inP[i]); \
+        } \
+    }
+
+            namespace sse4
+            {
+                const int laneCount = 4;
+
+                _TARGET_SSE4 inline __m128i loadI(const quint8 * in)
+                {
+                    qint32 tmp = 0;
+                    memcpy(&tmp, in, 4);
+                    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(tmp));
+                }
+
+                _TARGET_SSE4 inline __m128i loadI(const quint16 * in)
+                {
+                    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+                }
+
+                _TARGET_SSE4 inline __m128 loadF(const quint8 * in)
+                {
+                    return _mm_cvtepi32_ps(loadI(in));
+                }
+
+                _TARGET_SSE4 inline __m128 loadF(const quint16 * in)
+                {
+                    return _mm_cvtepi32_ps(loadI(in));
+                }
+
+                _TARGET_SSE4 inline __m128 loadF(const float * in)
+                {
+                    return _mm_loadu_ps(in);
+                }
+
+                _TARGET_SSE4 inline void storeI(quint8 * out, __m128i value)
+                {
+                    value = _mm_packus_epi32(value, value);
+                    const qint32 tmp = _mm_cvtsi128_si32(_mm_packus_epi16(value, value));
+                    memcpy(out, &tmp, 4);
+                }
+
+                _TARGET_SSE4 inline void storeI(quint16 * out, __m128i value)
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi32(value, value));
+                }
+
+                _TARGET_SSE4 inline void storeF(float * out, __m128 value)
+                {
+                    _mm_storeu_ps(out, value);
+                }
+
+                _TARGET_SSE4 inline __m128i loadI16(const quint16 * in)
+                {
+                    return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+                }
+
+                _TARGET_SSE4 inline void storeI16(quint8 * out, __m128i value)
+                {
+                    const qint32 tmp = _mm_cvtsi128_si32(_mm_packus_epi16(value, value));
+                    memcpy(out, &tmp, 4);
+                }
+
+                _TARGET_SSE4 inline void storeI16(quint16 * out, __m128i value)
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), value);
+                }
+
+                _TARGET_SSE4 inline __m128i srli16(__m128i value, int count)
+                {
+                    return _mm_srli_epi16(value, count);
+                }
+
+                _TARGET_SSE4 inline __m128 mul(__m128 value, float scale)
+                {
+                    return _mm_mul_ps(value, _mm_set1_ps(scale));
+                }
+
+                _TARGET_SSE4 inline __m128 div(__m128 value, float scale)
+                {
+                    return _mm_div_ps(value, _mm_set1_ps(scale));
+                }
+
+                _TARGET_SSE4 inline __m128i truncate(__m128 value)
+                {
+                    return _mm_cvttps_epi32(value);
+                }
+
+                // The scalar code adds 0.5 in double precision before truncating.
+                // Adding 0.5 in single precision can round up, so instead the
+                // fraction is compared against 0.5 which gives identical results.
+                _TARGET_SSE4 inline __m128i roundClamp(__m128 value, int max)
+                {
+                    const __m128 floor = _mm_floor_ps(value);
+                    const __m128i up = _mm_and_si128(
+                        _mm_castps_si128(_mm_cmpge_ps(_mm_sub_ps(value, floor), _mm_set1_ps(.5f))),
+                        _mm_set1_epi32(1));
+                    return _mm_min_epi32(
+                        _mm_max_epi32(_mm_add_epi32(_mm_cvttps_epi32(floor), up), _mm_setzero_si128()),
+                        _mm_set1_epi32(max));
+                }
+
+                _TYPE_KERNELS(_TARGET_SSE4)
+
+            } // namespace sse4
+
+            namespace avx2
+            {
+                const int laneCount = 8;
+
+                _TARGET_AVX2 inline __m256i loadI(const quint8 * in)
+                {
+                    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+                }
+
+                _TARGET_AVX2 inline __m256i loadI(const quint16 * in)
+                {
+                    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+                }
+
+                _TARGET_AVX2 inline __m256 loadF(const quint8 * in)
+                {
+                    return _mm256_cvtepi32_ps(loadI(in));
+                }
+
+                _TARGET_AVX2 inline __m256 loadF(const quint16 * in)
+                {
+                    return _mm256_cvtepi32_ps(loadI(in));
+                }
+
+                _TARGET_AVX2 inline __m256 loadF(const Pixel::F16_T * in)
+                {
+                    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+                }
+
+                _TARGET_AVX2 inline __m256 loadF(const float * in)
+                {
+                    return _mm256_loadu_ps(in);
+                }
+
+                _TARGET_AVX2 inline void storeI(quint8 * out, __m256i value)
+                {
+                    const __m128i tmp = _mm_packus_epi32(
+                        _mm256_castsi256_si128(value),
+                        _mm256_extracti128_si256(value, 1));
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(tmp, tmp));
+                }
+
+                _TARGET_AVX2 inline void storeI(quint16 * out, __m256i value)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(out),
+                        _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1)));
+                }
+
+                _TARGET_AVX2 inline void storeF(Pixel::F16_T * out, __m256 value)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(out),
+                        _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+                }
+
+                _TARGET_AVX2 inline void storeF(float * out, __m256 value)
+                {
+                    _mm256_storeu_ps(out, value);
+                }
+
+                _TARGET_AVX2 inline __m128i loadI16(const quint16 * in)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                }
+
+                _TARGET_AVX2 inline void storeI16(quint8 * out, __m128i value)
+                {
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(value, value));
+                }
+
+                _TARGET_AVX2 inline void storeI16(quint16 * out, __m128i value)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), value);
+                }
+
+                _TARGET_AVX2 inline __m128i srli16(__m128i value, int count)
+                {
+                    return _mm_srli_epi16(value, count);
+                }
+
+                _TARGET_AVX2 inline __m256 mul(__m256 value, float scale)
+                {
+                    return _mm256_mul_ps(value, _mm256_set1_ps(scale));
+                }
+
+                _TARGET_AVX2 inline __m256 div(__m256 value, float scale)
+                {
+                    return _mm256_div_ps(value, _mm256_set1_ps(scale));
+                }
+
+                _TARGET_AVX2 inline __m256i truncate(__m256 value)
+                {
+                    return _mm256_cvttps_epi32(value);
+                }
+
+                _TARGET_AVX2 inline __m256i roundClamp(__m256 value, int max)
+                {
+                    const __m256 floor = _mm256_floor_ps(value);
+                    const __m256i up = _mm256_and_si256(
+                        _mm256_castps_si256(_mm256_cmp_ps(_mm256_sub_ps(value, floor), _mm256_set1_ps(.5f), _CMP_GE_OQ)),
+                        _mm256_set1_epi32(1));
+                    return _mm256_min_epi32(
+                        _mm256_max_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(floor), up), _mm256_setzero_si256()),
+                        _mm256_set1_epi32(max));
+                }
+
+                _TYPE_KERNELS(_TARGET_AVX2)
+
+            } // namespace avx2
+
+            typedef void (TypeFnc)(const void *, void *, int);
+
+            //! This struct provides the type conversion kernels for each
+            //! instruction set. Conversions without a kernel use the scalar code.
+            struct TypeFncs
+            {
+                TypeFncs()
+                {
+                    for (int i = 0; i < Pixel::SIMD_COUNT; ++i)
+                        for (int j = 0; j < Pixel::TYPE_COUNT; ++j)
+                            for (int k = 0; k < Pixel::TYPE_COUNT; ++k)
+                                data[i][j][k] = nullptr;
+
+#define _TYPE_FNC(SIMD, NAMESPACE, IN_TYPE, OUT_TYPE) \
+    data[Pixel::SIMD][Pixel::IN_TYPE][Pixel::OUT_TYPE] = NAMESPACE::type<Pixel::IN_TYPE, Pixel::OUT_TYPE>;
+
+                    // SSE4 does not have instructions for 16-bit floating point.
+                    _TYPE_FNC(SIMD_SSE4, sse4, U8, U10)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U8, U16)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U8, F32)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U10, U8)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U10, U16)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U10, F32)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U16, U8)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U16, U10)
+                    _TYPE_FNC(SIMD_SSE4, sse4, U16, F32)
+                    _TYPE_FNC(SIMD_SSE4, sse4, F32, U8)
+                    _TYPE_FNC(SIMD_SSE4, sse4, F32, U10)
+                    _TYPE_FNC(SIMD_SSE4, sse4, F32, U16)
+
+                    _TYPE_FNC(SIMD_AVX2, avx2, U8, U10)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U8, U16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U8, F16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U8, F32)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U10, U8)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U10, U16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U10, F16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U10, F32)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U16, U8)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U16, U10)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U16, F16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, U16, F32)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F16, U8)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F16, U10)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F16, U16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F16, F32)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F32, U8)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F32, U10)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F32, U16)
+                    _TYPE_FNC(SIMD_AVX2, avx2, F32, F16)
+                }
+
+                TypeFnc * data[Pixel::SIMD_COUNT][Pixel::TYPE_COUNT][Pixel::TYPE_COUNT];
+            };
+
+            const TypeFncs & typeFncs()
+            {
+                static const TypeFncs data;
+                return data;
+            }
+
+            //! Get a shuffle mask from a list of 16-bit indices, where -1 clears
+            //! the value.
+            _TARGET_SSE4 inline __m128i shuffle16(const int (&indices)[8])
+            {
+                qint8 tmp[16];
+                for (int i = 0; i < 8; ++i)
+                {
+                    tmp[i * 2]     = indices[i] < 0 ? -128 : static_cast<qint8>(indices[i] * 2);
+                    tmp[i * 2 + 1] = indices[i] < 0 ? -128 : static_cast<qint8>(indices[i] * 2 + 1);
+                }
+                return _mm_loadu_si128(reinterpret_cast<const __m128i *>(tmp));
+            }
+
+            //! Get a shuffle mask that moves 16-bit values into 32-bit lanes, where
+            //! -1 clears the lane.
+            _TARGET_SSE4 inline __m128i shuffle32(const int (&indices)[4])
+            {
+                const int tmp[8] =
+                {
+                    indices[0], -1,
+                    indices[1], -1,
+                    indices[2], -1,
+                    indices[3], -1
+                };
+                return shuffle16(tmp);
+            }
+
+            //! Unpack 10-bit data into three 16-bit values per pixel.
+            _TARGET_SSE4 void unpackU10(const void * in, quint16 * out, int size, bool bgr)
+            {
+                const __m128i mask = _mm_set1_epi32(0x3ff);
+                const __m128i m0 = shuffle16({ 0, 4, -1, 1, 5, -1, 2, 6 });
+                const __m128i m1 = shuffle16({ -1, -1, 0, -1, -1, 1, -1, -1 });
+                const __m128i m2 = shuffle16({ -1, 3, 7, -1, -1, -1, -1, -1 });
+                const __m128i m3 = shuffle16({ 2, -1, -1, 3, -1, -1, -1, -1 });
+                const quint32 * inP = reinterpret_cast<const quint32 *>(in);
+                int i = 0;
+                for (; i <= size - 4; i += 4, inP += 4, out += 12)
+                {
+                    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP));
+                    __m128i r = _mm_srli_epi32(value, 22);
+                    const __m128i g = _mm_and_si128(_mm_srli_epi32(value, 12), mask);
+                    __m128i b = _mm_and_si128(_mm_srli_epi32(value, 2), mask);
+                    if (bgr)
+                    {
+                        std::swap(r, b);
+                    }
+                    const __m128i rg = _mm_packus_epi32(r, g);
+                    const __m128i bb = _mm_packus_epi32(b, b);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(out),
+                        _mm_or_si128(_mm_shuffle_epi8(rg, m0), _mm_shuffle_epi8(bb, m1)));
+                    _mm_storel_epi64(
+                        reinterpret_cast<__m128i *>(out + 8),
+                        _mm_or_si128(_mm_shuffle_epi8(rg, m2), _mm_shuffle_epi8(bb, m3)));
+                }
+                const Pixel::U10_S * p = reinterpret_cast<const Pixel::U10_S *>(inP);
+                for (; i < size; ++i, ++p, out += 3)
+                {
+                    out[0] = bgr ? p->b : p->r;
+                    out[1] = p->g;
+                    out[2] = bgr ? p->r : p->b;
+                }
+            }
+
+            //! Pack three 16-bit values per pixel into 10-bit data.
+            _TARGET_SSE4 void packU10(const quint16 * in, void * out, int size)
+            {
+                const __m128i r0 = shuffle32({ 0, 3, 6, -1 });
+                const __m128i r1 = shuffle32({ -1, -1, -1, 1 });
+                const __m128i g0 = shuffle32({ 1, 4, 7, -1 });
+                const __m128i g1 = shuffle32({ -1, -1, -1, 2 });
+                const __m128i b0 = shuffle32({ 2, 5, -1, -1 });
+                const __m128i b1 = shuffle32({ -1, -1, 0, 3 });
+                quint32 * outP = reinterpret_cast<quint32 *>(out);
+                int i = 0;
+                for (; i <= size - 4; i += 4, in += 12, outP += 4)
+                {
+                    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                    const __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + 8));
+                    const __m128i r = _mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1));
+                    const __m128i g = _mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1));
+                    const __m128i b = _mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP),
+                        _mm_or_si128(
+                            _mm_or_si128(_mm_slli_epi32(r, 22), _mm_slli_epi32(g, 12)),
+                            _mm_slli_epi32(b, 2)));
+                }
+                Pixel::U10_S * p = reinterpret_cast<Pixel::U10_S *>(outP);
+                for (; i < size; ++i, in += 3, ++p)
+                {
+                    p->r = in[0];
+                    p->g = in[1];
+                    p->b = in[2];
+                    p->pad = 0;
+                }
+            }
+
+            template<typename T>
+            void formatScalar(const T * in, int inChannels, T * out, int outChannels, int size, bool bgr, T one)
+            {
+                const int r = bgr ? 2 : 0;
+                const int b = bgr ? 0 : 2;
+                for (int i = 0; i < size; ++i, in += inChannels, out += outChannels)
+                {
+                    out[0] = in[r];
+                    out[1] = in[1];
+                    out[2] = in[b];
+                    if (4 == outChannels)
+                    {
+                        out[3] = 4 == inChannels ? in[3] : one;
+                    }
+                }
+            }
+
+            //! This struct provides the shuffle masks for converting between RGB
+            //! and RGBA with 8-bit and 16-bit channels. Each shuffle converts
+            //! twelve bytes of RGB data to sixteen bytes of RGBA data or the
+            //! other way around.
+            struct FormatMasks
+            {
+                FormatMasks()
+                {
+                    for (int e = 0; e < 2; ++e)
+                    {
+                        const int byteCount = e + 1;
+                        const int pixels = 4 / byteCount;
+                        for (int inAlpha = 0; inAlpha < 2; ++inAlpha)
+                        {
+                            const int inChannels = inAlpha ? 4 : 3;
+                            for (int outAlpha = 0; outAlpha < 2; ++outAlpha)
+                            {
+                                const int outChannels = outAlpha ? 4 : 3;
+                                for (int bgr = 0; bgr < 2; ++bgr)
+                                {
+                                    qint8 * p = data[e][inAlpha][outAlpha][bgr];
+                                    for (int i = 0; i < 16; ++i)
+                                    {
+                                        const int pixel = i / (outChannels * byteCount);
+                                        const int c = (i / byteCount) % outChannels;
+                                        const int byte = i % byteCount;
+                                        if (pixel >= pixels || (3 == c && 3 == inChannels))
+                                        {
+                                            p[i] = -128;
+                                        }
+                                        else
+                                        {
+                                            const int channel = bgr && c != 1 && c != 3 ? 2 - c : c;
+                                            p[i] = static_cast<qint8>(
+                                                (pixel * inChannels + channel) * byteCount + byte);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
+                qint8 data[2][2][2][2][16];
+            };
+
+            const FormatMasks & formatMasks()
+            {
+                static const FormatMasks data;
+                return data;
+            }
+
+            template<typename T>
+            _TARGET_SSE4 void formatShuffle(const T * in, int inChannels, T * out, int outChannels, int size, bool bgr, T one)
+            {
+                const int byteCount = static_cast<int>(sizeof(T));
+                const int pixels = 4 / byteCount;
+                const int inByteCount = inChannels * byteCount;
+                const int outByteCount = outChannels * byteCount;
+                const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                    formatMasks().data[byteCount - 1][4 == inChannels][4 == outChannels][bgr]));
+                const __m128i alpha = 3 == inChannels && 4 == outChannels ?
+                    (1 == byteCount ?
+                        _mm_set1_epi32(static_cast<int>(static_cast<quint32>(one) << 24)) :
+                        _mm_set1_epi64x(static_cast<qint64>(static_cast<quint64>(one) << 48))) :
+                    _mm_setzero_si128();
+                const quint8 * inP = reinterpret_cast<const quint8 *>(in);
+                quint8 * outP = reinterpret_cast<quint8 *>(out);
+                int i = 0;
+                for (;
+                    i + pixels <= size && (size - i) * inByteCount >= 16;
+                    i += pixels, inP += pixels * inByteCount, outP += pixels * outByteCount)
+                {
+                    const __m128i value = _mm_or_si128(
+                        _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(inP)), mask),
+                        alpha);
+                    if (4 == outChannels)
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(outP), value);
+                    }
+                    else
+                    {
+                        _mm_storel_epi64(reinterpret_cast<__m128i *>(outP), value);
+                        const qint32 tmp = _mm_cvtsi128_si32(_mm_srli_si128(value, 8));
+                        memcpy(outP + 8, &tmp, 4);
+                    }
+                }
+                formatScalar(
+                    reinterpret_cast<const T *>(inP),
+                    inChannels,
+                    reinterpret_cast<T *>(outP),
+                    outChannels,
+                    size - i,
+                    bgr,
+                    one);
+            }
+
+            _TARGET_SSE4 inline __m128 swapRB(__m128 value)
+            {
+                return _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+            }
+
+            //! Load four RGB pixels into four vectors.
+            _TARGET_SSE4 inline void loadRGB(const float * in, __m128 * out)
+            {
+                const __m128i a = _mm_castps_si128(_mm_loadu_ps(in));
+                const __m128i b = _mm_castps_si128(_mm_loadu_ps(in + 4));
+                const __m128i c = _mm_castps_si128(_mm_loadu_ps(in + 8));
+                out[0] = _mm_castsi128_ps(a);
+                out[1] = _mm_castsi128_ps(_mm_alignr_epi8(b, a, 12));
+                out[2] = _mm_castsi128_ps(_mm_alignr_epi8(c, b, 8));
+                out[3] = _mm_castsi128_ps(_mm_srli_si128(c, 4));
+            }
+
+            //! Store four vectors as four RGB pixels.
+            _TARGET_SSE4 inline void storeRGB(const __m128 * in, float * out)
+            {
+                _mm_storeu_ps(out, _mm_blend_ps(in[0], _mm_shuffle_ps(in[1], in[1], 0), 8));
+                _mm_storeu_ps(out + 4, _mm_shuffle_ps(in[1], in[2], _MM_SHUFFLE(1, 0, 2, 1)));
+                _mm_storeu_ps(out + 8, _mm_blend_ps(
+                    _mm_shuffle_ps(in[3], in[3], _MM_SHUFFLE(2, 1, 0, 0)),
+                    _mm_shuffle_ps(in[2], in[2], _MM_SHUFFLE(2, 2, 2, 2)),
+                    1));
+            }
+
+            template<int inChannels, int outChannels, bool bgr>
+            _TARGET_SSE4 void formatFloat(const float * in, float * out, int size)
+            {
+                const __m128 one = _mm_set1_ps(1.f);
+                int i = 0;
+                for (; i <= size - 4; i += 4, in += 4 * inChannels, out += 4 * outChannels)
+                {
+                    __m128 p[4];
+                    if (3 == inChannels)
+                    {
+                        loadRGB(in, p);
+                    }
+                    else
+                    {
+                        for (int j = 0; j < 4; ++j)
+                        {
+                            p[j] = _mm_loadu_ps(in + j * 4);
+                        }
+                    }
+                    if (bgr)
+                    {
+                        for (int j = 0; j < 4; ++j)
+                        {
+                            p[j] = swapRB(p[j]);
+                        }
+                    }
+                    if (3 == outChannels)
+                    {
+                        storeRGB(p, out);
+                    }
+                    else
+                    {
+                        for (int j = 0; j < 4; ++j)
+                        {
+                            _mm_storeu_ps(out + j * 4, 3 == inChannels ? _mm_blend_ps(p[j], one, 8) : p[j]);
+                        }
+                    }
+                }
+                formatScalar(in, inChannels, out, outChannels, size - i, bgr, 1.f);
+            }
+
+            //! Convert between RGB and RGBA, optionally swapping the red and blue
+            //! channels.
+            void format(const void * in, int inChannels, void * out, int outChannels, int size, bool bgr, Pixel::TYPE type)
+            {
+                switch (type)
+                {
+                case Pixel::U8:
+                    formatShuffle(
+                        reinterpret_cast<const quint8 *>(in), inChannels,
+                        reinterpret_cast<quint8 *>(out), outChannels,
+                        size, bgr, static_cast<quint8>(Pixel::u8Max));
+                    break;
+                case Pixel::U10:
+                case Pixel::U16:
+                case Pixel::F16:
+                {
+                    const quint16 one =
+                        Pixel::U10 == type ? Pixel::u10Max :
+                        (Pixel::U16 == type ? Pixel::u16Max : Pixel::F16_T(1.f).bits());
+                    formatShuffle(
+                        reinterpret_cast<const quint16 *>(in), inChannels,
+                        reinterpret_cast<quint16 *>(out), outChannels,
+                        size, bgr, one);
+                    break;
+                }
+                case Pixel::F32:
+                {
+                    const float * inP = reinterpret_cast<const float *>(in);
+                    float * outP = reinterpret_cast<float *>(out);
+                    switch ((4 == inChannels ? 4 : 0) + (4 == outChannels ? 2 : 0) + (bgr ? 1 : 0))
+                    {
+                    case 0: formatFloat<3, 3, false>(inP, outP, size); break;
+                    case 1: formatFloat<3, 3, true >(inP, outP, size); break;
+                    case 2: formatFloat<3, 4, false>(inP, outP, size); break;
+                    case 3: formatFloat<3, 4, true >(inP, outP, size); break;
+                    case 4: formatFloat<4, 3, false>(inP, outP, size); break;
+                    case 5: formatFloat<4, 3, true >(inP, outP, size); break;
+                    case 6: formatFloat<4, 4, false>(inP, outP, size); break;
+                    case 7: formatFloat<4, 4, true >(inP, outP, size); break;
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+
+            //! The minimum number of pixels to use the SIMD code.
+            const int simdSizeMin = 16;
+
+            //! The number of pixels that are converted at a time.
+            const int simdChunk = 256;
+
+            //! Get the number of bytes used to store a channel in the SIMD code.
+            int storageByteCount(Pixel::TYPE type)
+            {
+                switch (type)
+                {
+                case Pixel::U8:  return 1;
+                case Pixel::F32: return 4;
+                default: break;
+                }
+                return 2;
+            }
+
+            //! Convert pixel data with SIMD instructions. The conversion is split
+            //! into stages; unpacking 10-bit data, converting the format,
+            //! converting the type, and packing 10-bit data. The format is
+            //! converted on whichever side of the type conversion has the smaller
+            //! channels. Each stage works on a chunk of pixels that fits in the
+            //! cache. If the conversion is not supported false is returned and the
+            //! scalar code is used instead.
+            bool simdConvert(
+                Pixel::SIMD  simd,
+                const void * in,
+                Pixel::PIXEL inPixel,
+                void *       out,
+                Pixel::PIXEL outPixel,
+                int          size,
+                bool         bgr)
+            {
+                const Pixel::FORMAT inFormat  = Pixel::format(inPixel);
+                const Pixel::FORMAT outFormat = Pixel::format(outPixel);
+                const Pixel::TYPE   inType    = Pixel::type(inPixel);
+                const Pixel::TYPE   outType   = Pixel::type(outPixel);
+                const bool rgb = inFormat >= Pixel::RGB && outFormat >= Pixel::RGB;
+                if (inFormat != outFormat && !rgb)
+                    return false;
+#if defined(DJV_MSB)
+                if (Pixel::U10 == inType || Pixel::U10 == outType)
+                    return false;
+#endif // DJV_MSB
+                TypeFnc * typeFnc = nullptr;
+                if (inType != outType)
+                {
+                    typeFnc = typeFncs().data[simd][inType][outType];
+                    if (!typeFnc)
+                        return false;
+                }
+                const bool unpack = Pixel::U10 == inType;
+                const bool pack   = Pixel::U10 == outType;
+                const bool formatBgr = bgr && !unpack;
+                const bool formatConvert = rgb && (inFormat != outFormat || formatBgr);
+                if (!unpack && !typeFnc && !formatConvert && !pack)
+                    return false;
+                const bool formatFirst = storageByteCount(inType) < storageByteCount(outType);
+
+                const int inChannels   = Pixel::channels(inFormat);
+                const int outChannels  = Pixel::channels(outFormat);
+                const int inByteCount  = Pixel::byteCount(inPixel);
+                const int outByteCount = Pixel::byteCount(outPixel);
+                quint8 tmp[2][simdChunk * Pixel::channelsMax * sizeof(Pixel::F32_T)];
+                const quint8 * inP = reinterpret_cast<const quint8 *>(in);
+                quint8 * outP = reinterpret_cast<quint8 *>(out);
+                for (int i = 0; i < size; i += simdChunk, inP += simdChunk * inByteCount, outP += simdChunk * outByteCount)
+                {
+                    const int count = std::min(simdChunk, size - i);
+                    const void * p = inP;
+                    int t = 0;
+                    if (unpack)
+                    {
+                        unpackU10(p, reinterpret_cast<quint16 *>(tmp[t]), count, bgr);
+                        p = tmp[t];
+                        t = 1 - t;
+                    }
+                    if (formatConvert && formatFirst)
+                    {
+                        void * dst = typeFnc || pack ? tmp[t] : outP;
+                        format(p, inChannels, dst, outChannels, count, formatBgr, inType);
+                        p = dst;
+                        t = 1 - t;
+                    }
+                    if (typeFnc)
+                    {
+                        void * dst = (formatConvert && !formatFirst) || pack ? tmp[t] : outP;
+                        typeFnc(p, dst, count * (formatConvert && formatFirst ? outChannels : inChannels));
+                        p = dst;
+                        t = 1 - t;
+                    }
+                    if (formatConvert && !formatFirst)
+                    {
+                        void * dst = pack ? tmp[t] : outP;
+                        format(p, inChannels, dst, outChannels, count, formatBgr, outType);
+                        p = dst;
+                        t = 1 - t;
+                    }
+                    if (pack)
+                    {
+                        packU10(reinterpret_cast<const quint16 *>(p), outP, count);
+                    }
+                }
+                return true;
+            }
+
+            std::atomic<int> & simdCurrent()
+            {
+                static std::atomic<int> data(Pixel::cpuSIMD());
+                return data;
+            }
+
+#endif // DJV_PIXEL_SIMD
+
         } // namespace
 
+        Pixel::SIMD Pixel::cpuSIMD()
+        {
+            SIMD out = SIMD_NONE;
+#if defined(DJV_PIXEL_SIMD)
+            int info[4] = { 0, 0, 0, 0 };
+            cpuid(info, 0);
+            const int count = info[0];
+            if (count >= 1)
+            {
+                cpuid(info, 1);
+                const bool ssse3   = (info[2] & (1 << 9))  != 0;
+                const bool sse41   = (info[2] & (1 << 19)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx     = (info[2] & (1 << 28)) != 0;
+                const bool f16c    = (info[2] & (1 << 29)) != 0;
+                if (ssse3 && sse41)
+                {
+                    out = SIMD_SSE4;
+                    // Check that the operating system saves the AVX registers.
+                    if (count >= 7 && osxsave && avx && f16c && (xgetbv() & 6) == 6)
+                    {
+                        cpuid(info, 7);
+                        if (info[1] & (1 << 5))
+                        {
+                            out = SIMD_AVX2;
+                        }
+                    }
+                }
+            }
+#endif // DJV_PIXEL_SIMD
+            return out;
+        }
+
+        Pixel::SIMD Pixel::convertSIMD()
+        {
+#if defined(DJV_PIXEL_SIMD)
+            return static_cast<SIMD>(simdCurrent().load());
+#else // DJV_PIXEL_SIMD
+            return SIMD_NONE;
+#endif // DJV_PIXEL_SIMD
+        }
+
+        void Pixel::setConvertSIMD(SIMD simd)
+        {
+#if defined(DJV_PIXEL_SIMD)
+            simdCurrent() = std::min(simd, cpuSIMD());
+#endif // DJV_PIXEL_SIMD
+        }
+
         void Pixel::convert(
             const void * in,
             PIXEL        inPixel,
@@ -334,11 +1306,17 @@ namespace djv
             if (inPixel == outPixel && 1 == stride && !bgr)
             {
                 memcpy(out, in, size * byteCount(outPixel));
+                return;
             }
-            else
+#if defined(DJV_PIXEL_SIMD)
+            if (1 == stride && size >= simdSizeMin)
             {
-                fnc_tbl[inPixel][outPixel](in, out, size, stride, bgr);
+                const SIMD simd = convertSIMD();
+                if (simd != SIMD_NONE && simdConvert(simd, in, inPixel, out, outPixel, size, bgr))
+                    return;
             }
+#endif // DJV_PIXEL_SIMD
+            fnc_tbl[inPixel][outPixel](in, out, size, stride, bgr);
         }
 
     } // namespace Graphics
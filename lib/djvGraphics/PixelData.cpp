@@ -29,6 +29,7 @@
 
 #include <djvGraphics/PixelData.h>
 
+#include <djvGraphics/PixelDataPool.h>
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
@@ -114,6 +115,19 @@ namespace djv
             return data;
         }
 
+        struct PixelData::Buffer
+        {
+            ~Buffer()
+            {
+                PixelDataPool::global()->release(data, size);
+                delete fileIo;
+            }
+
+            quint8 *       data   = nullptr;
+            quint64        size   = 0;
+            Core::FileIO * fileIo = nullptr;
+        };
+
         PixelData::PixelData()
         {
             //DJV_DEBUG("PixelData::PixelData");
@@ -135,30 +149,52 @@ namespace djv
         }
 
         PixelData::~PixelData()
-        {
-            delete _fileIo;
-        }
+        {}
 
         void PixelData::zero()
         {
             //DJV_DEBUG("PixelData::zero");
-            memset(_data.data(), 0, _dataByteCount);
+            memset(data(), 0, _dataByteCount);
+        }
+
+        bool PixelData::isShared() const
+        {
+            return _buffer && _buffer.use_count() > 1;
+        }
+
+        bool PixelData::isMapped() const
+        {
+            return _buffer && _buffer->fileIo;
+        }
+
+        void PixelData::detach()
+        {
+            if (_buffer && (_buffer->fileIo || _buffer.use_count() > 1))
+            {
+                //DJV_DEBUG("PixelData::detach");
+
+                // Keep a reference to the shared buffer until it is copied.
+                const std::shared_ptr<Buffer> buffer = _buffer;
+                const quint8 * p = _p;
+                _buffer.reset();
+                allocate(_dataByteCount);
+                memcpy(_data, p, _dataByteCount);
+            }
         }
 
         void PixelData::close()
         {
             //DJV_DEBUG("PixelData::close");
-            if (_fileIo)
+            if (_buffer && _buffer->fileIo)
             {
-                delete _fileIo;
                 _info = PixelDataInfo();
                 _channels = 0;
-                _data.resize(0);
+                _buffer.reset();
+                _data = nullptr;
                 _p = nullptr;
                 _pixelByteCount = 0;
                 _scanlineByteCount = 0;
                 _dataByteCount = 0;
-                _fileIo = nullptr;
             }
         }
 
@@ -171,18 +207,6 @@ namespace djv
             return *this;
         }
 
-        void PixelData::detach()
-        {
-            if (_fileIo)
-            {
-                _data.resize(_dataByteCount);
-                memcpy(_data.data(), _p, _dataByteCount);
-                _p = _data.data();
-                delete _fileIo;
-                _fileIo = 0;
-            }
-        }
-
         void PixelData::set(
             const PixelDataInfo & in,
             const quint8 *        p,
@@ -191,9 +215,6 @@ namespace djv
             //DJV_DEBUG("PixelData::set");
             //DJV_DEBUG_PRINT("in = " << in);
 
-            delete _fileIo;
-            _fileIo = 0;
-
             _info = in;
 
             _channels = Pixel::channels(_info.pixel);
@@ -205,32 +226,50 @@ namespace djv
             //DJV_DEBUG_PRINT("bytes scanline = " << _scanlineByteCount);
             //DJV_DEBUG_PRINT("bytes data = " << _dataByteCount);
 
-            if (p)
+            if (p && fileIo)
             {
-                if (fileIo)
-                {
-                    _data.resize(0);
-                    _p = p;
-                    _fileIo = fileIo;
-                }
-                else
-                {
-                    _data.resize(_dataByteCount);
-                    _p = _data.data();
-                    memcpy(_data.data(), p, _dataByteCount);
-                }
+                _buffer.reset(new Buffer);
+                _buffer->fileIo = fileIo;
+                _data = nullptr;
+                _p = p;
             }
             else
             {
-                _data.resize(_dataByteCount);
-                _p = _data.data();
+                allocate(_dataByteCount);
+                if (p)
+                {
+                    memcpy(_data, p, _dataByteCount);
+                }
             }
         }
 
         void PixelData::copy(const PixelData & in)
         {
-            set(in._info);
-            memcpy(_data.data(), in._p, _dataByteCount);
+            _info = in._info;
+            _channels = in._channels;
+            _buffer = in._buffer;
+            _data = in._data;
+            _p = in._p;
+            _pixelByteCount = in._pixelByteCount;
+            _scanlineByteCount = in._scanlineByteCount;
+            _dataByteCount = in._dataByteCount;
+        }
+
+        void PixelData::allocate(quint64 size)
+        {
+            // Keep the current buffer if it is not shared and it is in the same
+            // pool bucket.
+            if (!_buffer ||
+                _buffer->fileIo ||
+                _buffer.use_count() > 1 ||
+                PixelDataPool::bucketSize(size) != _buffer->size)
+            {
+                _buffer.reset(new Buffer);
+                _buffer->data = PixelDataPool::global()->acquire(size);
+                _buffer->size = PixelDataPool::bucketSize(size);
+            }
+            _data = _buffer->data;
+            _p = _data;
         }
 
     } // namespace Graphics
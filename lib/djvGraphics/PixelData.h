@@ -39,6 +39,7 @@
 #include <QMetaType>
 #include <QString>
 
+#include <memory>
 #include <vector>
 
 namespace djv
@@ -114,7 +115,11 @@ namespace djv
             void init();
         };
 
-        //! This class provides pixel data.
+        //! This class provides pixel data. Copies of pixel data share the same
+        //! memory until one of them is changed with the non-const data()
+        //! functions, which first make a copy of the memory if it is shared
+        //! (copy-on-write). Sharing is not thread safe; each thread should use
+        //! its own copy of the pixel data.
         class PixelData
         {
         public:
@@ -123,7 +128,8 @@ namespace djv
             PixelData(const PixelDataInfo &, const quint8 * = 0, Core::FileIO * = 0);
             virtual ~PixelData();
 
-            //! Set the pixel data.
+            //! Set the pixel data. The memory is allocated from the global pixel
+            //! data pool and is not initialized.
             void set(const PixelDataInfo &, const quint8 * = 0, Core::FileIO * = 0);
 
             //! Zero the pixel data.
@@ -153,13 +159,13 @@ namespace djv
             //! Get whether the pixel data is valid.
             inline bool isValid() const;
 
-            //! Get a pointer to the data.
+            //! Get a pointer to the data. The pixel data is detached first.
             inline quint8 * data();
 
             //! Get a pointer to the data.
             inline const quint8 * data() const;
 
-            //! Get a pointer to the data.
+            //! Get a pointer to the data. The pixel data is detached first.
             inline quint8 * data(int x, int y);
 
             //! Get a pointer to the data.
@@ -174,6 +180,18 @@ namespace djv
             //! Get the number of bytes in the data.
             inline quint64 dataByteCount() const;
 
+            //! Get whether the memory is shared with other pixel data.
+            bool isShared() const;
+
+            //! Get whether the pixel data references the memory of a file rather
+            //! than its own memory, see ImageLoad::mapPixelData().
+            bool isMapped() const;
+
+            //! Make a copy of the memory if it is shared with other pixel data or
+            //! mapped from a file. This should be called before pixel data is
+            //! changed from multiple threads.
+            void detach();
+
             //! Close the file I/O associated with the pixel data. This will initialize
             //! the image.
             void close();
@@ -181,17 +199,19 @@ namespace djv
             PixelData & operator = (const PixelData &);
 
         private:
-            void detach();
             void copy(const PixelData &);
-
-            PixelDataInfo       _info;
-            int                 _channels = 0;
-            std::vector<quint8> _data;
-            const quint8 *      _p = nullptr;
-            quint64             _pixelByteCount = 0;
-            quint64             _scanlineByteCount = 0;
-            quint64             _dataByteCount = 0;
-            Core::FileIO *      _fileIo = nullptr;
+            void allocate(quint64);
+
+            struct Buffer;
+
+            PixelDataInfo           _info;
+            int                     _channels = 0;
+            std::shared_ptr<Buffer> _buffer;
+            quint8 *                _data = nullptr;
+            const quint8 *          _p = nullptr;
+            quint64                 _pixelByteCount = 0;
+            quint64                 _scanlineByteCount = 0;
+            quint64                 _dataByteCount = 0;
         };
 
     } // namespace Graphics
@@ -0,0 +1,274 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/PixelDataPool.h>
+
+#include <djvCore/Memory.h>
+
+#if defined(DJV_WINDOWS)
+#include <malloc.h>
+#else // DJV_WINDOWS
+#include <stdlib.h>
+#endif // DJV_WINDOWS
+#if defined(DJV_LINUX)
+#include <sys/mman.h>
+#endif // DJV_LINUX
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <new>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            const quint64 pageSize = 4096;
+            const quint64 hugePageSize = 2 * 1024 * 1024;
+
+            quint8 * allocate(quint64 size, bool hugePages)
+            {
+                const quint64 alignment = hugePages && size >= hugePageSize ? hugePageSize : pageSize;
+                void * p = nullptr;
+#if defined(DJV_WINDOWS)
+                p = ::_aligned_malloc(size, alignment);
+#else // DJV_WINDOWS
+                if (::posix_memalign(&p, alignment, size) != 0)
+                {
+                    p = nullptr;
+                }
+#endif // DJV_WINDOWS
+                if (!p)
+                {
+                    throw std::bad_alloc();
+                }
+#if defined(DJV_LINUX) && defined(MADV_HUGEPAGE)
+                if (hugePages)
+                {
+                    ::madvise(p, size, MADV_HUGEPAGE);
+                }
+#endif // DJV_LINUX
+                return reinterpret_cast<quint8 *>(p);
+            }
+
+            void deallocate(quint8 * p)
+            {
+#if defined(DJV_WINDOWS)
+                ::_aligned_free(p);
+#else // DJV_WINDOWS
+                ::free(p);
+#endif // DJV_WINDOWS
+            }
+
+            struct Buffer
+            {
+                quint64  size = 0;
+                quint8 * p    = nullptr;
+            };
+
+        } // namespace
+
+        struct PixelDataPool::Private
+        {
+            std::mutex mutex;
+
+            // These members are protected by the mutex.
+            quint64 budget = 512 * Core::Memory::megabyte;
+            bool hugePages = false;
+            std::list<Buffer> buffers;
+            quint64 hits = 0;
+            quint64 misses = 0;
+            quint64 outstandingBytes = 0;
+            quint64 pooledBytes = 0;
+        };
+
+        PixelDataPool::PixelDataPool() :
+            _p(new Private)
+        {}
+
+        PixelDataPool::~PixelDataPool()
+        {
+            clear();
+        }
+
+        quint64 PixelDataPool::budget() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->budget;
+        }
+
+        void PixelDataPool::setBudget(quint64 value)
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->budget = value;
+            trim();
+        }
+
+        bool PixelDataPool::hasHugePages() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->hugePages;
+        }
+
+        void PixelDataPool::setHugePages(bool value)
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->hugePages = value;
+        }
+
+        quint8 * PixelDataPool::acquire(quint64 size)
+        {
+            //DJV_DEBUG("PixelDataPool::acquire");
+            //DJV_DEBUG_PRINT("size = " << size);
+            if (!size)
+                return nullptr;
+            size = bucketSize(size);
+            bool hugePages = false;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+
+                // Re-use the most recently released buffer of the same size.
+                for (auto i = _p->buffers.rbegin(); i != _p->buffers.rend(); ++i)
+                {
+                    if (size == i->size)
+                    {
+                        quint8 * p = i->p;
+                        _p->buffers.erase(std::next(i).base());
+                        _p->pooledBytes -= size;
+                        _p->outstandingBytes += size;
+                        ++_p->hits;
+                        return p;
+                    }
+                }
+                _p->outstandingBytes += size;
+                ++_p->misses;
+                hugePages = _p->hugePages;
+            }
+            try
+            {
+                return allocate(size, hugePages);
+            }
+            catch (const std::bad_alloc &)
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->outstandingBytes -= size;
+                throw;
+            }
+        }
+
+        void PixelDataPool::release(quint8 * p, quint64 size)
+        {
+            //DJV_DEBUG("PixelDataPool::release");
+            //DJV_DEBUG_PRINT("size = " << size);
+            if (!p)
+                return;
+            Buffer buffer;
+            buffer.size = bucketSize(size);
+            buffer.p = p;
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            _p->outstandingBytes -= buffer.size;
+            _p->buffers.push_back(buffer);
+            _p->pooledBytes += buffer.size;
+            trim();
+        }
+
+        void PixelDataPool::clear()
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            for (const auto & buffer : _p->buffers)
+            {
+                deallocate(buffer.p);
+            }
+            _p->buffers.clear();
+            _p->pooledBytes = 0;
+        }
+
+        quint64 PixelDataPool::hits() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->hits;
+        }
+
+        quint64 PixelDataPool::misses() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->misses;
+        }
+
+        quint64 PixelDataPool::outstandingBytes() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->outstandingBytes;
+        }
+
+        quint64 PixelDataPool::pooledBytes() const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return _p->pooledBytes;
+        }
+
+        quint64 PixelDataPool::bucketSize(quint64 size)
+        {
+            if (!size)
+                return 0;
+            size = (size + pageSize - 1) / pageSize * pageSize;
+            quint64 power = pageSize;
+            while (power * 2 <= size)
+            {
+                power *= 2;
+            }
+            const quint64 step = power / 8 > pageSize ? power / 8 : pageSize;
+            return (size + step - 1) / step * step;
+        }
+
+        PixelDataPool * PixelDataPool::global()
+        {
+            // The global pool is not deleted so that pixel data destroyed while
+            // the application is exiting can still return its buffers.
+            static PixelDataPool * pool = new PixelDataPool;
+            return pool;
+        }
+
+        void PixelDataPool::trim()
+        {
+            // Free the least recently released buffers until the pool fits in
+            // the budget. The mutex must be locked by the caller.
+            while (_p->pooledBytes > _p->budget && !_p->buffers.empty())
+            {
+                const Buffer & buffer = _p->buffers.front();
+                deallocate(buffer.p);
+                _p->pooledBytes -= buffer.size;
+                _p->buffers.pop_front();
+            }
+        }
+
+    } // namespace Graphics
+} // namespace djv
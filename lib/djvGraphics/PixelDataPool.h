@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        //! This class provides a pool of buffers for pixel data. Buffers that
+        //! are released are kept for re-use up to the budget, so that loading
+        //! a sequence of frames does not allocate and free memory for each
+        //! frame. Buffers are page aligned and their contents are not
+        //! initialized. This class is thread safe.
+        class PixelDataPool
+        {
+        public:
+            PixelDataPool();
+
+            ~PixelDataPool();
+
+            //! Get the maximum number of bytes kept in the pool.
+            quint64 budget() const;
+
+            //! Set the maximum number of bytes kept in the pool. A budget of zero
+            //! disables pooling.
+            void setBudget(quint64);
+
+            //! Get whether new buffers use huge pages.
+            bool hasHugePages() const;
+
+            //! Set whether new buffers use huge pages. This is only supported on
+            //! Linux with transparent huge pages.
+            void setHugePages(bool);
+
+            //! Get a buffer with at least the given number of bytes.
+            quint8 * acquire(quint64);
+
+            //! Return a buffer to the pool. The size must be the same as the
+            //! size given to acquire().
+            void release(quint8 *, quint64);
+
+            //! Free the buffers kept in the pool.
+            void clear();
+
+            //! Get the number of requests that re-used a buffer.
+            quint64 hits() const;
+
+            //! Get the number of requests that allocated a new buffer.
+            quint64 misses() const;
+
+            //! Get the number of bytes in buffers that have not been released.
+            quint64 outstandingBytes() const;
+
+            //! Get the number of bytes kept in the pool.
+            quint64 pooledBytes() const;
+
+            //! Get the size of the bucket used for a buffer. Sizes are rounded
+            //! up to a page and then to one of eight steps between powers of two.
+            static quint64 bucketSize(quint64);
+
+            //! Get the global pool.
+            static PixelDataPool * global();
+
+        private:
+            void trim();
+
+            DJV_PRIVATE_COPY(PixelDataPool);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Graphics
+} // namespace djv
@@ -30,11 +30,455 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/ThreadPool.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! The minimum number of pixels given to a thread. Images smaller
+            //! than this are processed serially.
+            const int threadPixelsMin = 65536;
+
+            //! Process the scanlines of an image in parallel with the global
+            //! thread pool. The output pixel data must be detached first.
+            void parallelScanlines(int w, int h, const std::function<void(int, int)> & fnc)
+            {
+                Core::ThreadPool::global()->parallelFor(
+                    h,
+                    Core::Math::max(1, threadPixelsMin / Core::Math::max(1, w)),
+                    fnc);
+            }
+
+            PixelDataUtil::PROXY_FILTER _proxyFilter = PixelDataUtil::PROXY_FILTER_NEAREST;
+
+            //! Get the size of the words used for converting the endian.
+            int endianWordSize(Pixel::PIXEL pixel)
+            {
+                return Pixel::RGB_U10 == pixel ? 4 : Pixel::channelByteCount(pixel);
+            }
+
+            //! This struct provides the type used to sum the scanlines of a
+            //! block. The largest block is 8x8 pixels so 16-bit integers are
+            //! enough for 8-bit data.
+            template<typename T>
+            struct BoxColumn
+            {
+                typedef quint32 Type;
+            };
+
+            template<>
+            struct BoxColumn<Pixel::U8_T>
+            {
+                typedef quint16 Type;
+            };
+
+            template<>
+            struct BoxColumn<Pixel::F32_T>
+            {
+                typedef Pixel::F32_T Type;
+            };
+
+            //! This struct provides the average of a block. Integers are rounded
+            //! and divided with a reciprocal multiply, which is exact for the
+            //! sums of 8x8 blocks of 16-bit data.
+            template<typename T>
+            struct BoxAverage
+            {
+                typedef quint32 Sum;
+
+                explicit BoxAverage(int count) :
+                    half(count / 2),
+                    reciprocal((static_cast<quint64>(1) << 40) / count + 1)
+                {}
+
+                inline T operator () (Sum sum) const
+                {
+                    return static_cast<T>(((sum + half) * reciprocal) >> 40);
+                }
+
+                Sum     half;
+                quint64 reciprocal;
+            };
+
+            template<>
+            struct BoxAverage<Pixel::F16_T>
+            {
+                typedef Pixel::F32_T Sum;
+
+                explicit BoxAverage(int count) :
+                    scale(1.f / count)
+                {}
+
+                inline Pixel::F16_T operator () (Sum sum) const
+                {
+                    return static_cast<Pixel::F16_T>(sum * scale);
+                }
+
+                Pixel::F32_T scale;
+            };
+
+            template<>
+            struct BoxAverage<Pixel::F32_T>
+            {
+                typedef Pixel::F32_T Sum;
+
+                explicit BoxAverage(int count) :
+                    scale(1.f / count)
+                {}
+
+                inline Pixel::F32_T operator () (Sum sum) const
+                {
+                    return sum * scale;
+                }
+
+                Pixel::F32_T scale;
+            };
+
+            //! Sum a row of scanlines into columns. This is a simple loop that
+            //! the compiler can vectorize.
+            template<typename T>
+            void boxColumns(
+                const std::vector<const quint8 *> &              in,
+                int                                              size,
+                std::vector<typename BoxColumn<T>::Type> &       out)
+            {
+                out.resize(size);
+                typename BoxColumn<T>::Type * outP = out.data();
+                const T * inP = reinterpret_cast<const T *>(in[0]);
+                for (int i = 0; i < size; ++i)
+                {
+                    outP[i] = inP[i];
+                }
+                for (size_t j = 1; j < in.size(); ++j)
+                {
+                    inP = reinterpret_cast<const T *>(in[j]);
+                    for (int i = 0; i < size; ++i)
+                    {
+                        outP[i] += inP[i];
+                    }
+                }
+            }
+
+            //! Sum a row of 10-bit scanlines into columns. The channels are
+            //! summed into separate planes so that the loop can be vectorized.
+            void boxColumnsU10(
+                const std::vector<const quint8 *> & in,
+                int                                 width,
+                std::vector<quint32> &              out)
+            {
+                out.resize(width * 3);
+                std::fill(out.begin(), out.end(), 0);
+                quint32 * r = out.data();
+                quint32 * g = r + width;
+                quint32 * b = g + width;
+                for (size_t j = 0; j < in.size(); ++j)
+                {
+                    // Both of the 10-bit structs place the channels at the
+                    // same bits of a native 32-bit word.
+                    const quint32 * inP = reinterpret_cast<const quint32 *>(in[j]);
+                    for (int i = 0; i < width; ++i)
+                    {
+                        r[i] += (inP[i] >> 22) & 1023;
+                        g[i] += (inP[i] >> 12) & 1023;
+                        b[i] += (inP[i] >> 2) & 1023;
+                    }
+                }
+            }
+
+            //! Sum the columns of each block and average them. The scale and
+            //! number of channels are template parameters so that the loops
+            //! are unrolled.
+            template<typename S, typename T, int SCALE, int CHANNELS>
+            void boxBlocks(
+                const S * in,
+                int       inWidth,
+                int       rows,
+                int       width,
+                T *       out)
+            {
+                typedef typename BoxAverage<T>::Sum Sum;
+                const int scale = SCALE;
+                const int fullWidth = Core::Math::min(width, inWidth / scale);
+                const BoxAverage<T> average(scale * rows);
+                for (int x = 0; x < fullWidth; ++x, in += scale * CHANNELS, out += CHANNELS)
+                {
+                    for (int c = 0; c < CHANNELS; ++c)
+                    {
+                        Sum sum = in[c];
+                        for (int i = 1; i < SCALE; ++i)
+                        {
+                            sum += in[i * CHANNELS + c];
+                        }
+                        out[c] = average(sum);
+                    }
+                }
+                if (fullWidth < width)
+                {
+                    // The last block is cut off by the edge of the image.
+                    const int columns = inWidth - fullWidth * scale;
+                    const BoxAverage<T> average(columns * rows);
+                    for (int c = 0; c < CHANNELS; ++c)
+                    {
+                        Sum sum = in[c];
+                        for (int i = 1; i < columns; ++i)
+                        {
+                            sum += in[i * CHANNELS + c];
+                        }
+                        out[c] = average(sum);
+                    }
+                }
+            }
+
+            template<typename S, typename T, int SCALE>
+            void boxBlocks(
+                const S * in,
+                int       inWidth,
+                int       channels,
+                int       rows,
+                int       width,
+                T *       out)
+            {
+                switch (channels)
+                {
+                case 1: boxBlocks<S, T, SCALE, 1>(in, inWidth, rows, width, out); break;
+                case 2: boxBlocks<S, T, SCALE, 2>(in, inWidth, rows, width, out); break;
+                case 3: boxBlocks<S, T, SCALE, 3>(in, inWidth, rows, width, out); break;
+                case 4: boxBlocks<S, T, SCALE, 4>(in, inWidth, rows, width, out); break;
+                default: break;
+                }
+            }
+
+            template<typename S, typename T>
+            void boxBlocks(
+                const S * in,
+                int       inWidth,
+                int       channels,
+                int       scale,
+                int       rows,
+                int       width,
+                T *       out)
+            {
+                switch (scale)
+                {
+                case 2: boxBlocks<S, T, 2>(in, inWidth, channels, rows, width, out); break;
+                case 4: boxBlocks<S, T, 4>(in, inWidth, channels, rows, width, out); break;
+                case 8: boxBlocks<S, T, 8>(in, inWidth, channels, rows, width, out); break;
+                default: break;
+                }
+            }
+
+            //! Proxy scale pixel data by using the first pixel of each block.
+            void proxyScaleNearest(
+                const PixelData &    in,
+                PixelData &          out,
+                PixelDataInfo::PROXY proxy)
+            {
+                //DJV_DEBUG("proxyScaleNearest");
+                //DJV_DEBUG_PRINT("in = " << in);
+                //DJV_DEBUG_PRINT("out = " << out);
+                //DJV_DEBUG_PRINT("proxy = " << proxy);
+
+                const int  w = out.w();
+                const int  h = out.h();
+                const int  proxyScale = PixelDataUtil::proxyScale(proxy);
+                const bool bgr = in.info().bgr != out.info().bgr;
+                const bool endian = in.info().endian != out.info().endian;
+                //DJV_DEBUG_PRINT("bgr = " << bgr);
+                //DJV_DEBUG_PRINT("endian = " << endian);
+
+                const bool fast = in.pixel() == out.pixel() && !bgr && !endian;
+                //DJV_DEBUG_PRINT("fast = " << fast);
+
+                out.detach();
+                parallelScanlines(w, h, [&](int y0, int y1)
+                {
+                    std::vector<quint8> tmp;
+                    if (!fast)
+                    {
+                        tmp.resize(w * proxyScale * Pixel::byteCount(in.pixel()));
+                        //DJV_DEBUG_PRINT("tmp size = " << tmp.size());
+                    }
+
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        const quint8 * inP = in.data(0, y * proxyScale);
+                        quint8 * outP = out.data(0, y);
+                        if (fast)
+                        {
+                            PixelDataUtil::proxyScaleScanline(
+                                inP,
+                                outP,
+                                w,
+                                in.pixelByteCount(),
+                                proxy);
+                        }
+                        else
+                        {
+                            if (endian)
+                            {
+                                const int wordSize = endianWordSize(in.pixel());
+                                const int size = in.w() * in.pixelByteCount() / wordSize;
+                                //DJV_DEBUG_PRINT("endian size = " << size);
+                                //DJV_DEBUG_PRINT("endian word size = " << wordSize);
+                                Core::Memory::convertEndian(inP, tmp.data(), size, wordSize);
+                                inP = tmp.data();
+                            }
+
+                            //DJV_DEBUG_PRINT("convert");
+                            Pixel::convert(
+                                inP,
+                                in.pixel(),
+                                outP,
+                                out.pixel(),
+                                w,
+                                proxyScale,
+                                bgr);
+                        }
+                    }
+                });
+            }
+
+            //! Proxy scale pixel data by averaging blocks of pixels. The blocks
+            //! are averaged in the input pixel type and then converted.
+            void proxyScaleBox(
+                const PixelData &    in,
+                PixelData &          out,
+                PixelDataInfo::PROXY proxy)
+            {
+                //DJV_DEBUG("proxyScaleBox");
+                //DJV_DEBUG_PRINT("in = " << in);
+                //DJV_DEBUG_PRINT("out = " << out);
+                //DJV_DEBUG_PRINT("proxy = " << proxy);
+                const int  w = out.w();
+                const int  h = out.h();
+                const int  scale = PixelDataUtil::proxyScale(proxy);
+                const bool bgr = in.info().bgr != out.info().bgr;
+                const bool inEndian = in.info().endian != Core::Memory::endian();
+                const bool outEndian = out.info().endian != Core::Memory::endian();
+                const bool convert = in.pixel() != out.pixel() || bgr;
+                const int  inWordSize = endianWordSize(in.pixel());
+                const int  outWordSize = endianWordSize(out.pixel());
+                //DJV_DEBUG_PRINT("bgr = " << bgr);
+                //DJV_DEBUG_PRINT("in endian = " << inEndian);
+                //DJV_DEBUG_PRINT("out endian = " << outEndian);
+                //DJV_DEBUG_PRINT("convert = " << convert);
+                out.detach();
+                parallelScanlines(in.w(), h, [&](int y0, int y1)
+                {
+                    std::vector<const quint8 *> rows;
+                    std::vector<std::vector<quint8> > endianTmp(scale);
+                    std::vector<std::vector<Pixel::F32_T> > f32Tmp(scale);
+                    std::vector<quint16> u16Sums;
+                    std::vector<quint32> u32Sums;
+                    std::vector<Pixel::F32_T> f32Sums;
+                    std::vector<quint16> u10Tmp;
+                    std::vector<quint8> tmp;
+                    if (convert)
+                    {
+                        tmp.resize(w * Pixel::byteCount(in.pixel()));
+                    }
+                    const int channels = in.channels();
+                    const int size = in.w() * channels;
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        rows.clear();
+                        const int inY = y * scale;
+                        const int rowCount = Core::Math::min(scale, in.h() - inY);
+                        for (int i = 0; i < rowCount; ++i)
+                        {
+                            const quint8 * p = in.data(0, inY + i);
+                            if (inEndian && inWordSize > 1)
+                            {
+                                const quint64 byteCount = in.w() * in.pixelByteCount();
+                                endianTmp[i].resize(byteCount);
+                                Core::Memory::convertEndian(
+                                    p,
+                                    endianTmp[i].data(),
+                                    byteCount / inWordSize,
+                                    inWordSize);
+                                p = endianTmp[i].data();
+                            }
+                            if (Pixel::F16 == Pixel::type(in.pixel()))
+                            {
+                                // Half floats are summed as floats.
+                                f32Tmp[i].resize(size);
+                                Pixel::convert(p, Pixel::L_F16, f32Tmp[i].data(), Pixel::L_F32, size);
+                                p = reinterpret_cast<const quint8 *>(f32Tmp[i].data());
+                            }
+                            rows.push_back(p);
+                        }
+                        quint8 * outP = out.data(0, y);
+                        quint8 * p = convert ? tmp.data() : outP;
+                        switch (Pixel::type(in.pixel()))
+                        {
+                        case Pixel::U8:
+                            boxColumns<Pixel::U8_T>(rows, size, u16Sums);
+                            boxBlocks(u16Sums.data(), in.w(), channels, scale, rowCount, w,
+                                reinterpret_cast<Pixel::U8_T *>(p));
+                            break;
+                        case Pixel::U10:
+                        {
+                            boxColumnsU10(rows, in.w(), u32Sums);
+                            u10Tmp.resize(w * 3);
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                boxBlocks(u32Sums.data() + c * in.w(), in.w(), 1, scale, rowCount, w,
+                                    u10Tmp.data() + c * w);
+                            }
+                            Pixel::U10_S * u10P = reinterpret_cast<Pixel::U10_S *>(p);
+                            for (int x = 0; x < w; ++x, ++u10P)
+                            {
+                                u10P->r = u10Tmp[x];
+                                u10P->g = u10Tmp[w + x];
+                                u10P->b = u10Tmp[w * 2 + x];
+                                u10P->pad = 0;
+                            }
+                            break;
+                        }
+                        case Pixel::U16:
+                            boxColumns<Pixel::U16_T>(rows, size, u32Sums);
+                            boxBlocks(u32Sums.data(), in.w(), channels, scale, rowCount, w,
+                                reinterpret_cast<Pixel::U16_T *>(p));
+                            break;
+                        case Pixel::F16:
+                            boxColumns<Pixel::F32_T>(rows, size, f32Sums);
+                            boxBlocks(f32Sums.data(), in.w(), channels, scale, rowCount, w,
+                                reinterpret_cast<Pixel::F16_T *>(p));
+                            break;
+                        case Pixel::F32:
+                            boxColumns<Pixel::F32_T>(rows, size, f32Sums);
+                            boxBlocks(f32Sums.data(), in.w(), channels, scale, rowCount, w,
+                                reinterpret_cast<Pixel::F32_T *>(p));
+                            break;
+                        default: break;
+                        }
+                        if (convert)
+                        {
+                            Pixel::convert(p, in.pixel(), outP, out.pixel(), w, 1, bgr);
+                        }
+                        if (outEndian && outWordSize > 1)
+                        {
+                            Core::Memory::convertEndian(
+                                outP,
+                                w * out.pixelByteCount() / outWordSize,
+                                outWordSize);
+                        }
+                    }
+                });
+            }
+
+        } // namespace
+
         PixelDataUtil::~PixelDataUtil()
         {}
 
@@ -48,91 +492,48 @@ namespace djv
             return in.size.y * scanlineByteCount(in);
         }
 
+        const QStringList & PixelDataUtil::proxyFilterLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Graphics::PixelDataUtil", "Nearest") <<
+                qApp->translate("djv::Graphics::PixelDataUtil", "Box");
+            DJV_ASSERT(data.count() == PROXY_FILTER_COUNT);
+            return data;
+        }
+
+        PixelDataUtil::PROXY_FILTER PixelDataUtil::proxyFilter()
+        {
+            return _proxyFilter;
+        }
+
+        void PixelDataUtil::setProxyFilter(PROXY_FILTER filter)
+        {
+            _proxyFilter = filter;
+        }
+
         void PixelDataUtil::proxyScale(
             const PixelData &    in,
             PixelData &          out,
             PixelDataInfo::PROXY proxy)
         {
-            //DJV_DEBUG("PixelDataUtil::proxyScale");
-            //DJV_DEBUG_PRINT("in = " << in);
-            //DJV_DEBUG_PRINT("out = " << out);
-            //DJV_DEBUG_PRINT("proxy = " << proxy);
-
-            const int  w = out.w();
-            const int  h = out.h();
-            const int  proxyScale = PixelDataUtil::proxyScale(proxy);
-            const bool bgr = in.info().bgr != out.info().bgr;
-            const bool endian = in.info().endian != out.info().endian;
-            //DJV_DEBUG_PRINT("bgr = " << bgr);
-            //DJV_DEBUG_PRINT("endian = " << endian);
-
-            const bool fast = in.pixel() == out.pixel() && !bgr && !endian;
-            //DJV_DEBUG_PRINT("fast = " << fast);
+            proxyScale(in, out, proxy, _proxyFilter);
+        }
 
-            std::vector<quint8> tmp;
-            if (!fast)
+        void PixelDataUtil::proxyScale(
+            const PixelData &    in,
+            PixelData &          out,
+            PixelDataInfo::PROXY proxy,
+            PROXY_FILTER         filter)
+        {
+            //DJV_DEBUG("PixelDataUtil::proxyScale");
+            //DJV_DEBUG_PRINT("filter = " << filter);
+            if (PROXY_FILTER_BOX == filter && proxy != PixelDataInfo::PROXY_NONE)
             {
-                tmp.resize(w * proxyScale * Pixel::byteCount(in.pixel()));
-                //DJV_DEBUG_PRINT("tmp size = " << tmp.size());
+                proxyScaleBox(in, out, proxy);
             }
-
-            for (int y = 0; y < h; ++y)
+            else
             {
-                const quint8 * inP = in.data(0, y * proxyScale);
-                quint8 * outP = out.data(0, y);
-                if (fast)
-                {
-                    const quint64 pixelByteCount = in.pixelByteCount();
-                    const quint64 inStride = pixelByteCount * proxyScale;
-                    const quint64 outStride = pixelByteCount;
-                    for (
-                        int x = 0;
-                        x < w;
-                        ++x, inP += inStride, outP += outStride)
-                    {
-                        switch (pixelByteCount)
-                        {
-                        case 16: outP[15] = inP[15];
-                        case 15: outP[14] = inP[14];
-                        case 14: outP[13] = inP[13];
-                        case 13: outP[12] = inP[12];
-                        case 12: outP[11] = inP[11];
-                        case 11: outP[10] = inP[10];
-                        case 10: outP[9] = inP[9];
-                        case 9:  outP[8] = inP[8];
-                        case 8:  outP[7] = inP[7];
-                        case 7:  outP[6] = inP[6];
-                        case 6:  outP[5] = inP[5];
-                        case 5:  outP[4] = inP[4];
-                        case 4:  outP[3] = inP[3];
-                        case 3:  outP[2] = inP[2];
-                        case 2:  outP[1] = inP[1];
-                        case 1:  outP[0] = inP[0];
-                        }
-                    }
-                }
-                else
-                {
-                    if (endian)
-                    {
-                        const int size = w * proxyScale;
-                        const int wordSize = Pixel::byteCount(in.pixel());
-                        //DJV_DEBUG_PRINT("endian size = " << size);
-                        //DJV_DEBUG_PRINT("endian word size = " << wordSize);
-                        Core::Memory::convertEndian(inP, tmp.data(), size, wordSize);
-                        inP = tmp.data();
-                    }
-
-                    //DJV_DEBUG_PRINT("convert");
-                    Pixel::convert(
-                        inP,
-                        in.pixel(),
-                        outP,
-                        out.pixel(),
-                        w,
-                        proxyScale,
-                        bgr);
-                }
+                proxyScaleNearest(in, out, proxy);
             }
         }
 
@@ -159,6 +560,39 @@ namespace djv
                 Core::Math::ceil(in.size.y / static_cast<float>(scale)));
         }
 
+        void PixelDataUtil::proxyScaleScanline(
+            const quint8 *       in,
+            quint8 *             out,
+            int                  width,
+            int                  pixelByteCount,
+            PixelDataInfo::PROXY proxy)
+        {
+            const quint64 inStride = pixelByteCount * proxyScale(proxy);
+            const quint64 outStride = pixelByteCount;
+            for (int x = 0; x < width; ++x, in += inStride, out += outStride)
+            {
+                switch (pixelByteCount)
+                {
+                case 16: out[15] = in[15];
+                case 15: out[14] = in[14];
+                case 14: out[13] = in[13];
+                case 13: out[12] = in[12];
+                case 12: out[11] = in[11];
+                case 11: out[10] = in[10];
+                case 10: out[9] = in[9];
+                case 9:  out[8] = in[8];
+                case 8:  out[7] = in[7];
+                case 7:  out[6] = in[6];
+                case 6:  out[5] = in[5];
+                case 5:  out[4] = in[4];
+                case 4:  out[3] = in[3];
+                case 3:  out[2] = in[2];
+                case 2:  out[1] = in[1];
+                case 1:  out[0] = in[0];
+                }
+            }
+        }
+
         void PixelDataUtil::planarInterleave(
             const PixelData &    in,
             PixelData &          out,
@@ -178,29 +612,33 @@ namespace djv
             const int     channels = out.channels();
             const quint64 pixelByteCount = out.pixelByteCount();
             const int     channelByteCount = Pixel::channelByteCount(out.pixel());
-            for (int c = 0; c < channels; ++c)
+            out.detach();
+            parallelScanlines(w * channels, h, [&](int y0, int y1)
             {
-                for (int y = 0; y < h; ++y)
+                for (int c = 0; c < channels; ++c)
                 {
-                    const quint8 * inP = in.data() + (c * in.h() + y * proxyScale) *
-                        in.w() * channelByteCount;
-                    quint8 * outP = out.data(0, y) + c * channelByteCount;
-                    for (
-                        int x = 0;
-                        x < w;
-                        ++x, inP += channelByteCount * proxyScale,
-                        outP += pixelByteCount)
+                    for (int y = y0; y < y1; ++y)
                     {
-                        switch (channelByteCount)
+                        const quint8 * inP = in.data() + (c * in.h() + y * proxyScale) *
+                            in.w() * channelByteCount;
+                        quint8 * outP = out.data(0, y) + c * channelByteCount;
+                        for (
+                            int x = 0;
+                            x < w;
+                            ++x, inP += channelByteCount * proxyScale,
+                            outP += pixelByteCount)
                         {
-                        case 4: outP[3] = inP[3];
-                        case 3: outP[2] = inP[2];
-                        case 2: outP[1] = inP[1];
-                        case 1: outP[0] = inP[0];
+                            switch (channelByteCount)
+                            {
+                            case 4: outP[3] = inP[3];
+                            case 3: outP[2] = inP[2];
+                            case 2: outP[1] = inP[1];
+                            case 1: outP[0] = inP[0];
+                            }
                         }
                     }
                 }
-            }
+            });
         }
 
         void PixelDataUtil::planarDeinterleave(const PixelData & in, PixelData & out)
@@ -217,27 +655,31 @@ namespace djv
             const int     channels = out.channels();
             const quint64 pixelByteCount = out.pixelByteCount();
             const int     channelByteCount = Pixel::channelByteCount(out.pixel());
-            for (int c = 0; c < channels; ++c)
+            out.detach();
+            parallelScanlines(w * channels, h, [&](int y0, int y1)
             {
-                for (int y = 0; y < h; ++y)
+                for (int c = 0; c < channels; ++c)
                 {
-                    const quint8 * inP = in.data(0, y) + c * channelByteCount;
-                    quint8 * outP = out.data() + (c * h + y) * w * channelByteCount;
-                    for (
-                        int x = 0;
-                        x < w;
-                        ++x, inP += pixelByteCount, outP += channelByteCount)
+                    for (int y = y0; y < y1; ++y)
                     {
-                        switch (channelByteCount)
+                        const quint8 * inP = in.data(0, y) + c * channelByteCount;
+                        quint8 * outP = out.data() + (c * h + y) * w * channelByteCount;
+                        for (
+                            int x = 0;
+                            x < w;
+                            ++x, inP += pixelByteCount, outP += channelByteCount)
                         {
-                        case 4: outP[3] = inP[3];
-                        case 3: outP[2] = inP[2];
-                        case 2: outP[1] = inP[1];
-                        case 1: outP[0] = inP[0];
+                            switch (channelByteCount)
+                            {
+                            case 4: outP[3] = inP[3];
+                            case 3: outP[2] = inP[2];
+                            case 2: outP[1] = inP[1];
+                            case 1: outP[0] = inP[0];
+                            }
                         }
                     }
                 }
-            }
+            });
         }
 
         void PixelDataUtil::gradient(PixelData & out)
@@ -246,15 +688,30 @@ namespace djv
             const PixelDataInfo info(out.size(), Pixel::L_F32);
             out.set(info);
             //DJV_DEBUG_PRINT("out = " << out);
-            for (int y = 0; y < info.size.y; ++y)
+            parallelScanlines(info.size.x, info.size.y, [&](int y0, int y1)
             {
-                Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(out.data(0, y));
-                for (int x = 0; x < info.size.x; ++x, ++p)
+                for (int y = y0; y < y1; ++y)
                 {
-                    *p = static_cast<Pixel::F32_T>(x / static_cast<float>(info.size.x - 1));
+                    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(out.data(0, y));
+                    for (int x = 0; x < info.size.x; ++x, ++p)
+                    {
+                        *p = static_cast<Pixel::F32_T>(x / static_cast<float>(info.size.x - 1));
+                    }
                 }
-            }
+            });
         }
 
     } // namespace Graphics
+
+    _DJV_STRING_OPERATOR_LABEL(
+        Graphics::PixelDataUtil::PROXY_FILTER,
+        Graphics::PixelDataUtil::proxyFilterLabels());
+
+    Core::Debug & operator << (Core::Debug & debug, const Graphics::PixelDataUtil::PROXY_FILTER & in)
+    {
+        QStringList tmp;
+        tmp << in;
+        return debug << tmp;
+    }
+
 } // namespace djv
@@ -48,12 +48,39 @@ namespace djv
             //! Get the number of bytes in the data.
             static quint64 dataByteCount(const PixelDataInfo &);
 
-            //! Proxy scale pixel data.
+            //! This enumeration provides the proxy scale filters.
+            enum PROXY_FILTER
+            {
+                PROXY_FILTER_NEAREST, //!< Use the first pixel of each block
+                PROXY_FILTER_BOX,     //!< Average the pixels of each block
+
+                PROXY_FILTER_COUNT
+            };
+
+            //! Get the proxy scale filter labels.
+            static const QStringList & proxyFilterLabels();
+
+            //! Get the global proxy scale filter.
+            static PROXY_FILTER proxyFilter();
+
+            //! Set the global proxy scale filter. The default is the nearest
+            //! filter; the box filter is slower, and the loaders that can read
+            //! proxies natively only do so with the nearest filter.
+            static void setProxyFilter(PROXY_FILTER);
+
+            //! Proxy scale pixel data with the global proxy scale filter.
             static void proxyScale(
                 const PixelData &,
                 PixelData &,
                 PixelDataInfo::PROXY);
 
+            //! Proxy scale pixel data.
+            static void proxyScale(
+                const PixelData &,
+                PixelData &,
+                PixelDataInfo::PROXY,
+                PROXY_FILTER);
+
             //! Calculate the proxy scale.
             static int proxyScale(PixelDataInfo::PROXY);
 
@@ -63,6 +90,17 @@ namespace djv
             //! Calculate the size of a proxy scale.
             static Core::Box2i proxyScale(const Core::Box2i &, PixelDataInfo::PROXY);
 
+            //! Proxy scale a single scanline by taking every Nth pixel. The input
+            //! and output have the same pixel type and the width is the proxy
+            //! width. This is used by loaders that only read the scanlines they
+            //! need.
+            static void proxyScaleScanline(
+                const quint8 *       in,
+                quint8 *             out,
+                int                  width,
+                int                  pixelByteCount,
+                PixelDataInfo::PROXY);
+
             //! Interleave pixel data channels.
             static void planarInterleave(
                 const PixelData &,
@@ -77,4 +115,9 @@ namespace djv
         };
 
     } // namespace Graphics
+
+    DJV_STRING_OPERATOR(Graphics::PixelDataUtil::PROXY_FILTER);
+
+    DJV_DEBUG_OPERATOR(Graphics::PixelDataUtil::PROXY_FILTER);
+
 } // namespace djv
@@ -347,18 +347,23 @@ namespace djv
 
         // Note that we use a LUT in some cases because bit shifting doesn't seem to
         // preserve maximum values?
+        //
+        // The LUT is a function local static so that it is safely initialized when
+        // pixels are converted from multiple threads.
 #define _PIXEL_LUT(IN, OUT, IN_MAX, OUT_MAX) \
-    static OUT##_T lut [IN_MAX + 1]; \
-    static bool init = false; \
-    if (! init) \
+    struct LUT \
     { \
-        for (int i = 0; i <= IN_MAX; ++i) \
+        LUT() \
         { \
-            lut[i] = OUT##_T(i / static_cast<float>(IN_MAX) * OUT_MAX); \
+            for (int i = 0; i <= IN_MAX; ++i) \
+            { \
+                data[i] = OUT##_T(i / static_cast<float>(IN_MAX) * OUT_MAX); \
+            } \
         } \
-        init = true; \
-    } \
-    return lut[in];
+        OUT##_T data[IN_MAX + 1]; \
+    }; \
+    static const LUT lut; \
+    return lut.data[in];
 
         inline Pixel::U10_T Pixel::u8ToU10(U8_T in)
         {
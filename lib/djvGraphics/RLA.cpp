@@ -38,35 +38,69 @@ namespace djv
     {
         const QString RLA::staticName = "RLA";
 
-        void RLA::readRle(
-            Core::FileIO & io,
+        namespace
+        {
+            //! Get the size of the channel data.
+            const quint8 * loadSize(const quint8 * in, const quint8 * end, quint16 & size, bool endian)
+            {
+                if (end - in < 2)
+                {
+                    return 0;
+                }
+                if (endian)
+                {
+                    Core::Memory::convertEndian(in, &size, 1, 2);
+                }
+                else
+                {
+                    memcpy(&size, in, 2);
+                }
+                return in + 2;
+            }
+
+        } // namespace
+
+        const quint8 * RLA::readRle(
+            const quint8 * in,
+            const quint8 * end,
             quint8 *       out,
             int            size,
             int            channels,
-            int            bytes)
+            int            bytes,
+            bool           endian)
         {
             //DJV_DEBUG("RLA::readRle");
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("bytes = " << bytes);
-            qint16 _size = 0;
-            io.get16(&_size);
+            quint16 _size = 0;
+            const quint8 * p = loadSize(in, end, _size, endian);
+            if (!p || end - p < _size)
+            {
+                return 0;
+            }
             //DJV_DEBUG_PRINT("io size = " << _size);
-            const quint8 * start = io.mmapP();
-            const quint8 * p = start;
-            io.seek(_size);
+            const quint8 * const start = p;
             for (int b = 0; b < bytes; ++b)
             {
                 quint8 * outP = out + (Core::Memory::LSB == Core::Memory::endian() ? (bytes - 1 - b) : b);
                 const int outInc = channels * bytes;
                 for (int i = 0; i < size;)
                 {
+                    if (p >= end)
+                    {
+                        return 0;
+                    }
                     int count = *((qint8 *)p);
                     ++p;
                     //DJV_DEBUG_PRINT("count = " << count);
                     if (count >= 0)
                     {
                         ++count;
+                        if (p >= end || i + count > size)
+                        {
+                            return 0;
+                        }
                         for (int j = 0; j < count; ++j, outP += outInc)
                         {
                             *outP = *p;
@@ -76,6 +110,10 @@ namespace djv
                     else
                     {
                         count = -count;
+                        if (end - p < count || i + count > size)
+                        {
+                            return 0;
+                        }
                         for (int j = 0; j < count; ++j, ++p, outP += outInc)
                         {
                             *outP = *p;
@@ -85,23 +123,28 @@ namespace djv
                 }
             }
             //DJV_DEBUG_PRINT("out = " << p - start);
+            return start + _size;
         }
 
-        void RLA::floatLoad(
-            Core::FileIO & io,
+        const quint8 * RLA::floatLoad(
+            const quint8 * in,
+            const quint8 * end,
             quint8 *       out,
             int            size,
-            int            channels)
+            int            channels,
+            bool           endian)
         {
             //DJV_DEBUG("RLA::floatLoad");
             //DJV_DEBUG_PRINT("size = " << size);
             //DJV_DEBUG_PRINT("channels = " << channels);
-            qint16 _size = 0;
-            io.get16(&_size);
+            quint16 _size = 0;
+            const quint8 * p = loadSize(in, end, _size, endian);
+            if (!p || end - p < _size || end - p < size * 4)
+            {
+                return 0;
+            }
             //DJV_DEBUG_PRINT("io size = " << _size);
-            const quint8 * start = io.mmapP();
-            const quint8 * p = start;
-            io.seek(_size);
+            const quint8 * const start = p;
             const int outInc = channels * 4;
             if (Core::Memory::LSB == Core::Memory::endian())
             {
@@ -124,6 +167,7 @@ namespace djv
                 }
             }
             //DJV_DEBUG_PRINT("out = " << p - start);
+            return start + _size;
         }
 
         void RLA::skip(Core::FileIO & io)
@@ -41,17 +41,28 @@ namespace djv
             //! Plugin name.
             static const QString staticName;
 
-            //! Load RLE data.
-            //!
-            //! Throws:
-            //! - Core::Error
-            static void readRle(Core::FileIO & io, quint8 * out, int size, int channels, int bytes);
+            //! Load RLE data. The input starts with the size of the channel
+            //! data. Returns the end of the channel data, or zero if the data
+            //! is not valid.
+            static const quint8 * readRle(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            channels,
+                int            bytes,
+                bool           endian);
 
-            //! Load floating point data.
-            //!
-            //! Throws:
-            //! - Core::Error
-            static void floatLoad(Core::FileIO & io, quint8 * out, int size, int channels);
+            //! Load floating point data. The input starts with the size of the
+            //! channel data. Returns the end of the channel data, or zero if the
+            //! data is not valid.
+            static const quint8 * floatLoad(
+                const quint8 * in,
+                const quint8 * end,
+                quint8 *       out,
+                int            size,
+                int            channels,
+                bool           endian);
 
             //! Skip file data.
             //!
@@ -90,22 +90,39 @@ namespace djv
             const int bytes = Pixel::channelByteCount(_info.pixel);
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("bytes = " << bytes);
-            quint8 * data_p = p->data();
-            for (int y = 0; y < h; ++y, data_p += w * channels * bytes)
+            const quint8 * const start = io.mmapP() - io.pos();
+            const quint8 * const end = io.mmapEnd();
+            const quint64        scanlineByteCount = w * channels * bytes;
+            const bool           f32 = Pixel::F32 == Pixel::type(_info.pixel);
+            const bool           endian = io.endian();
+            quint8 * const       data_p = p->data();
+
+            // The scanline table gives the start of each scanline, so the
+            // scanlines can be decoded in parallel.
+            parallelDecode(h, w, [&](int y0, int y1)
             {
-                io.setPos(_rleOffset[y]);
-                for (int c = 0; c < channels; ++c)
+                for (int y = y0; y < y1; ++y)
                 {
-                    if (Pixel::F32 == Pixel::type(_info.pixel))
+                    const quint8 * in = 0;
+                    if (_rleOffset[y] >= 0 && _rleOffset[y] < end - start)
+                    {
+                        in = start + _rleOffset[y];
+                    }
+                    quint8 * outP = data_p + y * scanlineByteCount;
+                    for (int c = 0; c < channels && in; ++c)
                     {
-                        RLA::floatLoad(io, data_p + c * bytes, w, channels);
+                        in = f32 ?
+                            RLA::floatLoad(in, end, outP + c * bytes, w, channels, endian) :
+                            RLA::readRle(in, end, outP + c * bytes, w, channels, bytes, endian);
                     }
-                    else
+                    if (!in)
                     {
-                        RLA::readRle(io, data_p + c * bytes, w, channels, bytes);
+                        throw Core::Error(
+                            RLA::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                     }
                 }
-            }
+            });
 
             // Proxy scale the image.
             if (frame.proxy)
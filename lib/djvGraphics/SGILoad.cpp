@@ -71,21 +71,35 @@ namespace djv
                 _file.fileName(frame.frame != -1 ? frame.frame : _file.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
-            Core::FileIO io;
-            _open(fileName, info, io);
+            QScopedPointer<Core::FileIO> io(new Core::FileIO);
+            _open(fileName, info, *io);
 
             // Read the file.
-            io.readAhead();
-            const quint64 pos = io.pos();
-            const quint64 size = io.size() - pos;
+            io->readAhead();
+            const quint64 pos = io->pos();
+            const quint64 size = io->size() - pos;
             const int     channels = Pixel::channels(info.pixel);
             const int     bytes = Pixel::channelByteCount(info.pixel);
             if (!_compression)
             {
+                // Images with a single channel have the same layout whether they
+                // are planar or interleaved, so they can reference the file.
+                if (1 == channels && mapPixelData(frame.proxy ? _tmp : image, info, io))
+                {
+                    if (frame.proxy)
+                    {
+                        info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                        info.proxy = frame.proxy;
+                        image.set(info);
+                        PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                        _tmp.close();
+                    }
+                    return;
+                }
                 if (1 == bytes)
                 {
-                    const quint8 * p = io.mmapP();
-                    io.seek(PixelDataUtil::dataByteCount(info));
+                    const quint8 * p = io->mmapP();
+                    io->seek(PixelDataUtil::dataByteCount(info));
                     _tmp.set(info, p);
                 }
                 else
@@ -97,37 +111,44 @@ namespace djv
                             ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                     }
                     _tmp.set(info);
-                    io.get(_tmp.data(), size / bytes, bytes);
+                    io->get(_tmp.data(), size / bytes, bytes);
                 }
             }
             else
             {
                 _tmp.set(info);
                 std::vector<quint8> tmp(size);
-                io.get(tmp.data(), size / bytes, bytes);
+                io->get(tmp.data(), size / bytes, bytes);
                 const quint8 * inP = tmp.data();
                 const quint8 * end = inP + size;
                 quint8 *       outP = _tmp.data();
-                for (int c = 0; c < channels; ++c)
+                const quint64  scanlineByteCount = info.size.x * bytes;
+                const bool     endian = io->endian();
+
+                // Every row of every channel has an entry in the offset table,
+                // so the rows can be decoded in parallel.
+                parallelDecode(channels * info.size.y, info.size.x, [&](int y0, int y1)
                 {
-                    //DJV_DEBUG_PRINT("channel = " << c);
-                    for (int y = 0; y < info.size.y; ++y, outP += info.size.x * bytes)
+                    for (int y = y0; y < y1; ++y)
                     {
                         //DJV_DEBUG_PRINT("y = " << y);
-                        if (!SGI::readRle(
-                            inP + _rleOffset[y + info.size.y * c] - pos,
-                            end,
-                            outP,
-                            info.size.x,
-                            bytes,
-                            io.endian()))
+                        const quint32 offset = _rleOffset[y];
+                        if (offset < pos ||
+                            offset - pos >= size ||
+                            !SGI::readRle(
+                                inP + (offset - pos),
+                                end,
+                                outP + y * scanlineByteCount,
+                                info.size.x,
+                                bytes,
+                                endian))
                         {
                             throw Core::Error(
                                 SGI::staticName,
                                 ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                         }
                     }
-                }
+                });
             }
 
             // Interleave the image channels.
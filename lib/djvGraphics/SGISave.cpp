@@ -102,8 +102,7 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
             _tmp.set(p->info());
@@ -122,26 +121,41 @@ namespace djv
             }
             else
             {
-                std::vector<quint8> scanline(w * bytes * 2);
-                for (int c = 0; c < channels; ++c)
+                // Compress the rows in parallel and then write them in order,
+                // so the file is the same for any number of threads.
+                const quint8 * const tmpP = _tmp.data();
+                const bool           endian = io.endian();
+                std::vector<std::vector<quint8> > rows(channels * h);
+                parallelEncode(channels * h, w, [&](int i0, int i1)
                 {
-                    for (int y = 0; y < h; ++y)
+                    std::vector<quint8> scanline(w * bytes * 2);
+                    for (int i = i0; i < i1; ++i)
                     {
                         const quint64 size = SGI::writeRle(
-                            _tmp.data() + (c * h + y) * w * bytes,
+                            tmpP + static_cast<quint64>(i) * w * bytes,
                             scanline.data(),
                             w,
                             bytes,
-                            io.endian());
-                        _rleOffset[y + c * h] = quint32(io.pos());
-                        _rleSize[y + c * h] = quint32(size);
-                        io.set(scanline.data(), size / bytes, bytes);
+                            endian);
+                        rows[i].assign(scanline.data(), scanline.data() + size);
                     }
+                });
+                std::vector<Core::FileIO::Block> blocks;
+                quint64 pos = io.pos();
+                for (int i = 0; i < channels * h; ++i)
+                {
+                    _rleOffset[i] = quint32(pos);
+                    _rleSize[i] = quint32(rows[i].size());
+                    blocks.push_back(Core::FileIO::Block(rows[i].data(), rows[i].size() / bytes, bytes));
+                    pos += rows[i].size();
                 }
+                io.set(blocks);
                 io.setPos(512);
                 io.setU32(_rleOffset.data(), h * channels);
                 io.setU32(_rleSize.data(), h * channels);
             }
+
+            io.close();
         }
 
     } // namespace Graphics
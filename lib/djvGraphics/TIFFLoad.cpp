@@ -33,11 +33,62 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Math.h>
+
+#include <vector>
 
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            ::TIFF * tiffOpen(const QString & fileName)
+            {
+#if defined(DJV_WINDOWS)
+                ::TIFF * f = TIFFOpenW(Core::StringUtil::qToStdWString(fileName).data(), "r");
+#else
+                ::TIFF * f = TIFFOpen(fileName.toUtf8().data(), "r");
+#endif // DJV_WINDOWS
+                if (!f)
+                {
+                    throw Core::Error(
+                        TIFF::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
+                }
+                return f;
+            }
+
+            //! This class provides a TIFF handle for a thread. A libtiff handle
+            //! can not be shared between threads, so the other threads open the
+            //! file again.
+            class Handle
+            {
+            public:
+                Handle(::TIFF * f, const QString & fileName) :
+                    _f(f ? f : tiffOpen(fileName)),
+                    _owner(!f)
+                {}
+
+                ~Handle()
+                {
+                    if (_owner)
+                    {
+                        TIFFClose(_f);
+                    }
+                }
+
+                ::TIFF * f() const { return _f; }
+
+            private:
+                DJV_PRIVATE_COPY(Handle);
+
+                ::TIFF * _f = nullptr;
+                bool     _owner = false;
+            };
+
+        } // namespace
+
         TIFFLoad::TIFFLoad(const QPointer<Core::CoreContext> & context) :
             ImageLoad(context)
         {}
@@ -75,29 +126,124 @@ namespace djv
             _open(fileName, info);
             image.tags = info.tags;
 
-            // Read the file.
-            PixelData * data = frame.proxy ? &_tmp : &image;
+            // Read the file. When the proxy uses the nearest pixels only the
+            // scanlines that are needed are copied, and strips or tiles that do
+            // not contain any of them are skipped.
+            const glm::ivec2 size = info.size;
+            const bool nearest =
+                frame.proxy &&
+                !_palette &&
+                PixelDataUtil::PROXY_FILTER_NEAREST == PixelDataUtil::proxyFilter();
+            const int  proxyScale = PixelDataUtil::proxyScale(frame.proxy);
+            PixelData * data = &image;
+            if (nearest)
+            {
+                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                info.proxy = frame.proxy;
+            }
+            else if (frame.proxy)
+            {
+                data = &_tmp;
+            }
             data->set(info);
-            for (int y = 0; y < info.size.y; ++y)
+
+            // Strips are treated as tiles that are as wide as the image.
+            const glm::ivec2 blockSize(
+                _tiled ? _blockSize.x : size.x,
+                Core::Math::min(_blockSize.y, size.y));
+            const glm::ivec2 blocks(
+                (size.x + blockSize.x - 1) / blockSize.x,
+                (size.y + blockSize.y - 1) / blockSize.y);
+            const int      pixelByteCount = Pixel::byteCount(info.pixel);
+            const int      channelByteCount = Pixel::channelByteCount(info.pixel);
+            const int      rawPixelByteCount = _palette ? channelByteCount : pixelByteCount;
+            const tmsize_t rawRowByteCount = _tiled ? TIFFTileRowSize(_f) : TIFFScanlineSize(_f);
+            const tmsize_t blockByteCount = _tiled ? TIFFTileSize(_f) : TIFFStripSize(_f);
+            quint8 * const dataP = data->data();
+            const quint64  scanlineByteCount = data->scanlineByteCount();
+            //DJV_DEBUG_PRINT("tiled = " << _tiled);
+            //DJV_DEBUG_PRINT("blocks = " << blocks);
+            //DJV_DEBUG_PRINT("block size = " << blockSize);
+
+            // Strips with the same layout as the pixel data are decoded
+            // directly into it.
+            const bool direct =
+                !_tiled &&
+                !nearest &&
+                !_palette &&
+                static_cast<quint64>(rawRowByteCount) == scanlineByteCount;
+            //DJV_DEBUG_PRINT("direct = " << direct);
+
+            parallelDecode(blocks.x * blocks.y, blockSize.x * blockSize.y, [&](int i0, int i1)
             {
-                if (TIFFReadScanline(_f, (tdata_t *)data->data(0, y), y) == -1)
+                const Handle handle(0 == i0 ? _f : nullptr, fileName);
+                std::vector<quint8> buf(direct ? 0 : blockByteCount);
+                for (int i = i0; i < i1; ++i)
                 {
-                    throw Core::Error(
-                        TIFF::staticName,
-                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                    const int x0 = (i % blocks.x) * blockSize.x;
+                    const int y0 = (i / blocks.x) * blockSize.y;
+                    const int x1 = Core::Math::min(x0 + blockSize.x, size.x);
+                    const int y1 = Core::Math::min(y0 + blockSize.y, size.y);
+                    if (nearest && (y0 + proxyScale - 1) / proxyScale * proxyScale >= y1)
+                    {
+                        continue;
+                    }
+                    quint8 * p = direct ? dataP + y0 * scanlineByteCount : buf.data();
+                    const tmsize_t r = _tiled ?
+                        TIFFReadEncodedTile(
+                            handle.f(),
+                            TIFFComputeTile(handle.f(), x0, y0, 0, 0),
+                            p,
+                            -1) :
+                        TIFFReadEncodedStrip(
+                            handle.f(),
+                            TIFFComputeStrip(handle.f(), y0, 0),
+                            p,
+                            direct ? (y1 - y0) * scanlineByteCount : -1);
+                    if (-1 == r)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                    }
+                    if (direct)
+                    {
+                        continue;
+                    }
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        const quint8 * rowP = buf.data() + (y - y0) * rawRowByteCount;
+                        if (nearest)
+                        {
+                            if (0 == y % proxyScale)
+                            {
+                                PixelDataUtil::proxyScaleScanline(
+                                    rowP,
+                                    dataP + (y / proxyScale) * scanlineByteCount + (x0 / proxyScale) * pixelByteCount,
+                                    (x1 - x0 + proxyScale - 1) / proxyScale,
+                                    pixelByteCount,
+                                    frame.proxy);
+                            }
+                        }
+                        else
+                        {
+                            quint8 * outP = dataP + y * scanlineByteCount + x0 * pixelByteCount;
+                            memcpy(outP, rowP, (x1 - x0) * rawPixelByteCount);
+                            if (_palette)
+                            {
+                                TIFF::paletteLoad(
+                                    outP,
+                                    x1 - x0,
+                                    channelByteCount,
+                                    _colormap[0], _colormap[1], _colormap[2]);
+                            }
+                        }
+                    }
                 }
-                if (_palette)
-                {
-                    TIFF::paletteLoad(
-                        data->data(0, y),
-                        info.size.x,
-                        Pixel::channelByteCount(info.pixel),
-                        _colormap[0], _colormap[1], _colormap[2]);
-                }
-            }
+            });
 
             // Proxy scaling.
-            if (frame.proxy)
+            if (frame.proxy && !nearest)
             {
                 info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
                 info.proxy = frame.proxy;
@@ -127,17 +273,7 @@ namespace djv
             close();
 
             // Open the file.
-#if defined(DJV_WINDOWS)
-            _f = TIFFOpenW(Core::StringUtil::qToStdWString(in).data(), "r");
-#else
-            _f = TIFFOpen(in.toUtf8().data(), "r");
-#endif // DJV_WINDOWS
-            if (!_f)
-            {
-                throw Core::Error(
-                    TIFF::staticName,
-                    ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
-            }
+            _f = tiffOpen(in);
 
             // Read the Header.
             uint32   width = 0;
@@ -164,12 +300,27 @@ namespace djv
             TIFFGetFieldDefaulted(_f, TIFFTAG_PLANARCONFIG, &channels);
             TIFFGetFieldDefaulted(_f, TIFFTAG_COLORMAP,
                 &_colormap[0], &_colormap[1], &_colormap[2]);
+            _tiled = TIFFIsTiled(_f) ? true : false;
+            uint32 blockWidth = 0;
+            uint32 blockHeight = 0;
+            if (_tiled)
+            {
+                TIFFGetField(_f, TIFFTAG_TILEWIDTH, &blockWidth);
+                TIFFGetField(_f, TIFFTAG_TILELENGTH, &blockHeight);
+            }
+            else
+            {
+                blockWidth = width;
+                TIFFGetFieldDefaulted(_f, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+            }
 
             //DJV_DEBUG_PRINT("tiff size = " << width << " " << height);
             //DJV_DEBUG_PRINT("tiff photometric = " << photometric);
             //DJV_DEBUG_PRINT("tiff samples = " << samples);
             //DJV_DEBUG_PRINT("tiff sample depth = " << sampleDepth);
             //DJV_DEBUG_PRINT("tiff channels = " << channels);
+            //DJV_DEBUG_PRINT("tiff tiled = " << _tiled);
+            //DJV_DEBUG_PRINT("tiff block size = " << blockWidth << " " << blockHeight);
 
             // Get file information.
             info.fileName = in;
@@ -210,6 +361,15 @@ namespace djv
                     TIFF::staticName,
                     ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
             }
+            if (!blockWidth || !blockHeight)
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+            }
+            _blockSize = glm::ivec2(
+                Core::Math::min<uint32>(blockWidth, width),
+                Core::Math::min<uint32>(blockHeight, height));
             info.pixel = pixel;
             _compression = compression != COMPRESSION_NONE;
             _palette = PHOTOMETRIC_PALETTE == photometric;
@@ -57,6 +57,8 @@ namespace djv
             bool           _compression = false;
             bool           _palette     = false;
             uint16 *       _colormap[3] = { nullptr, nullptr, nullptr };
+            bool           _tiled       = false;
+            glm::ivec2     _blockSize   = glm::ivec2(0, 0);
             PixelData      _tmp;
         };
 
@@ -88,8 +88,7 @@ namespace djv
             if (in.info() != _info)
             {
                 //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
+                openGLImage().copy(in, _image);
                 p = &_image;
             }
 
@@ -100,15 +99,29 @@ namespace djv
             }
             else
             {
+                // Compress the scanlines in parallel and then write them in
+                // order, so the file is the same for any number of threads.
                 const int w = p->w(), h = p->h();
                 const int channels = Pixel::channels(p->info().pixel);
-                std::vector<quint8> scanline(w * channels * 2);
+                std::vector<std::vector<quint8> > scanlines(h);
+                parallelEncode(h, w, [&](int y0, int y1)
+                {
+                    std::vector<quint8> scanline(w * channels * 2);
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        const quint64 size = Targa::writeRle(p->data(0, y), scanline.data(), w, channels);
+                        scanlines[y].assign(scanline.data(), scanline.data() + size);
+                    }
+                });
+                std::vector<Core::FileIO::Block> blocks;
                 for (int y = 0; y < h; ++y)
                 {
-                    const quint64 size = Targa::writeRle(p->data(0, y), scanline.data(), w, channels);
-                    io.set(scanline.data(), size);
+                    blocks.push_back(Core::FileIO::Block(scanlines[y].data(), scanlines[y].size()));
                 }
+                io.set(blocks);
             }
+
+            io.close();
         }
 
     } // namespace Graphics
@@ -86,6 +86,11 @@ namespace djv
             _outputGammaWidget = new FloatEditSlider(context);
             _outputGammaWidget->setRange(.01f, 4.f);
 
+            _inputReadWidget = new QComboBox;
+            _inputReadWidget->addItems(Graphics::Cineon::readLabels());
+            _inputReadWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -130,6 +135,19 @@ namespace djv
                 _outputGammaWidget);
             _layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::CineonWidget", "Input Read"),
+                qApp->translate("djv::UI::CineonWidget",
+                    "Set the method used to read Cineon files. Batch reading reads several "
+                    "frames of a sequence at the same time, which can be faster for "
+                    "playback."),
+                context);
+            QFormLayout * formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::CineonWidget", "Method:"),
+                _inputReadWidget);
+            _layout->addWidget(prefsGroupBox);
+
             _layout->addStretch();
 
             // Initialize.
@@ -162,6 +180,9 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[Graphics::Cineon::OUTPUT_FILM_PRINT_OPTION]);
             tmp >> _options.outputFilmPrint;
+            tmp = plugin->option(
+                plugin->options()[Graphics::Cineon::INPUT_READ_OPTION]);
+            tmp >> _options.inputRead;
             widgetUpdate();
 
             // Setup the callbacks.
@@ -205,6 +226,10 @@ namespace djv
                 _outputGammaWidget,
                 SIGNAL(valueChanged(float)),
                 SLOT(outputGammaCallback(float)));
+            connect(
+                _inputReadWidget,
+                SIGNAL(activated(int)),
+                SLOT(inputReadCallback(int)));
         }
 
         void CineonWidget::resetPreferences()
@@ -232,6 +257,9 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     Graphics::Cineon::OUTPUT_FILM_PRINT_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.outputFilmPrint;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::Cineon::INPUT_READ_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.inputRead;
             }
             catch (const QString &)
             {
@@ -293,6 +321,12 @@ namespace djv
             pluginUpdate();
         }
 
+        void CineonWidget::inputReadCallback(int in)
+        {
+            _options.inputRead = static_cast<Graphics::Cineon::READ>(in);
+            pluginUpdate();
+        }
+
         void CineonWidget::pluginUpdate()
         {
             //DJV_DEBUG("CineonWidget::pluginUpdate");
@@ -309,6 +343,9 @@ namespace djv
             tmp << _options.outputFilmPrint;
             plugin()->setOption(
                 plugin()->options()[Graphics::Cineon::OUTPUT_FILM_PRINT_OPTION], tmp);
+            tmp << _options.inputRead;
+            plugin()->setOption(
+                plugin()->options()[Graphics::Cineon::INPUT_READ_OPTION], tmp);
         }
 
         void CineonWidget::widgetUpdate()
@@ -323,7 +360,8 @@ namespace djv
                 _outputColorProfileWidget <<
                 _outputBlackPointWidget <<
                 _outputWhitePointWidget <<
-                _outputGammaWidget);
+                _outputGammaWidget <<
+                _inputReadWidget);
             _inputBlackPointWidget->setVisible(
                 Graphics::Cineon::COLOR_PROFILE_AUTO == _options.inputColorProfile ||
                 Graphics::Cineon::COLOR_PROFILE_FILM_PRINT == _options.inputColorProfile);
@@ -375,6 +413,7 @@ namespace djv
             _outputBlackPointWidget->setValue(_options.outputFilmPrint.black);
             _outputWhitePointWidget->setValue(_options.outputFilmPrint.white);
             _outputGammaWidget->setValue(_options.outputFilmPrint.gamma);
+            _inputReadWidget->setCurrentIndex(_options.inputRead);
         }
 
         CineonWidgetPlugin::CineonWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -66,6 +66,7 @@ namespace djv
             void outputBlackPointCallback(int);
             void outputWhitePointCallback(int);
             void outputGammaCallback(float);
+            void inputReadCallback(int);
             
             void pluginUpdate();
             void widgetUpdate();
@@ -83,6 +84,7 @@ namespace djv
             IntEditSlider * _outputBlackPointWidget = nullptr;
             IntEditSlider * _outputWhitePointWidget = nullptr;
             FloatEditSlider * _outputGammaWidget = nullptr;
+            QComboBox * _inputReadWidget = nullptr;
             QVBoxLayout * _layout = nullptr;
         };
 
@@ -100,6 +100,11 @@ namespace djv
             _endianWidget->setSizePolicy(
                 QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _inputReadWidget = new QComboBox;
+            _inputReadWidget->addItems(Graphics::Cineon::readLabels());
+            _inputReadWidget->setSizePolicy(
+                QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -176,6 +181,19 @@ namespace djv
                 _endianWidget);
             _layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::DPXWidget", "Input Read"),
+                qApp->translate("djv::UI::DPXWidget",
+                    "Set the method used to read DPX files. Batch reading reads several "
+                    "frames of a sequence at the same time, which can be faster for "
+                    "playback."),
+                context);
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::DPXWidget", "Method:"),
+                _inputReadWidget);
+            _layout->addWidget(prefsGroupBox);
+
             _layout->addStretch();
 
             // Initialize.
@@ -217,6 +235,9 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[Graphics::DPX::ENDIAN_OPTION]);
             tmp >> _options.endian;
+            tmp = plugin->option(
+                plugin->options()[Graphics::DPX::INPUT_READ_OPTION]);
+            tmp >> _options.inputRead;
 
             widgetUpdate();
 
@@ -273,6 +294,10 @@ namespace djv
                 _endianWidget,
                 SIGNAL(activated(int)),
                 SLOT(endianCallback(int)));
+            connect(
+                _inputReadWidget,
+                SIGNAL(activated(int)),
+                SLOT(inputReadCallback(int)));
         }
 
         void DPXWidget::resetPreferences()
@@ -315,6 +340,9 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     Graphics::DPX::ENDIAN_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.endian;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::DPX::INPUT_READ_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.inputRead;
             }
             catch (const QString &)
             {
@@ -394,6 +422,12 @@ namespace djv
             pluginUpdate();
         }
 
+        void DPXWidget::inputReadCallback(int in)
+        {
+            _options.inputRead = static_cast<Graphics::Cineon::READ>(in);
+            pluginUpdate();
+        }
+
         void DPXWidget::pluginUpdate()
         {
             QStringList tmp;
@@ -411,6 +445,8 @@ namespace djv
             plugin()->setOption(plugin()->options()[Graphics::DPX::TYPE_OPTION], tmp);
             tmp << _options.endian;
             plugin()->setOption(plugin()->options()[Graphics::DPX::ENDIAN_OPTION], tmp);
+            tmp << _options.inputRead;
+            plugin()->setOption(plugin()->options()[Graphics::DPX::INPUT_READ_OPTION], tmp);
         }
 
         void DPXWidget::widgetUpdate()
@@ -428,7 +464,8 @@ namespace djv
                 _outputGammaWidget <<
                 _versionWidget <<
                 _typeWidget <<
-                _endianWidget);
+                _endianWidget <<
+                _inputReadWidget);
             //DJV_DEBUG_PRINT("input color profile = " << _options.inputColorProfile);
             //DJV_DEBUG_PRINT("output color profile = " << _options.outputColorProfile);
             _inputBlackPointWidget->setVisible(
@@ -485,6 +522,7 @@ namespace djv
             _versionWidget->setCurrentIndex(_options.version);
             _typeWidget->setCurrentIndex(_options.type);
             _endianWidget->setCurrentIndex(_options.endian);
+            _inputReadWidget->setCurrentIndex(_options.inputRead);
         }
 
         DPXWidgetPlugin::DPXWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -30,6 +30,7 @@
 #include <djvUI/FFmpegWidget.h>
 
 #include <djvUI/UIContext.h>
+#include <djvUI/IntEdit.h>
 #include <djvUI/PrefsGroupBox.h>
 
 #include <djvGraphics/ImageIO.h>
@@ -59,6 +60,14 @@ namespace djv
             _qualityWidget->addItems(Graphics::FFmpeg::qualityLabels());
             _qualityWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _threadCountWidget = new IntEdit;
+            _threadCountWidget->setRange(0, 1024);
+            _threadCountWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _decodeCacheWidget = new IntEdit;
+            _decodeCacheWidget->setRange(0, 1024);
+            _decodeCacheWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             QVBoxLayout * layout = new QVBoxLayout(this);
 
@@ -75,6 +84,22 @@ namespace djv
                 _qualityWidget);
             layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::FFmpegWidget", "Decoding"),
+                qApp->translate("djv::UI::FFmpegWidget",
+                    "Set the number of threads used to decode movies, zero picks the number "
+                    "automatically. The decode cache keeps the most recently decoded frames "
+                    "so that stepping backwards does not decode the movie again."),
+                context);
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::FFmpegWidget", "Thread count:"),
+                _threadCountWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::FFmpegWidget", "Decode cache (frames):"),
+                _decodeCacheWidget);
+            layout->addWidget(prefsGroupBox);
+
             layout->addStretch();
 
             // Initialize.
@@ -93,6 +118,14 @@ namespace djv
                 _qualityWidget,
                 SIGNAL(activated(int)),
                 SLOT(qualityCallback(int)));
+            connect(
+                _threadCountWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(threadCountCallback(int)));
+            connect(
+                _decodeCacheWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(decodeCacheCallback(int)));
         }
 
         FFmpegWidget::~FFmpegWidget()
@@ -118,6 +151,12 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     Graphics::FFmpeg::OPTIONS_QUALITY], Qt::CaseInsensitive))
                     tmp >> _options.quality;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::FFmpeg::OPTIONS_THREAD_COUNT], Qt::CaseInsensitive))
+                    tmp >> _options.threadCount;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::FFmpeg::OPTIONS_DECODE_CACHE], Qt::CaseInsensitive))
+                    tmp >> _options.decodeCache;
             }
             catch (const QString &)
             {
@@ -137,6 +176,18 @@ namespace djv
             pluginUpdate();
         }
 
+        void FFmpegWidget::threadCountCallback(int in)
+        {
+            _options.threadCount = in;
+            pluginUpdate();
+        }
+
+        void FFmpegWidget::decodeCacheCallback(int in)
+        {
+            _options.decodeCache = in;
+            pluginUpdate();
+        }
+
         void FFmpegWidget::pluginUpdate()
         {
             QStringList tmp;
@@ -144,13 +195,19 @@ namespace djv
             plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_FORMAT], tmp);
             tmp << _options.quality;
             plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_QUALITY], tmp);
+            tmp << _options.threadCount;
+            plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_THREAD_COUNT], tmp);
+            tmp << _options.decodeCache;
+            plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_DECODE_CACHE], tmp);
         }
 
         void FFmpegWidget::widgetUpdate()
         {
             Core::SignalBlocker signalBlocker(QObjectList() <<
                 _formatWidget <<
-                _qualityWidget);
+                _qualityWidget <<
+                _threadCountWidget <<
+                _decodeCacheWidget);
             try
             {
                 QStringList tmp;
@@ -158,12 +215,18 @@ namespace djv
                 tmp >> _options.format;
                 tmp = plugin()->option(plugin()->options()[Graphics::FFmpeg::OPTIONS_QUALITY]);
                 tmp >> _options.quality;
+                tmp = plugin()->option(plugin()->options()[Graphics::FFmpeg::OPTIONS_THREAD_COUNT]);
+                tmp >> _options.threadCount;
+                tmp = plugin()->option(plugin()->options()[Graphics::FFmpeg::OPTIONS_DECODE_CACHE]);
+                tmp >> _options.decodeCache;
             }
             catch (QString)
             {
             }
             _formatWidget->setCurrentIndex(_options.format);
             _qualityWidget->setCurrentIndex(_options.quality);
+            _threadCountWidget->setValue(_options.threadCount);
+            _decodeCacheWidget->setValue(_options.decodeCache);
         }
 
         FFmpegWidgetPlugin::FFmpegWidgetPlugin(const QPointer<Core::CoreContext> & context) :
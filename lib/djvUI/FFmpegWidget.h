@@ -39,6 +39,8 @@ namespace djv
 {
     namespace UI
     {
+        class IntEdit;
+
         //! This class provides a FFmpeg widget.
         class FFmpegWidget : public ImageIOWidget
         {
@@ -55,6 +57,8 @@ namespace djv
             void pluginCallback(const QString &);
             void formatCallback(int);
             void qualityCallback(int);
+            void threadCountCallback(int);
+            void decodeCacheCallback(int);
 
             void pluginUpdate();
             void widgetUpdate();
@@ -63,6 +67,8 @@ namespace djv
             Graphics::FFmpeg::Options _options;
             QComboBox * _formatWidget = nullptr;
             QComboBox * _qualityWidget = nullptr;
+            IntEdit * _threadCountWidget = nullptr;
+            IntEdit * _decodeCacheWidget = nullptr;
         };
 
         //! This class provides a FFmpeg widget plugin.
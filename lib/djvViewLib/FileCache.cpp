@@ -29,44 +29,94 @@
 
 #include <djvViewLib/FileCache.h>
 
+#include <djvViewLib/FileCachePolicy.h>
 #include <djvViewLib/FilePrefs.h>
 #include <djvViewLib/ViewContext.h>
 
 #include <djvGraphics/Image.h>
 
 #include <djvCore/Assert.h>
-#include <djvCore/ListUtil.h>
 #include <djvCore/Memory.h>
-#include <djvCore/Time.h>
 
 #include <QPointer>
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace djv
 {
     namespace ViewLib
     {
-        FileCacheKey::FileCacheKey() :
-            timestamp(Core::Time::current())
+        FileCacheKey::FileCacheKey()
         {}
 
-        FileCacheKey::FileCacheKey(void * window, qint64 frame) :
+        FileCacheKey::FileCacheKey(void * window, qint64 frame, int layer) :
             window(window),
             frame(frame),
-            timestamp(Core::Time::current())
+            layer(layer)
         {}
 
+        bool FileCacheKey::operator == (const FileCacheKey & other) const
+        {
+            return window == other.window && frame == other.frame && layer == other.layer;
+        }
+
         bool FileCacheKey::operator < (const FileCacheKey & other) const
         {
             if (window != other.window)
             {
                 return window < other.window;
             }
-            return frame < other.frame;
+            if (frame != other.frame)
+            {
+                return frame < other.frame;
+            }
+            return layer < other.layer;
         }
 
+        float FileCacheStats::hitRate() const
+        {
+            const quint64 count = hits + misses;
+            return count ? (hits / static_cast<float>(count) * 100.f) : 0.f;
+        }
+
+        namespace
+        {
+            struct KeyHash
+            {
+                size_t operator () (const FileCacheKey & key) const
+                {
+                    return
+                        std::hash<void *>()(key.window) ^
+                        (std::hash<qint64>()(key.frame) * 31) ^
+                        (std::hash<int>()(key.layer) * 131);
+                }
+            };
+
+            struct Item
+            {
+                FileCacheKey key;
+                std::shared_ptr<Graphics::Image> image;
+                quint64 byteCount = 0;
+            };
+
+            typedef std::list<Item> ItemList;
+
+            //! This struct provides the items for a window.
+            struct WindowItems
+            {
+                quint64 byteCount = 0;
+                std::set<FileCacheKey> keys;
+            };
+
+        } // namespace
+
         struct FileCache::Private
         {
             Private(const QPointer<ViewContext> & context) :
@@ -74,12 +124,37 @@ namespace djv
                 context(context)
             {}
 
-            std::map<FileCacheKey, std::shared_ptr<Graphics::Image> > items;
+            // The items are kept in least recently used order with the most
+            // recently used item at the front of the list.
+            ItemList items;
+            std::unordered_map<FileCacheKey, ItemList::iterator, KeyHash> index;
+            std::map<void *, WindowItems> windows;
+            std::map<void *, std::shared_ptr<AbstractFileCachePolicy> > policies;
+            FileCacheStats stats;
             quint64 maxBytes = 0;
             quint64 cacheBytes = 0;
             QPointer<ViewContext> context;
+
+            void remove(ItemList::iterator);
         };
 
+        void FileCache::Private::remove(ItemList::iterator i)
+        {
+            cacheBytes -= i->byteCount;
+            auto j = windows.find(i->key.window);
+            if (j != windows.end())
+            {
+                j->second.byteCount -= i->byteCount;
+                j->second.keys.erase(i->key);
+                if (j->second.keys.empty())
+                {
+                    windows.erase(j);
+                }
+            }
+            index.erase(i->key);
+            items.erase(i);
+        }
+
         FileCache::FileCache(const QPointer<ViewContext> & context, QObject * parent) :
             QObject(parent),
             _p(new Private(context))
@@ -103,18 +178,45 @@ namespace djv
 
         bool FileCache::hasItem(const FileCacheKey & key)
         {
-            return _p->items.find(key) != _p->items.end();
+            return _p->index.find(key) != _p->index.end();
         }
 
         std::shared_ptr<Graphics::Image> FileCache::item(const FileCacheKey & key) const
         {
-            return _p->items.find(key)->second;
+            auto i = _p->index.find(key);
+            if (i == _p->index.end())
+            {
+                ++_p->stats.misses;
+                return nullptr;
+            }
+            ++_p->stats.hits;
+            _p->items.splice(_p->items.begin(), _p->items, i->second);
+            return i->second->image;
         }
 
-        void FileCache::addItem(const FileCacheKey & key, const std::shared_ptr<Graphics::Image> & item)
+        quint64 FileCache::itemByteCount(const FileCacheKey & key) const
         {
-            _p->items[key] = item;
-            _p->cacheBytes += item->dataByteCount();
+            auto i = _p->index.find(key);
+            return i != _p->index.end() ? i->second->byteCount : 0;
+        }
+
+        void FileCache::addItem(const FileCacheKey & key, const std::shared_ptr<Graphics::Image> & image)
+        {
+            auto i = _p->index.find(key);
+            if (i != _p->index.end())
+            {
+                _p->remove(i->second);
+            }
+            Item item;
+            item.key = key;
+            item.image = image;
+            item.byteCount = image->dataByteCount();
+            _p->items.push_front(item);
+            _p->index[key] = _p->items.begin();
+            auto & window = _p->windows[key.window];
+            window.byteCount += item.byteCount;
+            window.keys.insert(key);
+            _p->cacheBytes += item.byteCount;
             if (_p->cacheBytes > _p->maxBytes)
             {
                 purge();
@@ -125,17 +227,13 @@ namespace djv
 
         void FileCache::clearItems(void * window)
         {
-            auto i = _p->items.begin();
-            while (i != _p->items.end())
+            auto i = _p->windows.find(window);
+            if (i != _p->windows.end())
             {
-                if (window == i->first.window)
-                {
-                    _p->cacheBytes -= i->second->dataByteCount();
-                    i = _p->items.erase(i);
-                }
-                else
+                const std::set<FileCacheKey> keys = i->second.keys;
+                for (const auto & key : keys)
                 {
-                    ++i;
+                    _p->remove(_p->index[key]);
                 }
             }
             Q_EMIT cacheChanged();
@@ -144,59 +242,70 @@ namespace djv
 
         void FileCache::clear()
         {
-            auto i = _p->items.begin();
-            while (i != _p->items.end())
-            {
-                _p->cacheBytes -= i->second->dataByteCount();
-                i = _p->items.erase(i);
-            }
+            _p->items.clear();
+            _p->index.clear();
+            _p->windows.clear();
+            _p->cacheBytes = 0;
             Q_EMIT cacheChanged();
             debug();
         }
 
         void FileCache::removeItem(const FileCacheKey & key)
         {
-            auto i = _p->items.find(key);
-            if (i != _p->items.end())
+            auto i = _p->index.find(key);
+            if (i != _p->index.end())
             {
-                _p->cacheBytes -= i->second->dataByteCount();
-                _p->items.erase(i);
+                _p->remove(i->second);
             }
         }
 
-        std::vector<std::shared_ptr<Graphics::Image> > FileCache::items(void * window)
+        void FileCache::removeFrame(void * window, qint64 frame)
         {
-            std::vector<std::shared_ptr<Graphics::Image> > out;
-            for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
+            auto i = _p->windows.find(window);
+            if (i != _p->windows.end())
             {
-                if (window == i->first.window)
+                const auto & keys = i->second.keys;
+                const auto first = keys.lower_bound(FileCacheKey(window, frame, std::numeric_limits<int>::min()));
+                const std::vector<FileCacheKey> remove(first, std::find_if(
+                    first,
+                    keys.end(),
+                    [frame](const FileCacheKey & key) { return key.frame != frame; }));
+                for (const auto & key : remove)
                 {
-                    out.push_back(i->second);
+                    _p->remove(_p->index[key]);
                 }
             }
-            return out;
         }
 
-        namespace
+        std::vector<std::shared_ptr<Graphics::Image> > FileCache::items(void * window)
         {
-            bool compare(qint64 a, qint64 b)
+            std::vector<std::shared_ptr<Graphics::Image> > out;
+            auto i = _p->windows.find(window);
+            if (i != _p->windows.end())
             {
-                return a < b;
+                for (const auto & key : i->second.keys)
+                {
+                    out.push_back(_p->index[key]->image);
+                }
             }
-
-        } // namespace
+            return out;
+        }
 
         Core::FrameList FileCache::frames(void * window)
         {
             Core::FrameList frames;
-            for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
+            auto i = _p->windows.find(window);
+            if (i != _p->windows.end())
             {
-                if (window == i->first.window)
+                frames.reserve(static_cast<int>(i->second.keys.size()));
+                for (const auto & key : i->second.keys)
                 {
-                    frames.push_back(i->first.frame);
+                    if (frames.isEmpty() || frames.last() != key.frame)
+                    {
+                        frames.push_back(key.frame);
+                    }
                 }
             }
-            qSort(frames.begin(), frames.end(), compare);
             return frames;
         }
 
@@ -212,14 +321,8 @@ namespace djv
 
         float FileCache::currentSizeGB(void * window) const
         {
-            quint64 size = 0;
-            for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
-            {
-                if (window == i->first.window)
-                {
-                    size += i->second->dataByteCount();
-                }
-            }
+            auto i = _p->windows.find(window);
+            const quint64 size = i != _p->windows.end() ? i->second.byteCount : 0;
             return size / static_cast<float>(Core::Memory::gigabyte);
         }
 
@@ -233,6 +336,34 @@ namespace djv
             return _p->cacheBytes;
         }
 
+        std::shared_ptr<AbstractFileCachePolicy> FileCache::policy(void * window) const
+        {
+            auto i = _p->policies.find(window);
+            return i != _p->policies.end() ? i->second : nullptr;
+        }
+
+        void FileCache::setPolicy(void * window, const std::shared_ptr<AbstractFileCachePolicy> & policy)
+        {
+            if (policy)
+            {
+                _p->policies[window] = policy;
+            }
+            else
+            {
+                _p->policies.erase(window);
+            }
+        }
+
+        const FileCacheStats & FileCache::stats() const
+        {
+            return _p->stats;
+        }
+
+        void FileCache::resetStats()
+        {
+            _p->stats = FileCacheStats();
+        }
+
         const QVector<float> & FileCache::sizeGBDefaults()
         {
             static const QVector<float> data = QVector<float>() <<
@@ -257,11 +388,13 @@ namespace djv
             {
                 DJV_DEBUG_PRINT(
                     "item (count = " <<
-                    i->second.use_count() <<
+                    i->image.use_count() <<
                     ") = " <<
-                    reinterpret_cast<qint64>(i->first.window) <<
+                    reinterpret_cast<qint64>(i->key.window) <<
+                    " " <<
+                    i->key.frame <<
                     " " <<
-                    i->first.frame);
+                    i->key.layer);
             }*/
         }
 
@@ -281,22 +414,60 @@ namespace djv
             //DJV_DEBUG("FileCache::purge");
             debug();
 
-            // Delete as many items as possible to bring the cache size below the maximum size.
-            std::map<::time_t, FileCacheKey> sortedByTime;
-            for (auto i : _p->items)
-            {
-                sortedByTime[i.first.timestamp] = i.first;
-            }
-            auto j = sortedByTime.begin();
-            while (_p->cacheBytes > _p->maxBytes && j != sortedByTime.end())
+            // Evict items to bring the cache size below the maximum size. The
+            // least recently used item picks the window to evict from, and the
+            // window's policy picks the item.
+            while (_p->cacheBytes > _p->maxBytes && !_p->items.empty())
             {
-                auto k = _p->items.find(j->second);
-                if (k != _p->items.end())
+                auto i = std::prev(_p->items.end());
+                auto j = _p->policies.find(i->key.window);
+                if (j != _p->policies.end())
                 {
-                    _p->cacheBytes -= k->second->dataByteCount();
-                    _p->items.erase(k);
-                    j = sortedByTime.erase(j);
+                    // The distance only changes direction at the policy's
+                    // breakpoints, so the frame with the largest distance is
+                    // either the first or last cached frame, or a cached frame
+                    // next to a breakpoint. The keys are sorted by frame so
+                    // these are found with a binary search.
+                    void * window = i->key.window;
+                    const auto & keys = _p->windows[window].keys;
+                    const auto first = [window, &keys](qint64 frame)
+                    {
+                        return keys.lower_bound(FileCacheKey(window, frame, std::numeric_limits<int>::min()));
+                    };
+                    std::vector<FileCacheKey> candidates;
+                    candidates.push_back(*keys.begin());
+                    candidates.push_back(*first(keys.rbegin()->frame));
+                    for (const auto frame : j->second->breakpoints())
+                    {
+                        const auto k = first(frame);
+                        if (k != keys.end())
+                        {
+                            candidates.push_back(*k);
+                        }
+                        if (k != keys.begin())
+                        {
+                            candidates.push_back(*first(std::prev(k)->frame));
+                        }
+                    }
+
+                    // Ties are broken by picking the lowest frame and layer.
+                    std::sort(candidates.begin(), candidates.end());
+                    FileCacheKey key = candidates[0];
+                    qint64 distance = -1;
+                    for (const auto & k : candidates)
+                    {
+                        const qint64 tmp = j->second->distance(k.frame);
+                        if (tmp > distance)
+                        {
+                            key = k;
+                            distance = tmp;
+                        }
+                    }
+                    //DJV_DEBUG_PRINT("evict = " << key.frame << " " << key.layer << " " << distance);
+                    i = _p->index[key];
                 }
+                _p->remove(i);
+                ++_p->stats.evictions;
             }
 
             Q_EMIT cacheChanged();
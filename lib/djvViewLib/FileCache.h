@@ -50,21 +50,39 @@ namespace djv
 
     namespace ViewLib
     {
+        class AbstractFileCachePolicy;
         class ViewContext;
 
+        //! This struct provides a file cache key.
         struct FileCacheKey
         {
             FileCacheKey();
-            FileCacheKey(void * window, qint64 frame);
+            FileCacheKey(void * window, qint64 frame, int layer = 0);
 
             void * window = nullptr;
             qint64 frame = 0;
-            ::time_t timestamp = 0;
+            int    layer = 0;
 
+            bool operator == (const FileCacheKey &) const;
             bool operator < (const FileCacheKey &) const;
         };
 
-        //! This class provides the file cache.
+        //! This struct provides file cache statistics.
+        struct FileCacheStats
+        {
+            quint64 hits      = 0;
+            quint64 misses    = 0;
+            quint64 evictions = 0;
+
+            //! Get the hit rate as a percentage.
+            float hitRate() const;
+        };
+
+        //! This class provides the file cache. When the cache size exceeds the
+        //! maximum the least recently used item is found, and if the item's window
+        //! has an eviction policy the policy picks which of the window's items to
+        //! evict, otherwise the least recently used item is evicted.
+
         class FileCache : public QObject
         {
             Q_OBJECT
@@ -76,9 +94,15 @@ namespace djv
             //! Get whether the cache contains an item.
             bool hasItem(const FileCacheKey &);
 
-            //! Get an item from the cache.
+            //! Get an item from the cache. This marks the item as the most recently
+            //! used and updates the hit and miss statistics. If the item is not in
+            //! the cache nullptr is returned.
             std::shared_ptr<Graphics::Image> item(const FileCacheKey &) const;
 
+            //! Get the size of an item in bytes, or zero if the item is not in the
+            //! cache.
+            quint64 itemByteCount(const FileCacheKey &) const;
+
             //! Add an item to the cache.
             void addItem(const FileCacheKey &, const std::shared_ptr<Graphics::Image> &);
 
@@ -91,11 +115,14 @@ namespace djv
             //! Remove an item.
             void removeItem(const FileCacheKey &);
 
+            //! Remove all of the layers of a frame.
+            void removeFrame(void *, qint64 frame);
+
             //! Get the list of items that match the given window.
             std::vector<std::shared_ptr<Graphics::Image> > items(void *);
 
             //! Get the list of frames that match the given window. The frames are sorted in
-            //! ascending order.
+            //! ascending order, frames with several cached layers are only listed once.
             Core::FrameList frames(void *);
 
             //! Get the maximum cache size in gigabytes.
@@ -113,6 +140,19 @@ namespace djv
             //! Get the current cache size in bytes.
             quint64 currentSizeBytes() const;
 
+            //! Get the eviction policy for the given window.
+            std::shared_ptr<AbstractFileCachePolicy> policy(void *) const;
+
+            //! Set the eviction policy for the given window. Items from windows
+            //! without a policy are evicted in least recently used order.
+            void setPolicy(void *, const std::shared_ptr<AbstractFileCachePolicy> &);
+
+            //! Get the cache statistics.
+            const FileCacheStats & stats() const;
+
+            //! Reset the cache statistics.
+            void resetStats();
+
             //! Get the cache size defaults in gigabytes.
             static const QVector<float> & sizeGBDefaults();
 
@@ -132,9 +172,7 @@ namespace djv
             void cacheSizeGBCallback(float);
 
         private:
-            void removeItem(int index);
-
-            // Delete null references only if the cache size exceeds the maximum.
+            // Evict items until the cache size is below the maximum.
             void purge();
 
             DJV_PRIVATE_COPY(FileCache);
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLib/FileCachePolicy.h>
+
+#include <djvCore/Math.h>
+
+#include <limits>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        AbstractFileCachePolicy::~AbstractFileCachePolicy()
+        {}
+
+        const qint64 FileCachePlaybackPolicy::distanceMax = std::numeric_limits<qint64>::max();
+        const qint64 FileCachePlaybackPolicy::behindWeight = 3;
+
+        FileCachePlaybackPolicy::FileCachePlaybackPolicy()
+        {}
+
+        FileCachePlaybackPolicy::~FileCachePlaybackPolicy()
+        {}
+
+        qint64 FileCachePlaybackPolicy::frame() const
+        {
+            return _frame;
+        }
+
+        Enum::PLAYBACK FileCachePlaybackPolicy::playback() const
+        {
+            return _playback;
+        }
+
+        Enum::LOOP FileCachePlaybackPolicy::loop() const
+        {
+            return _loop;
+        }
+
+        qint64 FileCachePlaybackPolicy::start() const
+        {
+            return _start;
+        }
+
+        qint64 FileCachePlaybackPolicy::end() const
+        {
+            return _end;
+        }
+
+        void FileCachePlaybackPolicy::setPlayback(
+            qint64         frame,
+            Enum::PLAYBACK playback,
+            Enum::LOOP     loop,
+            qint64         start,
+            qint64         end)
+        {
+            _start    = start;
+            _end      = Core::Math::max(start, end);
+            _frame    = Core::Math::clamp(frame, _start, _end);
+            _playback = playback;
+            _loop     = loop;
+        }
+
+        qint64 FileCachePlaybackPolicy::distance(qint64 frame) const
+        {
+            if (frame < _start || frame > _end)
+                return distanceMax;
+            const qint64 size = _end - _start + 1;
+
+            // Get the distance ahead of the current frame, following the
+            // playback direction and loop mode.
+            qint64 out = distanceMax;
+            const bool reverse = Enum::REVERSE == _playback;
+            const qint64 ahead = reverse ? _frame - frame : frame - _frame;
+            switch (_loop)
+            {
+            case Enum::LOOP_ONCE:
+                if (ahead >= 0)
+                {
+                    out = ahead;
+                }
+                break;
+            case Enum::LOOP_REPEAT:
+                out = (ahead + size) % size;
+                break;
+            case Enum::LOOP_PING_PONG:
+                if (ahead >= 0)
+                {
+                    out = ahead;
+                }
+                else
+                {
+                    out = reverse ?
+                        (_frame - _start) + (frame - _start) :
+                        (_end - _frame) + (_end - frame);
+                }
+                break;
+            default: break;
+            }
+
+            // When playback is stopped the frames behind the current frame are
+            // also likely to be used.
+            if (Enum::STOP == _playback && ahead < 0)
+            {
+                out = Core::Math::min(out, -ahead * behindWeight);
+            }
+
+            return out;
+        }
+
+        std::vector<qint64> FileCachePlaybackPolicy::breakpoints() const
+        {
+            // The distance changes direction at the ends of the range and at
+            // the current frame. When playback is stopped it also changes
+            // direction behind the current frame, where the weighted distance
+            // meets the looped distance.
+            const qint64 size = _end - _start + 1;
+            const qint64 behind = _frame - size / (behindWeight + 1);
+            return
+            {
+                _start,
+                _frame,
+                _frame + 1,
+                _end + 1,
+                behind - 1,
+                behind,
+                behind + 1
+            };
+        }
+
+    } // namespace ViewLib
+} // namespace djv
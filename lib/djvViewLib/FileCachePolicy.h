@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvViewLib/Enum.h>
+
+#include <vector>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        //! This class provides the base functionality for file cache eviction
+        //! policies. A policy is set on the file cache for each window.
+        class AbstractFileCachePolicy
+        {
+        public:
+            virtual ~AbstractFileCachePolicy() = 0;
+
+            //! Get the distance until the given frame is needed again. When the
+            //! cache is full the frame with the largest distance is evicted first.
+            virtual qint64 distance(qint64 frame) const = 0;
+
+            //! Get the frames where the distance changes direction. Between
+            //! these frames the distance only increases or only decreases, so
+            //! the cache only needs to check the cached frames next to them to
+            //! find the frame with the largest distance.
+            virtual std::vector<qint64> breakpoints() const = 0;
+        };
+
+        //! This class provides a file cache eviction policy that uses the
+        //! playback state. The distance is the number of frames until the
+        //! playhead reaches the frame, following the playback direction and loop
+        //! mode. Frames outside of the in/out range are evicted first.
+        class FileCachePlaybackPolicy : public AbstractFileCachePolicy
+        {
+        public:
+            FileCachePlaybackPolicy();
+            ~FileCachePlaybackPolicy() override;
+
+            //! Get the current frame.
+            qint64 frame() const;
+
+            //! Get the playback.
+            Enum::PLAYBACK playback() const;
+
+            //! Get the loop mode.
+            Enum::LOOP loop() const;
+
+            //! Get the start of the range.
+            qint64 start() const;
+
+            //! Get the end of the range.
+            qint64 end() const;
+
+            //! Set the playback state.
+            void setPlayback(
+                qint64         frame,
+                Enum::PLAYBACK playback,
+                Enum::LOOP     loop,
+                qint64         start,
+                qint64         end);
+
+            qint64 distance(qint64 frame) const override;
+            std::vector<qint64> breakpoints() const override;
+
+            //! The distance for frames that are not needed again.
+            static const qint64 distanceMax;
+
+            //! The weight for frames behind the current frame when playback is
+            //! stopped. This matches the portion of the cache that is pre-loaded
+            //! ahead of the current frame.
+            static const qint64 behindWeight;
+
+        private:
+            qint64         _frame    = 0;
+            Enum::PLAYBACK _playback = Enum::STOP;
+            Enum::LOOP     _loop     = Enum::LOOP_REPEAT;
+            qint64         _start    = 0;
+            qint64         _end      = 0;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
@@ -31,8 +31,10 @@
 
 #include <djvViewLib/FileActions.h>
 #include <djvViewLib/FileCache.h>
+#include <djvViewLib/FileCachePolicy.h>
 #include <djvViewLib/FileMenu.h>
 #include <djvViewLib/FilePrefs.h>
+#include <djvViewLib/FilePreload.h>
 #include <djvViewLib/FileToolBar.h>
 #include <djvViewLib/ImagePrefs.h>
 #include <djvViewLib/ImageView.h>
@@ -52,6 +54,7 @@
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/FilePrefetch.h>
 #include <djvCore/ListUtil.h>
 
 #include <QAction>
@@ -61,22 +64,54 @@
 #include <QMenuBar>
 #include <QToolBar>
 
+#include <set>
+
 namespace djv
 {
     namespace ViewLib
     {
+        namespace
+        {
+            //! Get the next frame to pre-load in the given direction, or -1 if there
+            //! are no more frames.
+            qint64 preloadNext(qint64 frame, int & direction, qint64 start, qint64 end, Enum::LOOP loop)
+            {
+                frame += direction;
+                if (frame < start || frame > end)
+                {
+                    switch (loop)
+                    {
+                    case Enum::LOOP_REPEAT:
+                        frame = frame > end ? start : end;
+                        break;
+                    case Enum::LOOP_PING_PONG:
+                        direction = -direction;
+                        frame = Core::Math::clamp(frame + direction * 2, start, end);
+                        break;
+                    default:
+                        frame = -1;
+                        break;
+                    }
+                }
+                return frame;
+            }
+
+        } // namespace
+
         struct FileGroup::Private
         {
             Private(const QPointer<ViewContext> & context) :
                 proxy(context->filePrefs()->proxy()),
                 u8Conversion(context->filePrefs()->hasU8Conversion()),
                 cacheEnabled(context->filePrefs()->isCacheEnabled()),
+                cacheLayers(context->filePrefs()->hasCacheLayers()),
                 preload(context->filePrefs()->hasPreload())
             {}
 
             Core::FileInfo fileInfo;
             Graphics::ImageIOInfo imageIOInfo;
             std::shared_ptr<Graphics::Image> image;
+            qint64 imageFrame = -1;
             QScopedPointer<Graphics::ImageLoad> imageLoad;
             std::unique_ptr<Graphics::OpenGLImage> openGLImage;
             int layer = 0;
@@ -84,10 +119,17 @@ namespace djv
             Graphics::PixelDataInfo::PROXY proxy = static_cast<Graphics::PixelDataInfo::PROXY>(0);
             bool u8Conversion = false;
             bool cacheEnabled = false;
+            bool cacheLayers = false;
             bool preload = false;
-            bool preloadActive = false;
-            int preloadTimer = 0;
             qint64 preloadFrame = 0;
+            Enum::PLAYBACK preloadPlayback = Enum::STOP;
+            Enum::LOOP preloadLoop = Enum::LOOP_REPEAT;
+            int preloadStep = 1;
+            qint64 preloadStart = 0;
+            qint64 preloadEnd = 0;
+            std::unique_ptr<FilePreload> preloader;
+            std::unique_ptr<Core::FilePrefetch> prefetch;
+            std::shared_ptr<FileCachePlaybackPolicy> cachePolicy;
             QPointer<FileActions> actions;
             QPointer<FileMenu> menu;
             QPointer<FileToolBar> toolBar;
@@ -109,6 +151,7 @@ namespace djv
                 _p->proxy = copy->_p->proxy;
                 _p->u8Conversion = copy->_p->u8Conversion;
                 _p->cacheEnabled = copy->_p->cacheEnabled;
+                _p->cacheLayers = copy->_p->cacheLayers;
                 _p->preload = copy->_p->preload;
             }
 
@@ -124,6 +167,10 @@ namespace djv
             mainWindow->addToolBar(_p->toolBar);
 
             // Initialize.
+            _p->preloader.reset(new FilePreload(context));
+            _p->prefetch.reset(new Core::FilePrefetch);
+            _p->cachePolicy.reset(new FileCachePlaybackPolicy);
+            context->fileCache()->setPolicy(mainWindow, _p->cachePolicy);
             if (copy)
             {
                 open(_p->fileInfo);
@@ -231,12 +278,20 @@ namespace djv
                 context->filePrefs(),
                 SIGNAL(cacheSizeGBChanged(float)),
                 SLOT(preloadUpdate()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheLayersChanged(bool)),
+                SLOT(cacheLayersCallback(bool)));
             connect(
                 context->filePrefs(),
                 SIGNAL(preloadChanged(bool)),
                 SLOT(setPreload(bool)));
 
             // Setup other callbacks.
+            connect(
+                _p->preloader.get(),
+                SIGNAL(imagesLoaded()),
+                SLOT(preloadCallback()));
             connect(
                 context->imageIOFactory(),
                 SIGNAL(optionChanged()),
@@ -245,13 +300,11 @@ namespace djv
 
         FileGroup::~FileGroup()
         {
-            if (_p->preloadTimer)
-            {
-                killTimer(_p->preloadTimer);
-                _p->preloadTimer = 0;
-            }
+            _p->preloader.reset();
+            _p->prefetch.reset();
             _p->image.reset();
             cacheDel();
+            context()->fileCache()->setPolicy(mainWindow(), nullptr);
             context()->makeGLContextCurrent();
             _p->openGLImage.reset();
         }
@@ -286,11 +339,6 @@ namespace djv
             return _p->preload;
         }
 
-        bool FileGroup::isPreloadActive() const
-        {
-            return _p->preloadActive;
-        }
-
         qint64 FileGroup::preloadFrame() const
         {
             return _p->preloadFrame;
@@ -303,27 +351,55 @@ namespace djv
             context()->makeGLContextCurrent();
             FileGroup * that = const_cast<FileGroup *>(this);
             FileCache * cache = context()->fileCache();
-            const auto key = FileCacheKey(mainWindow(), frame);
-            if (cache->hasItem(key))
+            const auto key = FileCacheKey(mainWindow(), frame, _p->layer);
+            if (auto image = cache->item(key))
             {
-                _p->image = cache->item(key);
+                _p->image = image;
+                _p->imageFrame = frame;
+            }
+            else if (
+                _p->cacheEnabled &&
+                _p->preload &&
+                _p->preloadPlayback != Enum::STOP &&
+                _p->image &&
+                (_p->preloader->isPending(frame) || _p->preloadStep > 1))
+            {
+                // Skip the frame during playback, it will be added to the cache
+                // by the pre-load threads. When frames are being dropped the
+                // frame may not be queued yet, but it is queued first when the
+                // pre-load frame is set.
             }
             else
             {
+                // When all of the layers are cached they are loaded together,
+                // so that changing layers does not read the file again.
+                const QVector<int> layers = loadLayers();
+                std::vector<std::shared_ptr<Graphics::Image> > images;
                 if (_p->imageLoad.data())
                 {
                     //DJV_DEBUG_PRINT("loading image");
-                    auto image = std::shared_ptr<Graphics::Image>(new Graphics::Image);
+                    QVector<Graphics::Image *> pointers;
+                    for (int i = 0; i < layers.count(); ++i)
+                    {
+                        images.push_back(std::shared_ptr<Graphics::Image>(new Graphics::Image));
+                        pointers += images.back().get();
+                    }
                     try
                     {
-                        _p->imageLoad->read(
-                            *image,
-                            Graphics::ImageIOFrameInfo(
-                                _p->imageIOInfo.sequence.frames.count() ?
-                                _p->imageIOInfo.sequence.frames[frame] :
-                                -1,
-                                _p->layer,
-                                _p->proxy));
+                        const Graphics::ImageIOFrameInfo frameInfo(
+                            _p->imageIOInfo.sequence.frames.count() ?
+                            _p->imageIOInfo.sequence.frames[frame] :
+                            -1,
+                            _p->layer,
+                            _p->proxy);
+                        if (layers.count() > 1)
+                        {
+                            _p->imageLoad->readLayers(pointers, layers, frameInfo);
+                        }
+                        else
+                        {
+                            _p->imageLoad->read(*images[0], frameInfo);
+                        }
                     }
                     catch (Core::Error error)
                     {
@@ -336,17 +412,20 @@ namespace djv
                     {
                         if (_p->u8Conversion)
                         {
-                            //DJV_DEBUG_PRINT("u8 conversion");
-                            //DJV_DEBUG_PRINT("image = " << _p->imageTmp2);
-                            Graphics::PixelDataInfo info(image->info());
-                            info.pixel = Graphics::Pixel::pixel(Graphics::Pixel::format(info.pixel), Graphics::Pixel::U8);
-                            auto tmp = image;
-                            image = std::shared_ptr<Graphics::Image>(new Graphics::Image(info));
-                            image->tags = tmp->tags;
-                            Graphics::OpenGLImageOptions options;
-                            options.colorProfile = tmp->colorProfile;
-                            options.proxyScale = false;
-                            _p->openGLImage->copy(*tmp, *image, options);
+                            for (auto & image : images)
+                            {
+                                //DJV_DEBUG_PRINT("u8 conversion");
+                                //DJV_DEBUG_PRINT("image = " << *image);
+                                Graphics::PixelDataInfo info(image->info());
+                                info.pixel = Graphics::Pixel::pixel(Graphics::Pixel::format(info.pixel), Graphics::Pixel::U8);
+                                auto tmp = image;
+                                image = std::shared_ptr<Graphics::Image>(new Graphics::Image(info));
+                                image->tags = tmp->tags;
+                                Graphics::OpenGLImageOptions options;
+                                options.colorProfile = tmp->colorProfile;
+                                options.proxyScale = false;
+                                _p->openGLImage->copy(*tmp, *image, options);
+                            }
                         }
                     }
                     catch (Core::Error error)
@@ -356,12 +435,20 @@ namespace djv
                             arg(QDir::toNativeSeparators(_p->fileInfo)));
                         context()->printError(error);
                     }
-                    that->_p->image = image;
+                    that->_p->image = images[layers.indexOf(_p->layer)];
+                    that->_p->imageFrame = frame;
                     //DJV_DEBUG_PRINT("image = " << *that->_p->image);
                 }
                 if (_p->cacheEnabled && _p->image)
                 {
                     //DJV_DEBUG_PRINT("cache image");
+                    for (int i = 0; i < layers.count() && i < static_cast<int>(images.size()); ++i)
+                    {
+                        if (layers[i] != _p->layer && images[i]->isValid())
+                        {
+                            cache->addItem(FileCacheKey(mainWindow(), frame, layers[i]), images[i]);
+                        }
+                    }
                     cache->addItem(key, _p->image);
                 }
             }
@@ -392,6 +479,7 @@ namespace djv
             _p->fileInfo = Core::FileInfo();
             _p->imageIOInfo = Graphics::ImageIOInfo();
             _p->image.reset();
+            _p->imageFrame = -1;
             _p->imageLoad.reset();
 
             // Load the file.
@@ -420,6 +508,7 @@ namespace djv
                 _p->layers += _p->imageIOInfo[i].layerName;
             }
 
+            preloadOpen();
             preloadUpdate();
             update();
         }
@@ -434,7 +523,11 @@ namespace djv
             //DJV_DEBUG_PRINT("layer list = " << size);
             _p->layer = Core::Math::wrap(layer, 0, count - 1);
             //DJV_DEBUG_PRINT("layer = " << _layer);
-            cacheDel();
+            if (!_p->cacheLayers)
+            {
+                cacheDel();
+            }
+            preloadOpen();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -448,6 +541,7 @@ namespace djv
             //DJV_DEBUG_PRINT("proxy = " << proxy);
             _p->proxy = proxy;
             cacheDel();
+            preloadOpen();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -459,6 +553,7 @@ namespace djv
                 return;
             _p->u8Conversion = conversion;
             cacheDel();
+            preloadOpen();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -472,6 +567,7 @@ namespace djv
             //DJV_DEBUG_PRINT("cache = " << cache);
             _p->cacheEnabled = cache;
             cacheDel();
+            preloadOpen();
             preloadUpdate();
             update();
             Q_EMIT imageChanged();
@@ -488,17 +584,6 @@ namespace djv
             update();
         }
 
-        void FileGroup::setPreloadActive(bool active)
-        {
-            if (active == _p->preloadActive)
-                return;
-            //DJV_DEBUG("FileGroup::setPreloadActive");
-            //DJV_DEBUG_PRINT("active = " << active);
-            _p->preloadActive = active;
-            preloadUpdate();
-            update();
-        }
-
         void FileGroup::setPreloadFrame(qint64 frame)
         {
             if (frame == _p->preloadFrame)
@@ -508,94 +593,46 @@ namespace djv
             update();
         }
 
-        void FileGroup::timerEvent(QTimerEvent *)
+        void FileGroup::setPreloadPlayback(Enum::PLAYBACK playback)
         {
-            //DJV_DEBUG("FileGroup::timerEvent");
-            //DJV_DEBUG_PRINT("preload frame        = " << _p->preloadFrame);
+            if (playback == _p->preloadPlayback)
+                return;
+            //DJV_DEBUG("FileGroup::setPreloadPlayback");
+            //DJV_DEBUG_PRINT("playback = " << playback);
+            _p->preloadPlayback = playback;
+            preloadUpdate();
 
-            FileCache * cache = context()->fileCache();
-            //DJV_DEBUG_PRINT("cache byte count     = " << cache->currentSizeBytes());
-            //DJV_DEBUG_PRINT("cache max byte count = " << cache->maxSizeBytes());
-
-            const auto items = cache->items(mainWindow());
-
-            // Search for the next frame that isn't in the cache.
-            bool      preload = false;
-            quint64   byteCount = 0;
-            qint64    frame = _p->preloadFrame;
-            int       frameCount = 0;
-            const int totalFrames = _p->imageIOInfo.sequence.frames.count();
-            for (;
-                byteCount <= cache->maxSizeBytes() &&
-                frameCount < totalFrames;
-                frame = Core::Math::wrap<qint64>(frame + 1, 0, totalFrames - 1), ++frameCount)
+            // Update the image in case the current frame was skipped.
+            if (Enum::STOP == playback && _p->imageFrame != _p->preloadFrame)
             {
-                const auto key = FileCacheKey(mainWindow(), frame);
-                if (cache->hasItem(key))
-                {
-                    byteCount += cache->item(key)->dataByteCount();
-                }
-                else
-                {
-                    byteCount += Graphics::PixelDataUtil::dataByteCount(_p->imageIOInfo);
-                    if (byteCount <= cache->maxSizeBytes())
-                    {
-                        preload = true;
-                    }
-                    break;
-                }
+                Q_EMIT imageChanged();
             }
-            //DJV_DEBUG_PRINT("byteCount = " << byteCount);
-            //DJV_DEBUG_PRINT("preload   = " << preload);
-            //DJV_DEBUG_PRINT("frame     = " << frame);
+        }
 
-            if (preload)
-            {
-                context()->makeGLContextCurrent();
-                auto image = std::shared_ptr<Graphics::Image>(new Graphics::Image);
-                if (_p->imageLoad.data())
-                {
-                    //DJV_DEBUG_PRINT("loading image");
-                    try
-                    {
-                        _p->imageLoad->read(
-                            *image,
-                            Graphics::ImageIOFrameInfo(
-                                _p->imageIOInfo.sequence.frames.count() ?
-                                _p->imageIOInfo.sequence.frames[frame] :
-                                -1,
-                                _p->layer,
-                                _p->proxy));
-                        if (image->isValid() && _p->u8Conversion)
-                        {
-                            //DJV_DEBUG_PRINT("u8 conversion");
-                            //DJV_DEBUG_PRINT("image = " << *image);
-                            Graphics::PixelDataInfo info(image->info());
-                            info.pixel = Graphics::Pixel::pixel(Graphics::Pixel::format(info.pixel), Graphics::Pixel::U8);
-                            auto tmp = image;
-                            image = std::shared_ptr<Graphics::Image>(new Graphics::Image(info));
-                            image->tags = tmp->tags;
-                            Graphics::OpenGLImageOptions options;
-                            options.colorProfile = tmp->colorProfile;
-                            options.proxyScale = false;
-                            _p->openGLImage->copy(*tmp, *image, options);
-                        }
-                    }
-                    catch (const Core::Error &)
-                    {
-                    }
-                }
-                if (image->isValid())
-                {
-                    //DJV_DEBUG_PRINT("image = " << *image);
-                    cache->addItem(FileCacheKey(mainWindow(), frame), image);
-                }
-            }
-            else
-            {
-                killTimer(_p->preloadTimer);
-                _p->preloadTimer = 0;
-            }
+        void FileGroup::setPreloadLoop(Enum::LOOP loop)
+        {
+            if (loop == _p->preloadLoop)
+                return;
+            _p->preloadLoop = loop;
+            preloadUpdate();
+        }
+
+        void FileGroup::setPreloadStep(int step)
+        {
+            step = Core::Math::max(step, 1);
+            if (step == _p->preloadStep)
+                return;
+            _p->preloadStep = step;
+            preloadUpdate();
+        }
+
+        void FileGroup::setPreloadRange(qint64 start, qint64 end)
+        {
+            if (start == _p->preloadStart && end == _p->preloadEnd)
+                return;
+            _p->preloadStart = start;
+            _p->preloadEnd = end;
+            preloadUpdate();
         }
 
         void FileGroup::openCallback()
@@ -650,6 +687,8 @@ namespace djv
                     context()->printError(error);
                 }
             }
+            preloadOpen();
+            preloadUpdate();
             Q_EMIT imageChanged();
         }
 
@@ -678,6 +717,8 @@ namespace djv
                     context()->printError(error);
                 }
             }
+            preloadOpen();
+            preloadUpdate();
             Q_EMIT imageChanged();
         }
 
@@ -762,6 +803,7 @@ namespace djv
 
         void FileGroup::cacheClearCallback()
         {
+            context()->fileCache()->resetStats();
             context()->fileCache()->clear();
         }
 
@@ -783,23 +825,156 @@ namespace djv
             context()->debugLogDialog()->raise();
         }
 
+        void FileGroup::cacheLayersCallback(bool in)
+        {
+            if (in == _p->cacheLayers)
+                return;
+            //DJV_DEBUG("FileGroup::cacheLayersCallback");
+            //DJV_DEBUG_PRINT("in = " << in);
+            _p->cacheLayers = in;
+            cacheDel();
+            preloadOpen();
+            preloadUpdate();
+        }
+
+        void FileGroup::preloadCallback()
+        {
+            //DJV_DEBUG("FileGroup::preloadCallback");
+            FileCache * cache = context()->fileCache();
+            bool imageUpdate = false;
+            for (const auto & i : _p->preloader->takeImages())
+            {
+                //DJV_DEBUG_PRINT("frame = " << i.frame);
+                //DJV_DEBUG_PRINT("layer = " << i.layer);
+                if (_p->cacheEnabled)
+                {
+                    const auto key = FileCacheKey(mainWindow(), i.frame, i.layer);
+                    if (!cache->hasItem(key))
+                    {
+                        cache->addItem(key, i.image);
+                    }
+                }
+                imageUpdate |=
+                    i.frame == _p->preloadFrame &&
+                    i.layer == _p->layer &&
+                    _p->imageFrame != _p->preloadFrame;
+            }
+            if (imageUpdate)
+            {
+                Q_EMIT imageChanged();
+            }
+        }
+
         void FileGroup::preloadUpdate()
         {
-            if (_p->cacheEnabled && _p->preload && _p->preloadActive)
+            //DJV_DEBUG("FileGroup::preloadUpdate");
+            //DJV_DEBUG_PRINT("preload frame = " << _p->preloadFrame);
+            Core::FrameList frames;
+            const qint64 count = Core::Math::max(
+                static_cast<qint64>(_p->imageIOInfo.sequence.frames.count()),
+                static_cast<qint64>(1));
+            const qint64 start = Core::Math::clamp(_p->preloadStart, static_cast<qint64>(0), count - 1);
+            const qint64 end = Core::Math::clamp(_p->preloadEnd, start, count - 1);
+            const qint64 current = Core::Math::clamp(_p->preloadFrame, start, end);
+            _p->cachePolicy->setPlayback(current, _p->preloadPlayback, _p->preloadLoop, start, end);
+            const int direction = Enum::REVERSE == _p->preloadPlayback ? -1 : 1;
+
+            // During playback only the frames that will be shown are loaded. When
+            // frames are being dropped playback skips ahead by the frame step.
+            const int step = Enum::STOP == _p->preloadPlayback ? 1 : _p->preloadStep;
+            auto next = [&](qint64 frame, int & nextDirection)
             {
-                if (!_p->preloadTimer)
+                for (int i = 0; i < step && frame != -1; ++i)
                 {
-                    _p->preloadTimer = startTimer(0);
+                    frame = preloadNext(frame, nextDirection, start, end, _p->preloadLoop);
+                }
+                return frame;
+            };
+
+            // Prefetch the files ahead of the current frame into the operating
+            // system cache, following the loop mode and the in/out range. Frames
+            // that are already cached are skipped. This also helps when the cache
+            // is disabled.
+            const int prefetchCount = _p->preload ? Core::FilePrefetch::frameCountDefault() : 0;
+            Core::FrameList prefetchFrames;
+            {
+                std::set<qint64> visited;
+                int prefetchDirection = direction;
+                for (qint64 frame = next(current, prefetchDirection);
+                    frame != -1 && prefetchFrames.count() < prefetchCount && visited.insert(frame).second;
+                    frame = next(frame, prefetchDirection))
+                {
+                    if (!(_p->cacheEnabled && context()->fileCache()->hasItem(
+                        FileCacheKey(mainWindow(), frame, _p->layer))))
+                    {
+                        prefetchFrames.push_back(frame);
+                    }
                 }
             }
-            else
+            _p->prefetch->setFrameCount(prefetchCount);
+            _p->prefetch->setFrames(prefetchFrames);
+
+            if (_p->cacheEnabled && _p->preload && _p->imageLoad.data())
             {
-                if (_p->preloadTimer)
+                FileCache * cache = context()->fileCache();
+                const quint64 maxBytes = cache->maxSizeBytes();
+                const QVector<int> layers = loadLayers();
+                quint64 frameBytes = 0;
+                for (auto layer : layers)
                 {
-                    killTimer(_p->preloadTimer);
-                    _p->preloadTimer = 0;
+                    frameBytes += Graphics::PixelDataUtil::dataByteCount(_p->imageIOInfo[layer]);
+                }
+                std::set<qint64> visited;
+                quint64 byteCount = 0;
+                auto add = [&](qint64 frame)
+                {
+                    const auto key = FileCacheKey(mainWindow(), frame, _p->layer);
+                    if (cache->hasItem(key))
+                    {
+                        for (auto layer : layers)
+                        {
+                            byteCount += cache->itemByteCount(FileCacheKey(mainWindow(), frame, layer));
+                        }
+                    }
+                    else
+                    {
+                        byteCount += frameBytes;
+                        if (byteCount <= maxBytes)
+                        {
+                            frames.push_back(frame);
+                        }
+                    }
+                };
+
+                // Add the frames ahead of the current frame in the playback
+                // direction, following the loop mode. When playback is stopped a
+                // quarter of the cache is kept for the frames behind the current
+                // frame. This matches the order that the cache policy evicts
+                // frames so that pre-loaded frames are not immediately evicted.
+                const bool stop = Enum::STOP == _p->preloadPlayback;
+                const qint64 behindWeight = FileCachePlaybackPolicy::behindWeight;
+                const quint64 aheadBytes = stop ? (maxBytes / (behindWeight + 1) * behindWeight) : maxBytes;
+                int aheadDirection = direction;
+                for (qint64 frame = current;
+                    frame != -1 && byteCount < aheadBytes && visited.insert(frame).second;
+                    frame = next(frame, aheadDirection))
+                {
+                    add(frame);
+                }
+
+                // Add the frames behind the current frame.
+                if (stop)
+                {
+                    for (qint64 frame = current - 1;
+                        frame >= start && byteCount < maxBytes && visited.insert(frame).second;
+                        --frame)
+                    {
+                        add(frame);
+                    }
                 }
             }
+            //DJV_DEBUG_PRINT("frames = " << frames.count());
+            _p->preloader->setFrames(frames);
         }
 
         void FileGroup::update()
@@ -826,5 +1001,48 @@ namespace djv
             context()->fileCache()->clearItems(mainWindow());
         }
 
+        QVector<int> FileGroup::loadLayers() const
+        {
+            QVector<int> out;
+            if (_p->cacheEnabled && _p->cacheLayers && _p->layers.count() > 1)
+            {
+                for (int i = 0; i < _p->layers.count(); ++i)
+                {
+                    out += i;
+                }
+            }
+            else
+            {
+                out += _p->layer;
+            }
+            return out;
+        }
+
+        void FileGroup::preloadOpen()
+        {
+            //DJV_DEBUG("FileGroup::preloadOpen");
+            Core::FileInfo prefetchFileInfo;
+            if (_p->imageLoad.data())
+            {
+                _p->preloader->open(
+                    _p->fileInfo,
+                    _p->imageIOInfo,
+                    loadLayers(),
+                    _p->proxy,
+                    _p->u8Conversion);
+                prefetchFileInfo = _p->fileInfo;
+                prefetchFileInfo.setSequence(_p->imageIOInfo.sequence);
+            }
+            else
+            {
+                _p->preloader->close();
+            }
+            if (prefetchFileInfo.fileName() != _p->prefetch->fileInfo().fileName() ||
+                prefetchFileInfo.sequence().frames != _p->prefetch->fileInfo().sequence().frames)
+            {
+                _p->prefetch->setFileInfo(prefetchFileInfo);
+            }
+        }
+
     } // namespace ViewLib
 } // namespace djv
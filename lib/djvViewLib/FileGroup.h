@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvViewLib/AbstractGroup.h>
+#include <djvViewLib/Enum.h>
 
 #include <djvGraphics/ImageIO.h>
 #include <djvGraphics/Pixel.h>
@@ -76,13 +77,12 @@ namespace djv
             //! Get whether the cache pre-load is enabled.
             bool hasPreload() const;
 
-            //! Get whether the cache pre-load is active.
-            bool isPreloadActive() const;
-
             //! Get the cache pre-load frame.
             qint64 preloadFrame() const;
 
-            //! Get an image.
+            //! Get an image. During playback frames that have not been loaded
+            //! yet by the pre-load threads are skipped and the previous image is
+            //! returned instead.
             std::shared_ptr<Graphics::Image> image(qint64 frame) const;
 
             //! Get image I/O information.
@@ -109,12 +109,22 @@ namespace djv
             //! Set whether the cache pre-load is enabled.
             void setPreload(bool);
 
-            //! Set whether the cache pre-load is active.
-            void setPreloadActive(bool);
-
             //! Set the cache pre-load frame.
             void setPreloadFrame(qint64);
 
+            //! Set the cache pre-load playback direction.
+            void setPreloadPlayback(djv::ViewLib::Enum::PLAYBACK);
+
+            //! Set the cache pre-load loop mode.
+            void setPreloadLoop(djv::ViewLib::Enum::LOOP);
+
+            //! Set the number of frames that playback advances for each frame
+            //! shown. During playback only those frames are pre-loaded.
+            void setPreloadStep(int);
+
+            //! Set the cache pre-load frame range.
+            void setPreloadRange(qint64 start, qint64 end);
+
         Q_SIGNALS:
             //! This signal is emitted when the current image is changed.
             void imageChanged();
@@ -131,9 +141,6 @@ namespace djv
             //! This signal is emitted to export a frame.
             void exportFrame(const djv::Core::FileInfo &);
 
-        protected:
-            void timerEvent(QTimerEvent *) override;
-
         private Q_SLOTS:
             void openCallback();
             void openCallback(const djv::Core::FileInfo &);
@@ -152,11 +159,16 @@ namespace djv
             void prefsCallback();
             void debugLogCallback();
 
+            void cacheLayersCallback(bool);
+            void preloadCallback();
+
             void preloadUpdate();
             void update();
 
         private:
             void cacheDel();
+            QVector<int> loadLayers() const;
+            void preloadOpen();
 
             DJV_PRIVATE_COPY(FileGroup);
 
@@ -30,9 +30,14 @@
 #include <djvViewLib/FilePrefs.h>
 
 #include <djvViewLib/FileCache.h>
+#include <djvViewLib/ViewContext.h>
 
 #include <djvUI/Prefs.h>
 
+#include <djvGraphics/Cineon.h>
+#include <djvGraphics/DPX.h>
+#include <djvGraphics/ImageIO.h>
+
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/ListUtil.h>
 
@@ -47,7 +52,9 @@ namespace djv
             _cacheEnabled(cacheEnabledDefault()),
             _cacheSizeGB(cacheSizeGBDefault()),
             _preload(preloadDefault()),
-            _displayCache(displayCacheDefault())
+            _displayCache(displayCacheDefault()),
+            _cacheLayers(cacheLayersDefault()),
+            _unbufferedRead(unbufferedReadDefault())
         {
             UI::Prefs prefs("djv::ViewLib::FilePrefs");
             prefs.get("recent", _recent);
@@ -57,8 +64,14 @@ namespace djv
             prefs.get("cacheSize", _cacheSizeGB);
             prefs.get("preload", _preload);
             prefs.get("displayCache", _displayCache);
+            prefs.get("cacheLayers", _cacheLayers);
+            prefs.get("unbufferedRead", _unbufferedRead);
             if (_recent.count() > Core::FileInfoUtil::recentMax)
                 _recent = _recent.mid(0, Core::FileInfoUtil::recentMax);
+            if (_unbufferedRead)
+            {
+                unbufferedReadUpdate();
+            }
         }
 
         FilePrefs::~FilePrefs()
@@ -71,6 +84,8 @@ namespace djv
             prefs.set("cacheSize", _cacheSizeGB);
             prefs.set("preload", _preload);
             prefs.set("displayCache", _displayCache);
+            prefs.set("cacheLayers", _cacheLayers);
+            prefs.set("unbufferedRead", _unbufferedRead);
         }
 
         void FilePrefs::addRecent(const Core::FileInfo & in)
@@ -147,6 +162,26 @@ namespace djv
             return _displayCache;
         }
 
+        bool FilePrefs::cacheLayersDefault()
+        {
+            return false;
+        }
+
+        bool FilePrefs::hasCacheLayers() const
+        {
+            return _cacheLayers;
+        }
+
+        bool FilePrefs::unbufferedReadDefault()
+        {
+            return false;
+        }
+
+        bool FilePrefs::hasUnbufferedRead() const
+        {
+            return _unbufferedRead;
+        }
+
         void FilePrefs::setProxy(Graphics::PixelDataInfo::PROXY proxy)
         {
             if (proxy == _proxy)
@@ -201,5 +236,51 @@ namespace djv
             Q_EMIT prefChanged();
         }
 
+        void FilePrefs::setCacheLayers(bool cacheLayers)
+        {
+            if (cacheLayers == _cacheLayers)
+                return;
+            _cacheLayers = cacheLayers;
+            Q_EMIT cacheLayersChanged(_cacheLayers);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setUnbufferedRead(bool unbufferedRead)
+        {
+            if (unbufferedRead == _unbufferedRead)
+                return;
+            _unbufferedRead = unbufferedRead;
+            unbufferedReadUpdate();
+            Q_EMIT unbufferedReadChanged(_unbufferedRead);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::unbufferedReadUpdate()
+        {
+            //DJV_DEBUG("FilePrefs::unbufferedReadUpdate");
+            //DJV_DEBUG_PRINT("unbuffered read = " << _unbufferedRead);
+            const QStringList names = QStringList() <<
+                Graphics::Cineon::staticName <<
+                Graphics::DPX::staticName;
+            const QStringList options = QStringList() <<
+                Graphics::Cineon::optionsLabels()[Graphics::Cineon::INPUT_READ_OPTION] <<
+                Graphics::DPX::optionsLabels()[Graphics::DPX::INPUT_READ_OPTION];
+            const QString & directLabel = Graphics::Cineon::readLabels()[Graphics::Cineon::READ_DIRECT];
+            for (int i = 0; i < names.count(); ++i)
+            {
+                // When unbuffered reads are disabled only reset the plugins that
+                // are using them, so that other read methods are kept.
+                QStringList tmp = context()->imageIOFactory()->option(names[i], options[i]);
+                const bool direct = tmp.count() && directLabel == tmp[0];
+                if (_unbufferedRead != direct)
+                {
+                    tmp = QStringList() << Graphics::Cineon::readLabels()[_unbufferedRead ?
+                        Graphics::Cineon::READ_DIRECT :
+                        Graphics::Cineon::READ_MMAP];
+                    context()->imageIOFactory()->setOption(names[i], options[i], tmp);
+                }
+            }
+        }
+
     } // namespace ViewLib
 } // namespace djv
@@ -92,6 +92,18 @@ namespace djv
             //! Get whether the cache is displayed in the timeline.
             bool hasDisplayCache() const;
 
+            //! Get the default for whether all of the layers are cached.
+            static bool cacheLayersDefault();
+
+            //! Get whether all of the layers are cached.
+            bool hasCacheLayers() const;
+
+            //! Get the default for whether files are read without the file cache.
+            static bool unbufferedReadDefault();
+
+            //! Get whether files are read without the file cache.
+            bool hasUnbufferedRead() const;
+
         public Q_SLOTS:
             //! Set the proxy scale.
             void setProxy(djv::Graphics::PixelDataInfo::PROXY);
@@ -111,6 +123,15 @@ namespace djv
             //! Set whether the cache is displayed in the timeline.
             void setDisplayCache(bool);
 
+            //! Set whether all of the layers are cached. The layers of a frame
+            //! are loaded together so that changing layers does not read the
+            //! files again.
+            void setCacheLayers(bool);
+
+            //! Set whether files are read without the file cache. This sets the
+            //! read method of the image I/O plugins that support it.
+            void setUnbufferedRead(bool);
+
         Q_SIGNALS:
             //! This signal is emitted when the recent files are changed.
             void recentChanged(const djv::Core::FileInfoList &);
@@ -133,7 +154,15 @@ namespace djv
             //! This signal is emitted when the cache display is changed.
             void displayCacheChanged(bool);
 
+            //! This signal is emitted when caching all of the layers is changed.
+            void cacheLayersChanged(bool);
+
+            //! This signal is emitted when unbuffered reads are changed.
+            void unbufferedReadChanged(bool);
+
         private:
+            void unbufferedReadUpdate();
+
             Core::FileInfoList             _recent;
             Graphics::PixelDataInfo::PROXY _proxy;
             bool                           _u8Conversion;
@@ -141,6 +170,8 @@ namespace djv
             float                          _cacheSizeGB;
             bool                           _preload;
             bool                           _displayCache;
+            bool                           _cacheLayers;
+            bool                           _unbufferedRead;
         };
 
     } // namespace ViewLib
@@ -58,6 +58,8 @@ namespace djv
             QPointer<CacheSizeWidget> cacheSizeWidget;
             QPointer<QCheckBox>       preloadWidget;
             QPointer<QCheckBox>       displayCacheWidget;
+            QPointer<QCheckBox>       cacheLayersWidget;
+            QPointer<QCheckBox>       unbufferedReadWidget;
         };
 
         FilePrefsWidget::FilePrefsWidget(const QPointer<ViewContext> & context) :
@@ -85,6 +87,13 @@ namespace djv
             _p->displayCacheWidget = new QCheckBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Display cached frames in the timeline"));
 
+            _p->cacheLayersWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Cache all layers"));
+
+            // Create the unbuffered read widgets.
+            _p->unbufferedReadWidget = new QCheckBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Enable unbuffered reads"));
+
             // Layout the widgets.
             auto layout = new QVBoxLayout(this);
 
@@ -113,7 +122,9 @@ namespace djv
             prefsGroupBox = new UI::PrefsGroupBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Memory Cache"),
                 qApp->translate("djv::ViewLib::FilePrefsWidget",
-                    "The memory cache stores images for faster playback performance."),
+                    "The memory cache stores images for faster playback performance. "
+                    "Caching all layers loads every layer of multi-layer images such as OpenEXR, "
+                    "so that changing layers does not read the files again."),
                 context.data());
             formLayout = prefsGroupBox->createLayout();
             formLayout->addRow(_p->cacheWidget);
@@ -122,6 +133,18 @@ namespace djv
                 _p->cacheSizeWidget);
             formLayout->addRow(_p->preloadWidget);
             formLayout->addRow(_p->displayCacheWidget);
+            formLayout->addRow(_p->cacheLayersWidget);
+            layout->addWidget(prefsGroupBox);
+
+            prefsGroupBox = new UI::PrefsGroupBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Unbuffered Reads"),
+                qApp->translate("djv::ViewLib::FilePrefsWidget",
+                    "Read DPX and Cineon images without the operating system's file cache. "
+                    "This saves memory when playing large images from fast storage, "
+                    "since the images are not kept in both the file cache and the memory cache."),
+                context.data());
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(_p->unbufferedReadWidget);
             layout->addWidget(prefsGroupBox);
 
             layout->addStretch();
@@ -154,6 +177,14 @@ namespace djv
                 _p->displayCacheWidget,
                 SIGNAL(toggled(bool)),
                 SLOT(displayCacheCallback(bool)));
+            connect(
+                _p->cacheLayersWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(cacheLayersCallback(bool)));
+            connect(
+                _p->unbufferedReadWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(unbufferedReadCallback(bool)));
             connect(
                 context->filePrefs(),
                 SIGNAL(prefChanged()),
@@ -171,6 +202,8 @@ namespace djv
             context()->filePrefs()->setCacheSizeGB(FilePrefs::cacheSizeGBDefault());
             context()->filePrefs()->setPreload(FilePrefs::preloadDefault());
             context()->filePrefs()->setDisplayCache(FilePrefs::displayCacheDefault());
+            context()->filePrefs()->setCacheLayers(FilePrefs::cacheLayersDefault());
+            context()->filePrefs()->setUnbufferedRead(FilePrefs::unbufferedReadDefault());
         }
 
         void FilePrefsWidget::proxyCallback(int in)
@@ -203,6 +236,16 @@ namespace djv
             context()->filePrefs()->setDisplayCache(in);
         }
 
+        void FilePrefsWidget::cacheLayersCallback(bool in)
+        {
+            context()->filePrefs()->setCacheLayers(in);
+        }
+
+        void FilePrefsWidget::unbufferedReadCallback(bool in)
+        {
+            context()->filePrefs()->setUnbufferedRead(in);
+        }
+
         void FilePrefsWidget::widgetUpdate()
         {
             Core::SignalBlocker signalBlocker(QObjectList() <<
@@ -211,13 +254,17 @@ namespace djv
                 _p->cacheWidget <<
                 _p->cacheSizeWidget <<
                 _p->preloadWidget <<
-                _p->displayCacheWidget);
+                _p->displayCacheWidget <<
+                _p->cacheLayersWidget <<
+                _p->unbufferedReadWidget);
             _p->proxyWidget->setCurrentIndex(context()->filePrefs()->proxy());
             _p->u8ConversionWidget->setChecked(context()->filePrefs()->hasU8Conversion());
             _p->cacheWidget->setChecked(context()->filePrefs()->isCacheEnabled());
             _p->cacheSizeWidget->setCacheSizeGB(context()->filePrefs()->cacheSizeGB());
             _p->preloadWidget->setChecked(context()->filePrefs()->hasPreload());
             _p->displayCacheWidget->setChecked(context()->filePrefs()->hasDisplayCache());
+            _p->cacheLayersWidget->setChecked(context()->filePrefs()->hasCacheLayers());
+            _p->unbufferedReadWidget->setChecked(context()->filePrefs()->hasUnbufferedRead());
         }
 
     } // namespace ViewLib
@@ -57,6 +57,8 @@ namespace djv
             void cacheSizeGBCallback(float);
             void preloadCallback(bool);
             void displayCacheCallback(bool);
+            void cacheLayersCallback(bool);
+            void unbufferedReadCallback(bool);
 
             void widgetUpdate();
 
@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLib/FilePreload.h>
+
+#include <djvViewLib/ViewContext.h>
+
+#include <djvGraphics/Image.h>
+#include <djvGraphics/OpenGLImage.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/Math.h>
+
+#include <QThread>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        namespace
+        {
+            //! This struct provides the settings used to load images.
+            struct Settings
+            {
+                Core::FrameList                sequence;
+                QVector<int>                   layers;
+                Graphics::PixelDataInfo::PROXY proxy = Graphics::PixelDataInfo::PROXY_NONE;
+                bool                           u8Conversion = false;
+            };
+
+        } // namespace
+
+        struct FilePreload::Private
+        {
+            Private(const QPointer<ViewContext> & context) :
+                context(context)
+            {}
+
+            QPointer<ViewContext> context;
+            std::vector<std::thread> threads;
+            mutable std::mutex mutex;
+            std::condition_variable cv;
+
+            // These members are protected by the mutex.
+            std::vector<std::shared_ptr<Graphics::ImageLoad> > loads;
+            std::shared_ptr<Settings> settings;
+            std::deque<qint64> queue;
+            //! The frames that are being loaded, with the ID of the file they
+            //! are being loaded for.
+            std::set<std::pair<quint64, qint64> > loading;
+            std::vector<FilePreloadImage> images;
+            quint64 id = 0;
+            bool running = true;
+        };
+
+        FilePreload::FilePreload(const QPointer<ViewContext> & context, QObject * parent) :
+            QObject(parent),
+            _p(new Private(context))
+        {
+            //DJV_DEBUG("FilePreload::FilePreload");
+            const int count = threadCount();
+            _p->loads.resize(count);
+            for (int i = 0; i < count; ++i)
+            {
+                _p->threads.push_back(std::thread([this, i] { run(i); }));
+            }
+        }
+
+        FilePreload::~FilePreload()
+        {
+            //DJV_DEBUG("FilePreload::~FilePreload");
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->running = false;
+            }
+            _p->cv.notify_all();
+            for (auto & i : _p->threads)
+            {
+                i.join();
+            }
+        }
+
+        void FilePreload::open(
+            const Core::FileInfo &         fileInfo,
+            const Graphics::ImageIOInfo &  imageIOInfo,
+            const QVector<int> &           layers,
+            Graphics::PixelDataInfo::PROXY proxy,
+            bool                           u8Conversion)
+        {
+            //DJV_DEBUG("FilePreload::open");
+            //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+
+            // Create a loader for each thread since loaders cannot be shared
+            // between threads. Movies only use a single thread because seeking
+            // between frames is expensive.
+            std::vector<std::shared_ptr<Graphics::ImageLoad> > loads(_p->threads.size());
+            const size_t count = Core::FileInfo::SEQUENCE == fileInfo.type() ? loads.size() : 1;
+            for (size_t i = 0; i < count; ++i)
+            {
+                try
+                {
+                    Graphics::ImageIOInfo info;
+                    loads[i].reset(_p->context->imageIOFactory()->load(fileInfo, info));
+                }
+                catch (const Core::Error &)
+                {
+                    break;
+                }
+            }
+
+            auto settings = std::make_shared<Settings>();
+            settings->sequence = imageIOInfo.sequence.frames;
+            settings->layers = layers;
+            settings->proxy = proxy;
+            settings->u8Conversion = u8Conversion;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->loads = loads;
+                _p->settings = settings;
+                _p->queue.clear();
+                _p->images.clear();
+                ++_p->id;
+            }
+            _p->cv.notify_all();
+        }
+
+        void FilePreload::close()
+        {
+            //DJV_DEBUG("FilePreload::close");
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            for (auto & i : _p->loads)
+            {
+                i.reset();
+            }
+            _p->settings.reset();
+            _p->queue.clear();
+            _p->images.clear();
+            ++_p->id;
+        }
+
+        void FilePreload::setFrames(const Core::FrameList & frames)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                _p->queue.clear();
+                for (auto i : frames)
+                {
+                    if (_p->loading.find(std::make_pair(_p->id, i)) == _p->loading.end())
+                    {
+                        _p->queue.push_back(i);
+                    }
+                }
+            }
+            _p->cv.notify_all();
+        }
+
+        bool FilePreload::isPending(qint64 frame) const
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            return
+                _p->loading.find(std::make_pair(_p->id, frame)) != _p->loading.end() ||
+                std::find(_p->queue.begin(), _p->queue.end(), frame) != _p->queue.end();
+        }
+
+        std::vector<FilePreloadImage> FilePreload::takeImages()
+        {
+            std::vector<FilePreloadImage> out;
+            {
+                std::unique_lock<std::mutex> lock(_p->mutex);
+                std::swap(out, _p->images);
+            }
+            return out;
+        }
+
+        int FilePreload::threadCount()
+        {
+            return Core::Math::max(1, QThread::idealThreadCount());
+        }
+
+        void FilePreload::run(int thread)
+        {
+            // There is no OpenGL context on this thread so the conversion is done
+            // in software.
+            Graphics::OpenGLImage openGLImage;
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            while (_p->running)
+            {
+                _p->cv.wait(lock, [this, thread]
+                {
+                    return !_p->running || (_p->loads[thread] && !_p->queue.empty());
+                });
+                if (!_p->running)
+                    break;
+
+                // Get the next frame.
+                const qint64 frame = _p->queue.front();
+                _p->queue.pop_front();
+                if (frame < 0 || (_p->settings->sequence.count() && frame >= _p->settings->sequence.count()))
+                    continue;
+                const quint64 id = _p->id;
+                _p->loading.insert(std::make_pair(id, frame));
+                const auto load = _p->loads[thread];
+                const auto settings = _p->settings;
+                lock.unlock();
+
+                // Load the images.
+                std::vector<FilePreloadImage> images;
+                try
+                {
+                    QVector<Graphics::Image *> pointers;
+                    for (auto layer : settings->layers)
+                    {
+                        FilePreloadImage image;
+                        image.frame = frame;
+                        image.layer = layer;
+                        image.image.reset(new Graphics::Image);
+                        images.push_back(image);
+                        pointers += image.image.get();
+                    }
+                    const Graphics::ImageIOFrameInfo frameInfo(
+                        settings->sequence.count() ?
+                        settings->sequence.at(frame) :
+                        -1,
+                        settings->layers.count() ? settings->layers[0] : 0,
+                        settings->proxy);
+                    if (pointers.count() > 1)
+                    {
+                        load->readLayers(pointers, settings->layers, frameInfo);
+                    }
+                    else if (pointers.count())
+                    {
+                        load->read(*pointers[0], frameInfo);
+                    }
+                    for (auto & i : images)
+                    {
+                        auto & image = i.image;
+                        if (image->isValid() && settings->u8Conversion)
+                        {
+                            Graphics::PixelDataInfo info(image->info());
+                            info.pixel = Graphics::Pixel::pixel(Graphics::Pixel::format(info.pixel), Graphics::Pixel::U8);
+                            auto tmp = image;
+                            image = std::shared_ptr<Graphics::Image>(new Graphics::Image(info));
+                            image->tags = tmp->tags;
+                            Graphics::OpenGLImageOptions options;
+                            options.colorProfile = tmp->colorProfile;
+                            options.proxyScale = false;
+                            openGLImage.copy(*tmp, *image, options);
+                        }
+                    }
+                }
+                catch (const Core::Error &)
+                {
+                    images.clear();
+                }
+                catch (const std::exception &)
+                {
+                    // Allocating the images can fail, in which case the frame
+                    // is dropped and loaded by the GUI thread instead.
+                    images.clear();
+                }
+
+                // Hand the images over to the GUI thread. Images for a file that
+                // has since been closed are discarded.
+                lock.lock();
+                _p->loading.erase(std::make_pair(id, frame));
+                images.erase(
+                    std::remove_if(
+                        images.begin(),
+                        images.end(),
+                        [](const FilePreloadImage & i) { return !i.image->isValid(); }),
+                    images.end());
+                if (!images.empty() && id == _p->id)
+                {
+                    const bool emitSignal = _p->images.empty();
+                    _p->images.insert(_p->images.end(), images.begin(), images.end());
+                    if (emitSignal)
+                    {
+                        lock.unlock();
+                        Q_EMIT imagesLoaded();
+                        lock.lock();
+                    }
+                }
+            }
+        }
+
+    } // namespace ViewLib
+} // namespace djv
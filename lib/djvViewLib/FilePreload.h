@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvViewLib/ViewLib.h>
+
+#include <djvGraphics/ImageIO.h>
+
+#include <djvCore/FileInfo.h>
+#include <djvCore/Sequence.h>
+
+#include <QObject>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        class ViewContext;
+
+        //! This struct provides an image that has been pre-loaded.
+        struct FilePreloadImage
+        {
+            qint64                           frame = 0;
+            int                              layer = 0;
+            std::shared_ptr<Graphics::Image> image;
+        };
+
+        //! This class provides background image loading for the file cache. The
+        //! images are loaded by a pool of threads that each have their own image
+        //! loader. Loaded images are collected with takeImages() on the GUI thread.
+        class FilePreload : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            explicit FilePreload(const QPointer<ViewContext> &, QObject * parent = nullptr);
+            ~FilePreload() override;
+
+            //! Open a file. When more than one layer is given the layers of each
+            //! frame are loaded together. Any pending loads are cancelled.
+            void open(
+                const Core::FileInfo &,
+                const Graphics::ImageIOInfo &,
+                const QVector<int> & layers,
+                Graphics::PixelDataInfo::PROXY,
+                bool u8Conversion);
+
+            //! Close the file. Any pending loads are cancelled.
+            void close();
+
+            //! Set the frames to load in order of priority. Frames that are not
+            //! in the list are cancelled unless they are already being loaded.
+            void setFrames(const Core::FrameList &);
+
+            //! Get whether a frame is waiting to be loaded or being loaded.
+            bool isPending(qint64) const;
+
+            //! Take the images that have finished loading.
+            std::vector<FilePreloadImage> takeImages();
+
+            //! Get the number of loading threads.
+            static int threadCount();
+
+        Q_SIGNALS:
+            //! This signal is emitted from the loading threads when images are
+            //! ready to be taken.
+            void imagesLoaded();
+
+        private:
+            void run(int);
+
+            DJV_PRIVATE_COPY(FilePreload);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
@@ -235,6 +235,30 @@ namespace djv
                 _p->playbackGroup,
                 SIGNAL(playbackChanged(djv::ViewLib::Enum::PLAYBACK)),
                 SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(loopChanged(djv::ViewLib::Enum::LOOP)),
+                SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(frameStepChanged(int)),
+                SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(sequenceChanged(const djv::Core::Sequence &)),
+                SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(inOutEnabledChanged(bool)),
+                SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(inPointChanged(qint64)),
+                SLOT(playbackUpdate()));
+            connect(
+                _p->playbackGroup,
+                SIGNAL(outPointChanged(qint64)),
+                SLOT(playbackUpdate()));
             connect(
                 _p->playbackGroup,
                 SIGNAL(frameChanged(qint64)),
@@ -559,7 +583,7 @@ namespace djv
             //DJV_DEBUG("MainWindow::reloadFrameCallback");
             const qint64 frame = _p->playbackGroup->frame();
             //DJV_DEBUG_PRINT("frame = " << frame);
-            _p->context->fileCache()->removeItem(FileCacheKey(this, frame));
+            _p->context->fileCache()->removeFrame(this, frame);
         }
 
         void MainWindow::exportSequenceCallback(const Core::FileInfo & in)
@@ -679,11 +703,14 @@ namespace djv
             //DJV_DEBUG("MainWindow::cacheUpdate");
             const float sizeGB = _p->context->fileCache()->currentSizeGB();
             const float maxSizeGB = _p->context->fileCache()->maxSizeGB();
+            const FileCacheStats & stats = _p->context->fileCache()->stats();
             _p->infoCacheLabel->setText(
-                qApp->translate("djv::ViewLib::MainWindow", "Cache: %1% %2/%3GB").
+                qApp->translate("djv::ViewLib::MainWindow", "Cache: %1% %2/%3GB Hits: %4% Evictions: %5").
                 arg(static_cast<int>(sizeGB / maxSizeGB * 100)).
                 arg(sizeGB, 0, 'f', 2).
-                arg(maxSizeGB, 0, 'f', 2));
+                arg(maxSizeGB, 0, 'f', 2).
+                arg(static_cast<int>(stats.hitRate())).
+                arg(stats.evictions));
         }
 
         void MainWindow::imageUpdate()
@@ -698,6 +725,9 @@ namespace djv
                 //DJV_DEBUG_PRINT("image = " << *_p->image);
             }
 
+            // Update the cache statistics.
+            fileCacheUpdate();
+
             // Update the information tool bar.
             Graphics::PixelDataInfo info;
             if (_p->image)
@@ -843,17 +873,16 @@ namespace djv
 
         void MainWindow::playbackUpdate()
         {
-            switch (_p->playbackGroup->playback())
-            {
-            case Enum::FORWARD:
-            case Enum::REVERSE:
-                _p->fileGroup->setPreloadActive(false);
-                break;
-            case Enum::STOP:
-                _p->fileGroup->setPreloadActive(true);
-                break;
-            default: break;
-            }
+            const Core::Sequence & sequence = _p->playbackGroup->sequence();
+            const bool inOut = _p->playbackGroup->isInOutEnabled();
+            _p->fileGroup->setPreloadPlayback(_p->playbackGroup->playback());
+            _p->fileGroup->setPreloadLoop(_p->playbackGroup->loop());
+            _p->fileGroup->setPreloadStep(_p->playbackGroup->frameStep());
+            _p->fileGroup->setPreloadRange(
+                inOut ? _p->playbackGroup->inPoint() : 0,
+                inOut ?
+                _p->playbackGroup->outPoint() :
+                Core::Math::max(static_cast<qint64>(sequence.frames.count()) - 1, static_cast<qint64>(0)));
         }
 
         const std::shared_ptr<Graphics::Image> & MainWindow::image() const
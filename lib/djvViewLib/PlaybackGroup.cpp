@@ -80,6 +80,7 @@ namespace djv
             bool              droppedFrames = false;
             bool              droppedFramesTmp = false;
             bool              everyFrame = false;
+            int               frameStep = 1;
             qint64            frame = 0;
             qint64            frameTmp = 0;
             bool              shuttle = false;
@@ -94,6 +95,7 @@ namespace djv
             quint64           idleFrame = 0;
             Core::Timer       speedTimer;
             quint64           speedCounter = 0;
+            quint64           speedTicks = 0;
             Enum::LAYOUT      layout = static_cast<Enum::LAYOUT>(0);
 
             QPointer<PlaybackActions> actions;
@@ -277,6 +279,11 @@ namespace djv
             return _p->everyFrame;
         }
 
+        int PlaybackGroup::frameStep() const
+        {
+            return _p->frameStep;
+        }
+
         qint64 PlaybackGroup::frame() const
         {
             return _p->frame;
@@ -317,6 +324,7 @@ namespace djv
             _p->speed = sequence.speed;
             _p->actualSpeed = 0.f;
             _p->droppedFrames = false;
+            setFrameStep(1);
             _p->inPoint = 0;
             _p->outPoint = sequenceEnd(_p->sequence);
             timeUpdate();
@@ -369,6 +377,7 @@ namespace djv
             _p->speed = in;
             _p->actualSpeed = 0.f;
             _p->droppedFrames = false;
+            setFrameStep(1);
             playbackUpdate();
             speedUpdate();
             Q_EMIT speedChanged(_p->speed);
@@ -381,6 +390,7 @@ namespace djv
             if (in == _p->everyFrame)
                 return;
             _p->everyFrame = in;
+            setFrameStep(1);
             speedUpdate();
             Q_EMIT everyFrameChanged(_p->everyFrame);
         }
@@ -481,6 +491,7 @@ namespace djv
                 _p->idleFrame = 0;
                 _p->speedTimer = _p->idleTimer;
                 _p->speedCounter = 0;
+                _p->speedTicks = 0;
                 _p->droppedFrames = false;
                 _p->droppedFramesTmp = false;
                 _p->idleInit = false;
@@ -514,6 +525,7 @@ namespace djv
                 _p->droppedFramesTmp |= inc > 1 || inc < -1;
             }
             _p->speedCounter += Core::Math::abs(inc);
+            ++_p->speedTicks;
 
             // Calculate the actual playback speed.
             _p->speedTimer.check();
@@ -523,11 +535,16 @@ namespace djv
                 _p->speedTimer.start();
                 _p->droppedFrames = _p->droppedFramesTmp;
                 _p->droppedFramesTmp = false;
+                const int frameStep = everyFrame ? 1 : Core::Math::max(
+                    Core::Math::round(_p->speedCounter / static_cast<float>(_p->speedTicks)),
+                    1);
                 _p->speedCounter = 0;
+                _p->speedTicks = 0;
                 _p->toolBar->setActualSpeed(_p->actualSpeed);
                 _p->toolBar->setDroppedFrames(everyFrame ? false : _p->droppedFrames);
                 Q_EMIT actualSpeedChanged(_p->actualSpeed);
                 Q_EMIT droppedFramesChanged(_p->droppedFrames);
+                setFrameStep(frameStep);
             }
 
             setFrame(_p->frame + inc, _p->inOutEnabled);
@@ -679,6 +696,14 @@ namespace djv
             return Core::Math::min(sequenceEnd(_p->sequence), _p->outPoint);
         }
 
+        void PlaybackGroup::setFrameStep(int in)
+        {
+            if (in == _p->frameStep)
+                return;
+            _p->frameStep = in;
+            Q_EMIT frameStepChanged(_p->frameStep);
+        }
+
         void PlaybackGroup::playbackUpdate()
         {
             //DJV_DEBUG("PlaybackGroup::playbackUpdate");
@@ -82,6 +82,10 @@ namespace djv
             //! Get whether every frame should be played back.
             bool hasEveryFrame() const;
 
+            //! Get the average number of frames that playback advances for each
+            //! frame shown. This is greater than one when frames are dropped.
+            int frameStep() const;
+
             //! Get the current frame.
             qint64 frame() const;
 
@@ -155,6 +159,9 @@ namespace djv
             //! This signal is emitted when every frame playback is changed.
             void everyFrameChanged(bool);
 
+            //! This signal is emitted when the frame step is changed.
+            void frameStepChanged(int);
+
             //! This signal is emitted when the frame is changed.
             void frameChanged(qint64);
 
@@ -195,6 +202,8 @@ namespace djv
             qint64 frameStart() const;
             qint64 frameEnd() const;
 
+            void setFrameStep(int);
+
             void playbackUpdate();
             void timeUpdate();
             void frameUpdate();
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLibTest/FileCacheBenchmarkTest.h>
+
+#include <djvGraphicsTest/FFmpegLoadBenchmarkTest.h>
+#include <djvGraphicsTest/ImageLoadBenchmarkTest.h>
+#include <djvGraphicsTest/ImageSaveBenchmarkTest.h>
+#include <djvGraphicsTest/OpenEXRLoadBenchmarkTest.h>
+#include <djvGraphicsTest/PixelConvertBenchmarkTest.h>
+#include <djvGraphicsTest/RLELoadBenchmarkTest.h>
+
+#include <djvCore/CoreContext.h>
+#include <djvCore/Error.h>
+
+#include <QApplication>
+#include <QVector>
+
+#include <iostream>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        Core::CoreContext::initLibPaths(argc, argv);
+        QApplication app(argc, argv);
+        
+        QVector<TestLib::AbstractTest *> tests = QVector<TestLib::AbstractTest *>() <<
+            new GraphicsTest::FFmpegLoadBenchmarkTest <<
+            new GraphicsTest::ImageLoadBenchmarkTest <<
+            new GraphicsTest::ImageSaveBenchmarkTest <<
+            new GraphicsTest::OpenEXRLoadBenchmarkTest <<
+            new GraphicsTest::PixelConvertBenchmarkTest <<
+            new GraphicsTest::RLELoadBenchmarkTest <<
+            new ViewLibTest::FileCacheBenchmarkTest;
+
+        for (int i = 0; i < tests.count(); ++i)
+        {
+            int     argcCopy = argc;
+            char ** argvCopy = 0;
+            argvCopy = (char **)malloc(sizeof(char **) * argcCopy);
+            for (int j = 0; j < argc; ++j)
+            {
+                argvCopy[j] = (char *)malloc(sizeof(char) * (strlen(argv[j]) + 1));
+                strcpy(argvCopy[j], argv[j]);
+            }
+            tests[i]->run(argcCopy, argvCopy);
+            for (int j = 0; j < argc; ++j)
+            {
+                free(argvCopy[j]);
+            }
+            free(argvCopy);
+        }
+        
+        qDeleteAll(tests);
+        
+        r = 0;
+    }
+    catch (const Core::Error & error)
+    {
+        Q_FOREACH(const Core::Error::Message & message, error.messages())
+        {
+            std::cout << "ERROR " <<
+                message.prefix.toUtf8().data() << ": " <<
+                message.string.toUtf8().data() << std::endl;
+        }
+    }
+    catch (const std::exception & error)
+    {
+        std::cout << "ERROR: " << error.what() << std::endl;
+    }
+    return r;
+}
+
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvConvertTest/ConvertContextTest.h>
+
+#include <djv_convert/ConvertContext.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/ThreadPool.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace ConvertTest
+    {
+        void ConvertContextTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ConvertContextTest::run");
+            const int threadCount = ThreadPool::global()->threadCount();
+            try
+            {
+                // The pipeline threads are set with -threads, and the global
+                // thread pool with -pool_threads.
+                convert::Context context(argc, argv);
+                char * args[256] =
+                {
+                    "Test",
+                    "input.ppm",
+                    "output.ppm",
+                    "-threads", "3",
+                    "-queue", "5",
+                    "-pool_threads", "2"
+                };
+                int argsCount = 9;
+                DJV_ASSERT(context.commandLine(argsCount, args));
+                DJV_ASSERT(3 == context.options().threads);
+                DJV_ASSERT(5 == context.options().queue);
+                DJV_ASSERT(2 == ThreadPool::global()->threadCount());
+            }
+            catch (const Error & error)
+            {
+                ErrorUtil::print(error);
+                DJV_ASSERT(0);
+            }
+            try
+            {
+                convert::Context context(argc, argv);
+                char * args[256] =
+                {
+                    "Test",
+                    "input.ppm",
+                    "output.ppm",
+                    "-threads", "0"
+                };
+                int argsCount = 5;
+                DJV_ASSERT(context.commandLine(argsCount, args));
+                DJV_ASSERT(1 == context.options().threads);
+            }
+            catch (const Error & error)
+            {
+                ErrorUtil::print(error);
+                DJV_ASSERT(0);
+            }
+            ThreadPool::global()->setThreadCount(threadCount);
+        }
+
+    } // namespace ConvertTest
+} // namespace djv
@@ -35,6 +35,7 @@
 #include <djvCore/ErrorUtil.h>
 #include <djvCore/Math.h>
 #include <djvCore/Speed.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Time.h>
 
 using namespace djv::Core;
@@ -91,6 +92,25 @@ namespace djv
                 DJV_ASSERT(0);
             }
             try
+            {
+                CoreContext context(argc, argv);
+                const int threadCount = ThreadPool::global()->threadCount();
+                char * args[256] =
+                {
+                    "Test",
+                    "-pool_threads", "3"
+                };
+                int argsCount = 3;
+                DJV_ASSERT(context.commandLine(argsCount, args));
+                DJV_ASSERT(3 == ThreadPool::global()->threadCount());
+                ThreadPool::global()->setThreadCount(threadCount);
+            }
+            catch (const Error & error)
+            {
+                ErrorUtil::print(error);
+                DJV_ASSERT(0);
+            }
+            try
             {
                 CoreContext context(argc, argv);
                 char * args[256] =
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/FileBatchReaderTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileBatchReader.h>
+#include <djvCore/FileIO.h>
+
+#include <QDir>
+
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        namespace
+        {
+            void read(FileBatchReader & reader, const QStringList & fileNames)
+            {
+                for (int i = 0; i < fileNames.count(); ++i)
+                {
+                    FileIO io;
+                    reader.open(fileNames[i], io);
+                    DJV_ASSERT(1000 == io.size());
+                    std::vector<quint8> data(io.size());
+                    io.get(data.data(), data.size());
+                    for (size_t j = 0; j < data.size(); ++j)
+                    {
+                        DJV_ASSERT(static_cast<quint8>(i) == data[j]);
+                    }
+                }
+            }
+
+            //! Wait for the reads that have been submitted to finish.
+            void wait(const FileBatchReader & reader, quint64 pendingBytes)
+            {
+                for (int i = 0; i < 1000 && reader.pendingBytes() < pendingBytes; ++i)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+
+        } // namespace
+
+        void FileBatchReaderTest::run(int &, char **)
+        {
+            DJV_DEBUG("FileBatchReaderTest::run");
+            QStringList fileNames;
+            for (int i = 0; i < 5; ++i)
+            {
+                const QString fileName = QString("FileBatchReaderTest.%1.test").arg(i);
+                const std::vector<quint8> data(1000, static_cast<quint8>(i));
+                FileIO io;
+                io.open(fileName, FileIO::WRITE);
+                io.set(data.data(), data.size());
+                io.close();
+                fileNames += fileName;
+            }
+            for (int i = 0; i < FileBatchReader::BACKEND_COUNT; ++i)
+            {
+                const FileBatchReader::BACKEND backend = static_cast<FileBatchReader::BACKEND>(i);
+                DJV_DEBUG_PRINT("backend = " << FileBatchReader::backendLabels()[backend]);
+                {
+                    DJV_DEBUG_PRINT("read");
+                    FileBatchReader reader(2, backend);
+                    DJV_ASSERT(2 == reader.queueDepth());
+                    DJV_ASSERT(FileBatchReader::byteWindowDefault() == reader.byteWindow());
+                    reader.submit(fileNames);
+                    read(reader, fileNames);
+                    DJV_ASSERT(5 == reader.hits());
+                    DJV_ASSERT(0 == reader.misses());
+                    DJV_ASSERT(0 == reader.pendingBytes());
+                }
+                {
+                    DJV_DEBUG_PRINT("miss");
+                    FileBatchReader reader(2, backend);
+                    read(reader, fileNames);
+                    DJV_ASSERT(0 == reader.hits());
+                    DJV_ASSERT(5 == reader.misses());
+                    reader.submit(QStringList() << "FileBatchReaderTest.missing");
+                    try
+                    {
+                        FileIO io;
+                        reader.open("FileBatchReaderTest.missing", io);
+                        DJV_ASSERT(0);
+                    }
+                    catch (const Error &)
+                    {}
+                }
+                {
+                    DJV_DEBUG_PRINT("byte window");
+                    FileBatchReader reader(2, backend);
+                    reader.setByteWindow(2500);
+                    DJV_ASSERT(2500 == reader.byteWindow());
+                    reader.submit(fileNames);
+                    read(reader, fileNames);
+                    DJV_ASSERT(5 == reader.hits() + reader.misses());
+                    reader.submit(fileNames);
+                    reader.clear();
+                    DJV_ASSERT(0 == reader.pendingBytes());
+                    read(reader, fileNames);
+                }
+                {
+                    DJV_DEBUG_PRINT("seek");
+                    // Seek back and forth, leaving the files that were read
+                    // ahead unopened so that the window is full. The oldest
+                    // files are released to make room for the new reads.
+                    FileBatchReader reader(2, backend);
+                    reader.setByteWindow(2000);
+                    for (int i = 0; i < 10; ++i)
+                    {
+                        const int ahead = i % 2 ? 3 : 0;
+                        const int seek = i % 2 ? 0 : 4;
+                        reader.submit(QStringList() << fileNames[ahead] << fileNames[ahead + 1]);
+                        wait(reader, 2000);
+                        DJV_ASSERT(2000 == reader.pendingBytes());
+                        reader.submit(QStringList() << fileNames[seek]);
+                        FileIO io;
+                        reader.open(fileNames[seek], io);
+                        DJV_ASSERT(1000 == io.size());
+                        DJV_ASSERT(static_cast<quint64>(i + 1) == reader.hits());
+                        DJV_ASSERT(0 == reader.misses());
+                        DJV_ASSERT(reader.pendingBytes() <= 2000);
+                    }
+                    reader.clear(fileNames);
+                    DJV_ASSERT(0 == reader.pendingBytes());
+                }
+                {
+                    DJV_DEBUG_PRINT("allocator");
+                    quint64 allocated = 0;
+                    FileBatchReader reader(2, backend);
+                    reader.setAllocator(
+                        [&allocated](quint64 size)
+                    {
+                        allocated += size;
+                        return new quint8[size];
+                    },
+                        [&allocated](quint8 * p, quint64 size)
+                    {
+                        allocated -= size;
+                        delete [] p;
+                    });
+                    reader.submit(fileNames);
+                    read(reader, fileNames);
+                    DJV_ASSERT(0 == allocated);
+                }
+                {
+                    DJV_DEBUG_PRINT("allocation failure");
+                    FileBatchReader reader(2, backend);
+                    reader.setAllocator(
+                        [](quint64) -> quint8 *
+                    {
+                        throw std::bad_alloc();
+                    },
+                        [](quint8 * p, quint64)
+                    {
+                        delete [] p;
+                    });
+                    reader.submit(fileNames);
+                    read(reader, fileNames);
+                    DJV_ASSERT(0 == reader.hits());
+                    DJV_ASSERT(5 == reader.misses());
+                }
+            }
+            Q_FOREACH(const QString & fileName, fileNames)
+            {
+                QDir().remove(fileName);
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
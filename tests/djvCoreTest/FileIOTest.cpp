@@ -33,6 +33,8 @@
 #include <djvCore/Debug.h>
 #include <djvCore/FileIO.h>
 
+#include <vector>
+
 using namespace djv::Core;
 
 namespace djv
@@ -197,6 +199,95 @@ namespace djv
                 {
                 }
             }
+            writeBuffer();
+            direct();
+        }
+
+        void FileIOTest::writeBuffer()
+        {
+            DJV_DEBUG("FileIOTest::writeBuffer");
+            const QString fileName = "FileIOTest.test";
+            const quint64 writeBufferSizes[] = { 0, 3, 4096, FileIO::writeBufferSizeDefault() };
+            for (auto writeBufferSize : writeBufferSizes)
+            {
+                DJV_DEBUG_PRINT("write buffer size = " << writeBufferSize);
+                std::vector<quint16> data(10000);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<quint16>(i);
+                }
+                const quint8 header[] = { 'D', 'J', 'V' };
+                const quint32 value = 0x01020304;
+                FileIO io;
+                io.setWriteBufferSize(writeBufferSize);
+                DJV_ASSERT(writeBufferSize == io.writeBufferSize());
+                io.setEndian(true);
+                io.open(fileName, FileIO::WRITE);
+                io.set(std::vector<FileIO::Block>
+                {
+                    FileIO::Block(header, 3),
+                    FileIO::Block(&value, 1, 4),
+                    FileIO::Block(data.data(), data.size(), 2)
+                });
+                io.setU16(data.data(), data.size());
+                DJV_ASSERT(3 + 4 + data.size() * 2 * 2 == io.pos());
+                DJV_ASSERT(io.pos() == io.size());
+                io.setPos(3);
+                io.setU32(value + 1);
+                io.close();
+
+                io.open(fileName, FileIO::READ);
+                DJV_ASSERT(3 + 4 + data.size() * 2 * 2 == io.size());
+                quint8 headerRead[3] = { 0, 0, 0 };
+                io.getU8(headerRead, 3);
+                DJV_ASSERT(0 == memcmp(header, headerRead, 3));
+                quint32 valueRead = 0;
+                io.getU32(&valueRead);
+                DJV_ASSERT(value + 1 == valueRead);
+                for (int i = 0; i < 2; ++i)
+                {
+                    std::vector<quint16> dataRead(data.size());
+                    io.getU16(dataRead.data(), dataRead.size());
+                    DJV_ASSERT(data == dataRead);
+                }
+            }
+        }
+
+        void FileIOTest::direct()
+        {
+            DJV_DEBUG("FileIOTest::direct");
+            const QString fileName = "FileIOTest.test";
+            const quint64 alignment = FileIO::directAlignment();
+            const quint64 sizes[] = { 1, alignment - 1, alignment, alignment + 1, 1000000 };
+            for (auto size : sizes)
+            {
+                DJV_DEBUG_PRINT("size = " << size);
+                std::vector<quint8> data(size);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<quint8>(i * 7);
+                }
+                FileIO io;
+                io.open(fileName, FileIO::WRITE);
+                io.set(data.data(), data.size());
+                io.close();
+
+                io.openDirect(fileName);
+                DJV_ASSERT(size == io.size());
+                std::vector<quint8> dataRead(size);
+                io.get(dataRead.data(), dataRead.size());
+                DJV_ASSERT(data == dataRead);
+                io.close();
+            }
+            try
+            {
+                FileIO io;
+                io.openDirect("FileIOTest.missing");
+                DJV_ASSERT(0);
+            }
+            catch (...)
+            {
+            }
         }
 
     } // namespace CoreTest
@@ -39,6 +39,10 @@ namespace djv
         {
         public:
             void run(int &, char **) override;
+
+        private:
+            void writeBuffer();
+            void direct();
         };
 
     } // namespace CoreTest
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/FilePrefetchTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FilePrefetch.h>
+
+#include <QDir>
+
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void FilePrefetchTest::run(int &, char **)
+        {
+            DJV_DEBUG("FilePrefetchTest::run");
+            FileInfo fileInfo("FilePrefetchTest.test");
+            fileInfo.setType(FileInfo::SEQUENCE);
+            fileInfo.setSequence(Sequence(1, 5));
+            const std::vector<quint8> data(1000, 0);
+            for (qint64 frame = 1; frame <= 5; ++frame)
+            {
+                FileIO io;
+                io.open(fileInfo.fileName(frame), FileIO::WRITE);
+                io.set(data.data(), data.size());
+                io.close();
+            }
+            {
+                DJV_DEBUG_PRINT("prefetch");
+                DJV_ASSERT(1000 == FilePrefetch::prefetch(fileInfo.fileName(1)));
+                DJV_ASSERT(0 == FilePrefetch::prefetch("FilePrefetchTest.missing"));
+            }
+            {
+                DJV_DEBUG_PRINT("playhead");
+                FilePrefetch prefetch;
+                DJV_ASSERT(FilePrefetch::frameCountDefault() == prefetch.frameCount());
+                DJV_ASSERT(FilePrefetch::byteWindowDefault() == prefetch.byteWindow());
+                prefetch.setFileInfo(fileInfo);
+                prefetch.setFrameCount(2);
+                prefetch.setPlayhead(0, 1);
+                prefetch.wait();
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+                prefetch.setPlayhead(4, 1);
+                prefetch.wait();
+                DJV_ASSERT(4 == prefetch.playhead());
+                DJV_ASSERT(1 == prefetch.direction());
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+                prefetch.setPlayhead(1, -1);
+                prefetch.wait();
+                DJV_ASSERT(-1 == prefetch.direction());
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+                prefetch.setFrameCount(10);
+                prefetch.wait();
+                DJV_ASSERT(4000 == prefetch.outstandingBytes());
+                prefetch.setFileInfo(FileInfo());
+                prefetch.wait();
+                DJV_ASSERT(0 == prefetch.outstandingBytes());
+            }
+            {
+                DJV_DEBUG_PRINT("byte window");
+                FilePrefetch prefetch;
+                prefetch.setByteWindow(2500);
+                prefetch.setFileInfo(fileInfo);
+                prefetch.wait();
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+            }
+            {
+                DJV_DEBUG_PRINT("frames");
+                FilePrefetch prefetch;
+                prefetch.setFileInfo(fileInfo);
+                prefetch.setFrameCount(2);
+                prefetch.setFrames(FrameList() << 3 << 2 << 1);
+                prefetch.wait();
+                DJV_ASSERT(FrameList() << 3 << 2 << 1 == prefetch.frames());
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+                prefetch.setFrames(FrameList() << 4 << 10);
+                prefetch.wait();
+                DJV_ASSERT(1000 == prefetch.outstandingBytes());
+                prefetch.setFrames(FrameList());
+                prefetch.wait();
+                DJV_ASSERT(0 == prefetch.outstandingBytes());
+                prefetch.setPlayhead(0, 1);
+                prefetch.wait();
+                DJV_ASSERT(prefetch.frames().isEmpty());
+                DJV_ASSERT(2000 == prefetch.outstandingBytes());
+            }
+            for (qint64 frame = 1; frame <= 5; ++frame)
+            {
+                QDir().remove(fileInfo.fileName(frame));
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/ThreadPoolTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/System.h>
+#include <djvCore/ThreadPool.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void ThreadPoolTest::run(int &, char **)
+        {
+            DJV_DEBUG("ThreadPoolTest::run");
+            members();
+            parallelFor();
+        }
+
+        void ThreadPoolTest::members()
+        {
+            DJV_DEBUG("ThreadPoolTest::members");
+            {
+                DJV_DEBUG_PRINT("cpu count = " << System::cpuCount());
+                DJV_ASSERT(System::cpuCount() > 0);
+                ThreadPool pool;
+                DJV_ASSERT(System::cpuCount() == pool.threadCount());
+                pool.setThreadCount(3);
+                DJV_ASSERT(3 == pool.threadCount());
+                pool.setThreadCount(0);
+                DJV_ASSERT(System::cpuCount() == pool.threadCount());
+            }
+            {
+                DJV_ASSERT(ThreadPool::global());
+                DJV_ASSERT(ThreadPool::global() == ThreadPool::global());
+            }
+        }
+
+        void ThreadPoolTest::parallelFor()
+        {
+            DJV_DEBUG("ThreadPoolTest::parallelFor");
+            for (int threadCount = 1; threadCount <= 8; threadCount *= 2)
+            {
+                ThreadPool pool(threadCount);
+                for (int size = 0; size < 100; size += 7)
+                {
+                    // Every value should be visited once.
+                    std::vector<int> values(size, 0);
+                    std::atomic<int> bands(0);
+                    pool.parallelFor(size, 4, [&](int begin, int end)
+                    {
+                        DJV_ASSERT(begin < end);
+                        for (int i = begin; i < end; ++i)
+                        {
+                            ++values[i];
+                        }
+                        ++bands;
+                    });
+                    for (int i = 0; i < size; ++i)
+                    {
+                        DJV_ASSERT(1 == values[i]);
+                    }
+                    DJV_ASSERT(bands <= threadCount);
+                    DJV_ASSERT(size < 8 || 1 == threadCount || bands > 1);
+                }
+            }
+            {
+                // Nested calls should not dead-lock.
+                ThreadPool pool(4);
+                std::atomic<int> count(0);
+                pool.parallelFor(64, 1, [&](int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        pool.parallelFor(64, 1, [&](int begin, int end)
+                        {
+                            count += end - begin;
+                        });
+                    }
+                });
+                DJV_ASSERT(64 * 64 == count);
+            }
+            {
+                // Exceptions should be passed to the calling thread.
+                ThreadPool pool(4);
+                bool error = false;
+                try
+                {
+                    pool.parallelFor(64, 1, [](int begin, int)
+                    {
+                        if (begin > 0)
+                        {
+                            throw std::runtime_error("error");
+                        }
+                    });
+                }
+                catch (const std::exception &)
+                {
+                    error = true;
+                }
+                DJV_ASSERT(error);
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
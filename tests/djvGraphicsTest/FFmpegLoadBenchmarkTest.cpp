@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/FFmpegLoadBenchmarkTest.h>
+
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Timer.h>
+
+#include <QDir>
+#include <QScopedPointer>
+
+#include <algorithm>
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        FFmpegLoadBenchmarkTest::FFmpegLoadBenchmarkTest(bool benchmark) :
+            _benchmark(benchmark)
+        {}
+
+        void FFmpegLoadBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FFmpegLoadBenchmarkTest::run");
+#if defined(FFMPEG_FOUND)
+            Graphics::GraphicsContext context(argc, argv);
+            const int frames = _benchmark ? 60 : 30;
+            const glm::ivec2 size = _benchmark ? glm::ivec2(320, 240) : glm::ivec2(160, 120);
+            const FileInfo fileInfo("FFmpegLoadBenchmarkTest.mov");
+            try
+            {
+                // Write a movie with a moving pattern so that every frame is
+                // different.
+                Graphics::ImageIOInfo info(Graphics::PixelDataInfo(size, Graphics::Pixel::RGBA_U8));
+                info.sequence = Sequence(0, frames - 1);
+                {
+                    QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, info));
+                    Graphics::Image image(info);
+                    for (int frame = 0; frame < frames; ++frame)
+                    {
+                        quint8 * p = image.data();
+                        for (int y = 0; y < size.y; ++y)
+                        {
+                            for (int x = 0; x < size.x; ++x, p += 4)
+                            {
+                                p[0] = (x + frame * 4) % 256;
+                                p[1] = (y + frame * 2) % 256;
+                                p[2] = (((x + frame) / 16 + y / 16) % 2) ? 255 : 64;
+                                p[3] = 255;
+                            }
+                        }
+                        save->write(image, Graphics::ImageIOFrameInfo(frame));
+                    }
+                    save->close();
+                }
+
+                // Read the movie from start to end for reference.
+                std::vector<Graphics::Image> reference(frames);
+                {
+                    Graphics::ImageIOInfo loadInfo;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, loadInfo));
+                    DJV_ASSERT(loadInfo.sequence.frames.count() == frames);
+                    for (int frame = 0; frame < frames; ++frame)
+                    {
+                        load->read(reference[frame], Graphics::ImageIOFrameInfo(frame));
+                    }
+                }
+
+                // Read the movie backwards and in a random order, without and
+                // with the decode cache. The images should match the reference.
+                std::vector<int> reverse;
+                for (int frame = frames - 1; frame >= 0; --frame)
+                {
+                    reverse.push_back(frame);
+                }
+                std::vector<int> random;
+                for (int frame = 0; frame < frames; ++frame)
+                {
+                    random.push_back((frame * 37) % frames);
+                }
+                const QStringList defaultDecodeCache = context.imageIOFactory()->option("FFmpeg", "Decode Cache");
+                const QStringList decodeCaches = QStringList() << "0" << defaultDecodeCache;
+                Q_FOREACH(const QString & decodeCache, decodeCaches)
+                {
+                    QStringList tmp = QStringList() << decodeCache;
+                    context.imageIOFactory()->setOption("FFmpeg", "Decode Cache", tmp);
+                    const std::vector<std::pair<QString, std::vector<int> > > orders =
+                    {
+                        { "reverse", reverse },
+                        { "random", random }
+                    };
+                    for (const auto & order : orders)
+                    {
+                        Graphics::ImageIOInfo loadInfo;
+                        QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, loadInfo));
+                        Graphics::Image image;
+                        Timer timer;
+                        timer.start();
+                        for (const auto frame : order.second)
+                        {
+                            load->read(image, Graphics::ImageIOFrameInfo(frame));
+                            DJV_ASSERT(image.info() == reference[frame].info());
+                            DJV_ASSERT(0 == memcmp(image.data(), reference[frame].data(), image.dataByteCount()));
+                        }
+                        timer.check();
+                        DJV_DEBUG_PRINT(order.first << " decode cache " << decodeCache << " (ms) = " <<
+                            timer.seconds() / frames * 1000.f);
+                    }
+                }
+                QStringList tmp = defaultDecodeCache;
+                context.imageIOFactory()->setOption("FFmpeg", "Decode Cache", tmp);
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+            catch (const std::exception & error)
+            {
+                DJV_DEBUG_PRINT("error = " << error.what());
+                DJV_ASSERT(0);
+            }
+            QDir().remove(fileInfo);
+#endif // FFMPEG_FOUND
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
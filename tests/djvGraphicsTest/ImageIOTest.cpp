@@ -32,11 +32,23 @@
 #include <djvGraphics/Image.h>
 #include <djvGraphics/GraphicsContext.h>
 #include <djvGraphics/ImageIO.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
 #include <djvCore/ErrorUtil.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Math.h>
+#include <djvCore/ThreadPool.h>
+
+#include <QDir>
+
+#if defined(TIFF_FOUND)
+#include <tiffio.h>
+#endif // TIFF_FOUND
+
+#include <algorithm>
+#include <vector>
 
 using namespace djv::Core;
 using namespace djv::Graphics;
@@ -51,6 +63,8 @@ namespace djv
             info();
             plugin(argc, argv);
             io(argc, argv);
+            mapPixelData(argc, argv);
+            tiff(argc, argv);
         }
 
         void ImageIOTest::info()
@@ -184,5 +198,214 @@ namespace djv
             }
         }
 
+        void ImageIOTest::mapPixelData(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageIOTest::mapPixelData");
+            Graphics::GraphicsContext context(argc, argv);
+            const QList<QPair<QString, Graphics::Pixel::PIXEL> > formats = QList<QPair<QString, Graphics::Pixel::PIXEL> >() <<
+                qMakePair(QString(".cin"), Graphics::Pixel::RGB_U10) <<
+                qMakePair(QString(".dpx"), Graphics::Pixel::RGB_U10) <<
+                qMakePair(QString(".ppm"), Graphics::Pixel::RGB_U16) <<
+                qMakePair(QString(".sgi"), Graphics::Pixel::L_U8) <<
+                qMakePair(QString(".tga"), Graphics::Pixel::RGBA_U8);
+            for (const auto & format : formats)
+            {
+                DJV_DEBUG_PRINT("format = " << format.first);
+                const FileInfo fileInfo("ImageIOTest" + format.first);
+                try
+                {
+                    const Graphics::PixelDataInfo pixelDataInfo(64, 32, format.second);
+                    Graphics::Image image(pixelDataInfo);
+                    image.zero();
+                    {
+                        QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, pixelDataInfo));
+                        save->write(image);
+                        save->close();
+                    }
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    load->read(image);
+                    DJV_ASSERT(image.size() == pixelDataInfo.size);
+#if defined(DJV_MMAP)
+                    // The image references the memory-mapped file.
+                    DJV_ASSERT(image.isMapped());
+#endif // DJV_MMAP
+
+                    // Changing a copy of the image makes a copy of the memory, so
+                    // the file is not changed.
+                    const Graphics::Image & mapped = image;
+                    Graphics::Image copy(mapped);
+                    copy.data()[0] = mapped.data()[0] + 1;
+                    DJV_ASSERT(!copy.isMapped());
+                    DJV_ASSERT(copy != mapped);
+
+                    // Proxy images are scaled into their own memory.
+                    load->read(image, Graphics::ImageIOFrameInfo(-1, 0, Graphics::PixelDataInfo::PROXY_1_2));
+                    DJV_ASSERT(!image.isMapped());
+                    load->close();
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                }
+                QDir().remove(fileInfo);
+            }
+        }
+
+        namespace
+        {
+            //! Read a TIFF file with one thread and with many threads, and with
+            //! nearest proxies, and check that the results match. The image
+            //! read with one thread is returned.
+            Graphics::Image tiffRead(Graphics::GraphicsContext & context, const FileInfo & fileInfo)
+            {
+                // The strips and tiles are decoded the same with any number of
+                // threads.
+                Graphics::Image images[2];
+                const int threadCounts[] = { 1, 0 };
+                for (int i = 0; i < 2; ++i)
+                {
+                    ThreadPool::global()->setThreadCount(threadCounts[i]);
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    load->read(images[i]);
+                }
+                ThreadPool::global()->setThreadCount(0);
+                const Graphics::Image & serial = images[0];
+                const Graphics::Image & parallel = images[1];
+                DJV_ASSERT(serial.size() == parallel.size());
+                DJV_ASSERT(0 == memcmp(serial.data(), parallel.data(), serial.dataByteCount()));
+
+                // Proxies that use the nearest pixels only read the scanlines
+                // they need, and match scaling the full image.
+                const Graphics::PixelDataUtil::PROXY_FILTER proxyFilter = Graphics::PixelDataUtil::proxyFilter();
+                Graphics::PixelDataUtil::setProxyFilter(Graphics::PixelDataUtil::PROXY_FILTER_NEAREST);
+                const QList<Graphics::PixelDataInfo::PROXY> proxies = QList<Graphics::PixelDataInfo::PROXY>() <<
+                    Graphics::PixelDataInfo::PROXY_1_2 <<
+                    Graphics::PixelDataInfo::PROXY_1_4 <<
+                    Graphics::PixelDataInfo::PROXY_1_8;
+                Q_FOREACH(Graphics::PixelDataInfo::PROXY proxy, proxies)
+                {
+                    DJV_DEBUG_PRINT("proxy = " << proxy);
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    Graphics::Image proxyImage;
+                    load->read(proxyImage, Graphics::ImageIOFrameInfo(-1, 0, proxy));
+                    Graphics::PixelDataInfo proxyInfo(serial.info());
+                    proxyInfo.size = Graphics::PixelDataUtil::proxyScale(proxyInfo.size, proxy);
+                    proxyInfo.proxy = proxy;
+                    Graphics::PixelData scaled(proxyInfo);
+                    Graphics::PixelDataUtil::proxyScale(serial, scaled, proxy);
+                    DJV_ASSERT(proxyImage.size() == scaled.size());
+                    DJV_ASSERT(0 == memcmp(proxyImage.data(), scaled.data(), scaled.dataByteCount()));
+                }
+                Graphics::PixelDataUtil::setProxyFilter(proxyFilter);
+                return serial;
+            }
+
+#if defined(TIFF_FOUND)
+            //! Write an RGB_U8 image to a tiled file with libTIFF. The tiles do
+            //! not divide the image evenly, so the tiles on the right and bottom
+            //! edges are partially outside of the image.
+            void tiffTiledSave(const QString & fileName, const Graphics::Image & image)
+            {
+                ::TIFF * f = TIFFOpen(fileName.toUtf8().data(), "w");
+                if (!f)
+                {
+                    throw Error("ImageIOTest", "Cannot open: " + fileName);
+                }
+                const int tileWidth = 64;
+                const int tileLength = 48;
+                TIFFSetField(f, TIFFTAG_IMAGEWIDTH, image.w());
+                TIFFSetField(f, TIFFTAG_IMAGELENGTH, image.h());
+                TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, 8);
+                TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, 3);
+                TIFFSetField(f, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_RGB);
+                TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                TIFFSetField(f, TIFFTAG_COMPRESSION, COMPRESSION_LZW);
+                TIFFSetField(f, TIFFTAG_TILEWIDTH, tileWidth);
+                TIFFSetField(f, TIFFTAG_TILELENGTH, tileLength);
+                std::vector<quint8> tile(TIFFTileSize(f));
+                const int pixelByteCount = Graphics::Pixel::byteCount(image.pixel());
+                for (int y0 = 0; y0 < image.h(); y0 += tileLength)
+                {
+                    for (int x0 = 0; x0 < image.w(); x0 += tileWidth)
+                    {
+                        std::fill(tile.begin(), tile.end(), 0);
+                        const int w = Core::Math::min(tileWidth, image.w() - x0);
+                        const int h = Core::Math::min(tileLength, image.h() - y0);
+                        for (int y = 0; y < h; ++y)
+                        {
+                            memcpy(
+                                tile.data() + y * tileWidth * pixelByteCount,
+                                image.data(x0, y0 + y),
+                                w * pixelByteCount);
+                        }
+                        const tmsize_t size = TIFFWriteEncodedTile(
+                            f,
+                            TIFFComputeTile(f, x0, y0, 0, 0),
+                            tile.data(),
+                            tile.size());
+                        DJV_ASSERT(size != -1);
+                    }
+                }
+                TIFFClose(f);
+            }
+#endif // TIFF_FOUND
+
+        } // namespace
+
+        void ImageIOTest::tiff(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageIOTest::tiff");
+            Graphics::GraphicsContext context(argc, argv);
+
+            // Use LZW compression so that the file has many compressed strips.
+            QStringList tmp = QStringList() << "LZW";
+            context.imageIOFactory()->setOption("TIFF", "Compression", tmp);
+            const FileInfo fileInfo("ImageIOTest.tif");
+            const FileInfo tiledFileInfo("ImageIOTestTiled.tif");
+            const Graphics::PixelDataInfo pixelDataInfo(301, 203, Graphics::Pixel::RGB_U8);
+            Graphics::Image image(pixelDataInfo);
+            for (int y = 0; y < image.h(); ++y)
+            {
+                quint8 * p = image.data(0, y);
+                for (quint64 i = 0; i < image.scanlineByteCount(); ++i)
+                {
+                    p[i] = static_cast<quint8>(i * 7 / 5 + y);
+                }
+            }
+            try
+            {
+                {
+                    QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, pixelDataInfo));
+                    save->write(image);
+                    save->close();
+                }
+                DJV_DEBUG_PRINT("strips");
+                const Graphics::Image strips = tiffRead(context, fileInfo);
+                DJV_ASSERT(strips.size() == pixelDataInfo.size);
+
+#if defined(TIFF_FOUND)
+                // Write the same scanlines to a tiled file, which should be read
+                // the same as the strips.
+                DJV_DEBUG_PRINT("tiles");
+                tiffTiledSave(tiledFileInfo.fileName(), strips);
+                const Graphics::Image tiles = tiffRead(context, tiledFileInfo);
+                DJV_ASSERT(tiles.size() == strips.size());
+                DJV_ASSERT(tiles.pixel() == strips.pixel());
+                DJV_ASSERT(tiles.info().mirror == strips.info().mirror);
+                DJV_ASSERT(0 == memcmp(tiles.data(), strips.data(), strips.dataByteCount()));
+#endif // TIFF_FOUND
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+            }
+            QDir().remove(fileInfo);
+            QDir().remove(tiledFileInfo);
+        }
+
     } // namespace GraphicsTest
 } // namespace djv
@@ -44,6 +44,8 @@ namespace djv
             void info();
             void plugin(int &, char **);
             void io(int &, char **);
+            void mapPixelData(int &, char **);
+            void tiff(int &, char **);
         };
 
     } // namespace GraphicsTest
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/ImageLoadBenchmarkTest.h>
+
+#include <djvGraphics/Cineon.h>
+#include <djvGraphics/DPX.h>
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileBatchReader.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
+
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+
+#if defined(DJV_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DJV_LINUX
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        namespace
+        {
+            //! Get the resident memory of the process.
+            quint64 residentBytes()
+            {
+                quint64 out = 0;
+#if defined(DJV_LINUX)
+                QFile file("/proc/self/statm");
+                if (file.open(QIODevice::ReadOnly))
+                {
+                    const QStringList pieces = QString(file.readAll()).split(' ');
+                    if (pieces.count() > 1)
+                    {
+                        out = pieces[1].toULongLong() * ::sysconf(_SC_PAGESIZE);
+                    }
+                }
+#endif // DJV_LINUX
+                return out;
+            }
+
+            //! Get the memory used by the file cache.
+            quint64 cachedBytes()
+            {
+                quint64 out = 0;
+#if defined(DJV_LINUX)
+                QFile file("/proc/meminfo");
+                if (file.open(QIODevice::ReadOnly))
+                {
+                    Q_FOREACH(const QString & line, QString(file.readAll()).split('\n'))
+                    {
+                        const QStringList pieces = line.split(' ', QString::SkipEmptyParts);
+                        if (pieces.count() > 1 && "Cached:" == pieces[0])
+                        {
+                            out = pieces[1].toULongLong() * Memory::kilobyte;
+                        }
+                    }
+                }
+#endif // DJV_LINUX
+                return out;
+            }
+
+            //! Drop a file from the file cache.
+            void dropCache(const QString & fileName)
+            {
+#if defined(DJV_LINUX)
+                const int f = ::open(fileName.toUtf8().data(), O_RDONLY);
+                if (f != -1)
+                {
+                    ::posix_fadvise(f, 0, 0, POSIX_FADV_DONTNEED);
+                    ::close(f);
+                }
+#endif // DJV_LINUX
+            }
+
+        } // namespace
+
+        void ImageLoadBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageLoadBenchmarkTest::run");
+            read(argc, argv, QString());
+            // Also read from memory backed storage when it is available, so that
+            // the overhead of the read methods can be compared without the disk.
+            if (QDir("/dev/shm").exists())
+            {
+                read(argc, argv, "/dev/shm/");
+            }
+        }
+
+        void ImageLoadBenchmarkTest::read(int & argc, char ** argv, const QString & directory)
+        {
+            DJV_DEBUG("ImageLoadBenchmarkTest::read");
+            DJV_DEBUG_PRINT("directory = " << directory);
+            Graphics::GraphicsContext context(argc, argv);
+            const QStringList names = QStringList() <<
+                Graphics::Cineon::staticName <<
+                Graphics::DPX::staticName;
+            const QStringList extensions = QStringList() <<
+                ".cin" <<
+                ".dpx";
+            const QStringList options = QStringList() <<
+                Graphics::Cineon::optionsLabels()[Graphics::Cineon::INPUT_READ_OPTION] <<
+                Graphics::DPX::optionsLabels()[Graphics::DPX::INPUT_READ_OPTION];
+            const int frames = 24;
+            const glm::ivec2 size(2048, 1556);
+            const Graphics::Image image(Graphics::PixelDataInfo(size, Graphics::Pixel::RGB_U10));
+            for (int i = 0; i < extensions.count(); ++i)
+            {
+                FileInfo fileInfo(directory + "ImageLoadBenchmarkTest" + extensions[i]);
+                fileInfo.setType(FileInfo::SEQUENCE);
+                fileInfo.setSequence(Sequence(1, frames));
+                try
+                {
+                    Graphics::ImageIOInfo info(image.info());
+                    info.sequence = fileInfo.sequence();
+                    QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, info));
+                    for (int frame = 1; frame <= frames; ++frame)
+                    {
+                        save->write(image, Graphics::ImageIOFrameInfo(frame));
+                    }
+                    save->close();
+
+                    // Drop the frames from the file cache before each read method,
+                    // and keep the loaded images so that the memory used by the
+                    // cache and the images can be compared.
+                    const quint64 fileSize = FileInfo(fileInfo.fileName(1)).size();
+                    for (int j = 0; j < Graphics::Cineon::READ_COUNT; ++j)
+                    {
+                        QStringList tmp = QStringList() << Graphics::Cineon::readLabels()[j];
+                        context.imageIOFactory()->setOption(names[i], options[i], tmp);
+                        FileBatchReader::global()->clear();
+                        for (int frame = 1; frame <= frames; ++frame)
+                        {
+                            dropCache(fileInfo.fileName(frame));
+                        }
+                        const quint64 resident = residentBytes();
+                        const quint64 cached = cachedBytes();
+                        QList<Graphics::Image> images;
+                        Timer timer;
+                        timer.start();
+                        {
+                            Graphics::ImageIOInfo loadInfo;
+                            QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, loadInfo));
+                            for (int frame = 1; frame <= frames; ++frame)
+                            {
+                                Graphics::Image loadImage;
+                                load->read(loadImage, Graphics::ImageIOFrameInfo(frame));
+                                images += loadImage;
+                            }
+                        }
+                        timer.check();
+                        const float megabytes = fileSize * frames / static_cast<float>(Memory::megabyte);
+                        const float residentMegabytes =
+                            (static_cast<float>(residentBytes()) - resident) / Memory::megabyte;
+                        const float cachedMegabytes =
+                            (static_cast<float>(cachedBytes()) - cached) / Memory::megabyte;
+                        const QString & label = Graphics::Cineon::readLabels()[j];
+                        DJV_DEBUG_PRINT(extensions[i] << " " << label << " (ms) = " << timer.seconds() / frames * 1000.f);
+                        DJV_DEBUG_PRINT(extensions[i] << " " << label << " (MB/s) = " << megabytes / timer.seconds());
+                        DJV_DEBUG_PRINT(extensions[i] << " " << label << " resident (MB) = " << residentMegabytes);
+                        DJV_DEBUG_PRINT(extensions[i] << " " << label << " file cache (MB) = " << cachedMegabytes);
+                    }
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                    DJV_ASSERT(0);
+                }
+                for (int frame = 1; frame <= frames; ++frame)
+                {
+                    QDir().remove(fileInfo.fileName(frame));
+                }
+            }
+            DJV_DEBUG_PRINT("batch hits = " << FileBatchReader::global()->hits());
+            DJV_DEBUG_PRINT("batch misses = " << FileBatchReader::global()->misses());
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
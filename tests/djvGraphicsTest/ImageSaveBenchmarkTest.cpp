@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/ImageSaveBenchmarkTest.h>
+
+#include <djvGraphics/DPX.h>
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/IFF.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+#include <djvGraphics/SGI.h>
+#include <djvGraphics/Targa.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/ThreadPool.h>
+#include <djvCore/Timer.h>
+
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        ImageSaveBenchmarkTest::ImageSaveBenchmarkTest(bool benchmark) :
+            _benchmark(benchmark)
+        {}
+
+        void ImageSaveBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageSaveBenchmarkTest::run");
+            if (_benchmark)
+            {
+                dpx(argc, argv);
+                writeBuffer(argc, argv);
+            }
+            rle(argc, argv);
+        }
+
+        void ImageSaveBenchmarkTest::dpx(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageSaveBenchmarkTest::dpx");
+            Graphics::GraphicsContext context(argc, argv);
+            QStringList tmp = QStringList() << Graphics::DPX::typeLabels()[Graphics::DPX::TYPE_U10];
+            context.imageIOFactory()->setOption(
+                "DPX",
+                Graphics::DPX::optionsLabels()[Graphics::DPX::TYPE_OPTION],
+                tmp);
+            const FileInfo fileInfo("ImageSaveBenchmarkTest.dpx");
+            const int frames = 5;
+            const QList<glm::ivec2> sizes = QList<glm::ivec2>() <<
+                glm::ivec2(2048, 1556) <<
+                glm::ivec2(4096, 3112);
+            Q_FOREACH(const glm::ivec2 & size, sizes)
+            {
+                DJV_DEBUG_PRINT("size = " << size);
+                // The input is 8-bit RGB so that every frame has to be converted
+                // to the 10-bit DPX layout.
+                const Graphics::Image image(Graphics::PixelDataInfo(size, Graphics::Pixel::RGB_U8));
+                const Graphics::ImageIOInfo info(Graphics::PixelDataInfo(size, Graphics::Pixel::RGB_U10));
+                try
+                {
+                    // Create a new saver, and with it a new image converter, for
+                    // every frame.
+                    Timer timer;
+                    timer.start();
+                    for (int i = 0; i < frames; ++i)
+                    {
+                        QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, info));
+                        save->write(image);
+                        save->close();
+                    }
+                    timer.check();
+                    DJV_DEBUG_PRINT("new saver per frame (ms) = " << timer.seconds() / frames * 1000.f);
+
+                    // Re-use the same saver for every frame.
+                    timer.start();
+                    {
+                        QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, info));
+                        for (int i = 0; i < frames; ++i)
+                        {
+                            save->write(image);
+                        }
+                        save->close();
+                    }
+                    timer.check();
+                    DJV_DEBUG_PRINT("persistent saver (ms) = " << timer.seconds() / frames * 1000.f);
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                    DJV_ASSERT(0);
+                }
+            }
+            QDir().remove(fileInfo);
+        }
+
+        void ImageSaveBenchmarkTest::writeBuffer(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageSaveBenchmarkTest::writeBuffer");
+            Graphics::GraphicsContext context(argc, argv);
+            QStringList tmp = QStringList() << Graphics::SGI::compressionLabels()[Graphics::SGI::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::SGI::staticName,
+                Graphics::SGI::optionsLabels()[Graphics::SGI::COMPRESSION_OPTION],
+                tmp);
+            tmp = QStringList() << Graphics::Targa::compressionLabels()[Graphics::Targa::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::Targa::staticName,
+                Graphics::Targa::optionsLabels()[Graphics::Targa::COMPRESSION_OPTION],
+                tmp);
+            const QStringList extensions = QStringList() <<
+                ".cin" <<
+                ".dpx" <<
+                ".iff" <<
+                ".ppm" <<
+                ".sgi" <<
+                ".tga";
+            const int frames = 5;
+            const glm::ivec2 size(2048, 1556);
+            const quint64 writeBufferSizeDefault = FileIO::writeBufferSizeDefault();
+            const QList<quint64> writeBufferSizes = QList<quint64>() <<
+                0 <<
+                writeBufferSizeDefault;
+
+            // Use a gradient so that the run-length encoded formats write many
+            // small packets.
+            Graphics::Image image(Graphics::PixelDataInfo(size, Graphics::Pixel::RGB_U8));
+            for (int y = 0; y < size.y; ++y)
+            {
+                quint8 * p = image.data(0, y);
+                for (int x = 0; x < size.x; ++x, p += 3)
+                {
+                    p[0] = p[1] = p[2] = static_cast<quint8>(x / 8);
+                }
+            }
+            Q_FOREACH(const QString & extension, extensions)
+            {
+                const FileInfo fileInfo("ImageSaveBenchmarkTest" + extension);
+                Q_FOREACH(quint64 writeBufferSize, writeBufferSizes)
+                {
+                    FileIO::setWriteBufferSizeDefault(writeBufferSize);
+                    try
+                    {
+                        QScopedPointer<Graphics::ImageSave> save(
+                            context.imageIOFactory()->save(fileInfo, Graphics::ImageIOInfo(image.info())));
+                        Timer timer;
+                        timer.start();
+                        for (int i = 0; i < frames; ++i)
+                        {
+                            save->write(image);
+                        }
+                        save->close();
+                        timer.check();
+                        DJV_DEBUG_PRINT(extension << " write buffer = " << writeBufferSize <<
+                            " (ms) = " << timer.seconds() / frames * 1000.f);
+                    }
+                    catch (const Error & error)
+                    {
+                        DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                        DJV_ASSERT(0);
+                    }
+                }
+                QDir().remove(fileInfo);
+            }
+            FileIO::setWriteBufferSizeDefault(writeBufferSizeDefault);
+        }
+
+        void ImageSaveBenchmarkTest::rle(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ImageSaveBenchmarkTest::rle");
+            Graphics::GraphicsContext context(argc, argv);
+            QStringList tmp = QStringList() << Graphics::IFF::compressionLabels()[Graphics::IFF::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::IFF::staticName,
+                Graphics::IFF::optionsLabels()[Graphics::IFF::COMPRESSION_OPTION],
+                tmp);
+            tmp = QStringList() << Graphics::SGI::compressionLabels()[Graphics::SGI::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::SGI::staticName,
+                Graphics::SGI::optionsLabels()[Graphics::SGI::COMPRESSION_OPTION],
+                tmp);
+            tmp = QStringList() << Graphics::Targa::compressionLabels()[Graphics::Targa::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::Targa::staticName,
+                Graphics::Targa::optionsLabels()[Graphics::Targa::COMPRESSION_OPTION],
+                tmp);
+            const QStringList extensions = QStringList() <<
+                ".iff" <<
+                ".sgi" <<
+                ".tga";
+            const QList<Graphics::Pixel::PIXEL> pixels = QList<Graphics::Pixel::PIXEL>() <<
+                Graphics::Pixel::RGBA_U8 <<
+                Graphics::Pixel::RGBA_U16;
+            const int frames = _benchmark ? 5 : 1;
+            const glm::ivec2 size = _benchmark ? glm::ivec2(2048, 1556) : glm::ivec2(301, 203);
+            Q_FOREACH(Graphics::Pixel::PIXEL pixel, pixels)
+            {
+                // Mix runs with noise so that both kinds of packets are written.
+                Graphics::Image image(Graphics::PixelDataInfo(size, pixel));
+                for (int y = 0; y < size.y; ++y)
+                {
+                    quint8 * p = image.data(0, y);
+                    for (quint64 i = 0; i < image.scanlineByteCount(); ++i)
+                    {
+                        p[i] = (i / 64) % 2 ? static_cast<quint8>(i * 7 + y * 13) : static_cast<quint8>(y);
+                    }
+                }
+                Q_FOREACH(const QString & extension, extensions)
+                {
+                    // Compress serially and then in parallel, and check that the
+                    // files are the same.
+                    const int threadCounts[] = { 1, 0 };
+                    QByteArray files[2];
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        ThreadPool::global()->setThreadCount(threadCounts[i]);
+                        const FileInfo fileInfo(QString("ImageSaveBenchmarkTest%1").arg(i) + extension);
+                        try
+                        {
+                            QScopedPointer<Graphics::ImageSave> save(
+                                context.imageIOFactory()->save(fileInfo, Graphics::ImageIOInfo(image.info())));
+                            Timer timer;
+                            timer.start();
+                            for (int frame = 0; frame < frames; ++frame)
+                            {
+                                save->write(image);
+                            }
+                            save->close();
+                            timer.check();
+                            DJV_DEBUG_PRINT(extension << " " << Graphics::Pixel::pixelLabels()[pixel] << " threads = " <<
+                                ThreadPool::global()->threadCount() << " (ms) = " <<
+                                timer.seconds() / frames * 1000.f);
+                        }
+                        catch (const Error & error)
+                        {
+                            DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                            DJV_ASSERT(0);
+                        }
+                        QFile file(fileInfo);
+                        if (file.open(QIODevice::ReadOnly))
+                        {
+                            files[i] = file.readAll();
+                        }
+                        file.close();
+                        QDir().remove(fileInfo);
+                    }
+                    DJV_ASSERT(files[0].size() > 0);
+                    DJV_ASSERT(files[0] == files[1]);
+                }
+            }
+            ThreadPool::global()->setThreadCount(0);
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
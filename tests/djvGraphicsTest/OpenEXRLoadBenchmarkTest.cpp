@@ -0,0 +1,554 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/OpenEXRLoadBenchmarkTest.h>
+
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Timer.h>
+
+#include <QDir>
+#include <QScopedPointer>
+
+#if defined(OPENEXR_FOUND)
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfHeader.h>
+#include <ImfInputFile.h>
+#include <ImfOutputFile.h>
+#include <ImfTileDescription.h>
+#include <ImfTiledOutputFile.h>
+#include <half.h>
+#endif // OPENEXR_FOUND
+
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+#if defined(OPENEXR_FOUND)
+        namespace
+        {
+            void insert(Imf::FrameBuffer & frameBuffer, char * p, size_t yStride)
+            {
+                const char * names[] = { "R", "G", "B", "A" };
+                for (int c = 0; c < 4; ++c)
+                {
+                    frameBuffer.insert(
+                        names[c],
+                        Imf::Slice(Imf::HALF, p + c * sizeof(half), 4 * sizeof(half), yStride));
+                }
+            }
+
+            void pixel(half * p, int x, int y, int w, int h)
+            {
+                p[0] = x / static_cast<float>(w);
+                p[1] = y / static_cast<float>(h);
+                p[2] = ((x / 8 + y / 8) % 2) ? 1.f : .25f;
+                p[3] = 1.f;
+            }
+
+            Imf::Header header(
+                const Imath::Box2i & displayWindow,
+                const Imath::Box2i & dataWindow,
+                Imf::Compression     compression)
+            {
+                Imf::Header out(displayWindow, dataWindow);
+                out.compression() = compression;
+                out.channels().insert("R", Imf::Channel(Imf::HALF));
+                out.channels().insert("G", Imf::Channel(Imf::HALF));
+                out.channels().insert("B", Imf::Channel(Imf::HALF));
+                out.channels().insert("A", Imf::Channel(Imf::HALF));
+                return out;
+            }
+
+            //! Write an RGBA file with the given data window.
+            void save(
+                const QString &      fileName,
+                const Imath::Box2i & displayWindow,
+                const Imath::Box2i & dataWindow,
+                Imf::Compression     compression)
+            {
+                const int w = dataWindow.max.x - dataWindow.min.x + 1;
+                const int h = dataWindow.max.y - dataWindow.min.y + 1;
+                std::vector<half> data(w * h * 4);
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        pixel(data.data() + (y * w + x) * 4, x, y, w, h);
+                    }
+                }
+                Imf::FrameBuffer frameBuffer;
+                insert(
+                    frameBuffer,
+                    (char *)(data.data() - (dataWindow.min.x + dataWindow.min.y * w) * 4),
+                    w * 4 * sizeof(half));
+                Imf::OutputFile f(
+                    fileName.toUtf8().data(),
+                    header(displayWindow, dataWindow, compression));
+                f.setFrameBuffer(frameBuffer);
+                f.writePixels(h);
+            }
+
+            //! Write a tiled RGBA file. The levels are point sampled so that
+            //! they match the nearest proxy scaling of the first level.
+            void tiledSave(const QString & fileName, const Imath::Box2i & window, Imf::LevelMode levelMode)
+            {
+                Imf::Header tiledHeader = header(window, window, Imf::PIZ_COMPRESSION);
+                tiledHeader.setTileDescription(Imf::TileDescription(64, 64, levelMode, Imf::ROUND_UP));
+                Imf::TiledOutputFile f(fileName.toUtf8().data(), tiledHeader);
+                const int w = window.max.x - window.min.x + 1;
+                const int h = window.max.y - window.min.y + 1;
+                for (int level = 0; level < f.numLevels(); ++level)
+                {
+                    const int scale = 1 << level;
+                    const int levelW = f.levelWidth(level);
+                    const int levelH = f.levelHeight(level);
+                    std::vector<half> data(levelW * levelH * 4);
+                    for (int y = 0; y < levelH; ++y)
+                    {
+                        for (int x = 0; x < levelW; ++x)
+                        {
+                            pixel(data.data() + (y * levelW + x) * 4, x * scale, y * scale, w, h);
+                        }
+                    }
+                    Imf::FrameBuffer frameBuffer;
+                    insert(
+                        frameBuffer,
+                        (char *)(data.data() - (window.min.x + window.min.y * levelW) * 4),
+                        levelW * 4 * sizeof(half));
+                    f.setFrameBuffer(frameBuffer);
+                    f.writeTiles(0, f.numXTiles(level) - 1, 0, f.numYTiles(level) - 1, level);
+                }
+            }
+
+            //! Read a file one scanline at a time into the display window, which
+            //! is how the loader used to read files with a data window.
+            std::vector<half> scanlineLoad(const QString & fileName)
+            {
+                Imf::InputFile f(fileName.toUtf8().data());
+                const Imath::Box2i displayWindow = f.header().displayWindow();
+                const Imath::Box2i dataWindow = f.header().dataWindow();
+                const int w = displayWindow.max.x - displayWindow.min.x + 1;
+                const int h = displayWindow.max.y - displayWindow.min.y + 1;
+                const int dataW = dataWindow.max.x - dataWindow.min.x + 1;
+                std::vector<half> out(w * h * 4, half(0.f));
+                std::vector<half> buf(dataW * 4);
+                Imf::FrameBuffer frameBuffer;
+                insert(frameBuffer, (char *)(buf.data() - dataWindow.min.x * 4), 0);
+                f.setFrameBuffer(frameBuffer);
+                for (int y = displayWindow.min.y; y <= displayWindow.max.y; ++y)
+                {
+                    if (y < dataWindow.min.y || y > dataWindow.max.y)
+                        continue;
+                    f.readPixels(y, y);
+                    for (int x = displayWindow.min.x; x <= displayWindow.max.x; ++x)
+                    {
+                        if (x < dataWindow.min.x || x > dataWindow.max.x)
+                            continue;
+                        memcpy(
+                            out.data() + ((y - displayWindow.min.y) * w + x - displayWindow.min.x) * 4,
+                            buf.data() + (x - dataWindow.min.x) * 4,
+                            4 * sizeof(half));
+                    }
+                }
+                return out;
+            }
+
+            //! Write a file with many layers and a small image, so that the
+            //! header is a large part of the file.
+            void channelsSave(const QString & fileName, int layers)
+            {
+                const Imath::Box2i window(Imath::V2i(0, 0), Imath::V2i(255, 255));
+                Imf::Header header(window, window);
+                header.compression() = Imf::ZIP_COMPRESSION;
+                const char * names[] = { "R", "G", "B", "A" };
+                for (int i = 0; i < layers; ++i)
+                {
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        header.channels().insert(
+                            QString("aov%1.%2").arg(i).arg(names[c]).toUtf8().data(),
+                            Imf::Channel(Imf::HALF));
+                    }
+                }
+                std::vector<half> data(256 * 256);
+                for (int y = 0; y < 256; ++y)
+                {
+                    for (int x = 0; x < 256; ++x)
+                    {
+                        data[y * 256 + x] = (x + y) / 512.f;
+                    }
+                }
+                Imf::FrameBuffer frameBuffer;
+                for (auto i = header.channels().begin(); i != header.channels().end(); ++i)
+                {
+                    frameBuffer.insert(
+                        i.name(),
+                        Imf::Slice(Imf::HALF, (char *)data.data(), sizeof(half), 256 * sizeof(half)));
+                }
+                Imf::OutputFile f(fileName.toUtf8().data(), header);
+                f.setFrameBuffer(frameBuffer);
+                f.writePixels(256);
+            }
+
+        } // namespace
+#endif // OPENEXR_FOUND
+
+        OpenEXRLoadBenchmarkTest::OpenEXRLoadBenchmarkTest(bool benchmark) :
+            _benchmark(benchmark)
+        {}
+
+        void OpenEXRLoadBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenEXRLoadBenchmarkTest::run");
+            scanlines(argc, argv);
+            tiles(argc, argv);
+            channels(argc, argv);
+        }
+
+        void OpenEXRLoadBenchmarkTest::scanlines(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenEXRLoadBenchmarkTest::scanlines");
+#if defined(OPENEXR_FOUND)
+            Graphics::GraphicsContext context(argc, argv);
+            struct Compression
+            {
+                QString          label;
+                Imf::Compression compression;
+            };
+            const std::vector<Compression> compressions =
+            {
+                { "PIZ", Imf::PIZ_COMPRESSION },
+#if OPENEXR_VERSION_HEX >= 0x02020000
+                { "DWAA", Imf::DWAA_COMPRESSION },
+#endif // OPENEXR_VERSION_HEX
+                { "ZIP", Imf::ZIP_COMPRESSION }
+            };
+
+            // Overscan has a data window that is larger than the display window,
+            // and a crop has a data window that is inside the display window.
+            struct Window
+            {
+                QString      label;
+                Imath::Box2i dataWindow;
+            };
+            const glm::ivec2 size = _benchmark ? glm::ivec2(2048, 1556) : glm::ivec2(512, 389);
+            const int overscan = size.x / 32;
+            const Imath::Box2i displayWindow(Imath::V2i(0, 0), Imath::V2i(size.x - 1, size.y - 1));
+            const std::vector<Window> windows =
+            {
+                {
+                    "overscan",
+                    Imath::Box2i(
+                        Imath::V2i(-overscan, -overscan),
+                        Imath::V2i(size.x - 1 + overscan, size.y - 1 + overscan))
+                },
+                {
+                    "crop",
+                    Imath::Box2i(
+                        Imath::V2i(size.x * 3 / 20, size.y / 8),
+                        Imath::V2i(size.x * 5 / 6, size.y * 5 / 6))
+                }
+            };
+            const int frames = _benchmark ? 10 : 1;
+            const FileInfo fileInfo("OpenEXRLoadBenchmarkTest.exr");
+            const QString fileName = fileInfo.fileName();
+            for (const auto & compression : compressions)
+            {
+                for (const auto & window : windows)
+                {
+                    const QString label = compression.label + " " + window.label;
+                    try
+                    {
+                        save(fileName, displayWindow, window.dataWindow, compression.compression);
+                        const std::vector<half> scanlines = scanlineLoad(fileName);
+
+                        // Time reading the file one scanline at a time, and with
+                        // the loader using one thread and then many threads.
+                        Timer timer;
+                        timer.start();
+                        for (int frame = 0; frame < frames; ++frame)
+                        {
+                            scanlineLoad(fileName);
+                        }
+                        timer.check();
+                        DJV_DEBUG_PRINT(label << " scanlines (ms) = " << timer.seconds() / frames * 1000.f);
+                        const int threadCounts[] = { 1, 8 };
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            QStringList tmp = QStringList() << QString::number(threadCounts[i]);
+                            context.imageIOFactory()->setOption("OpenEXR", "Thread Count", tmp);
+                            Graphics::ImageIOInfo info;
+                            QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                            Graphics::Image image;
+                            timer.start();
+                            for (int frame = 0; frame < frames; ++frame)
+                            {
+                                load->read(image);
+                            }
+                            timer.check();
+                            DJV_DEBUG_PRINT(label << " threads " << threadCounts[i] << " (ms) = " <<
+                                timer.seconds() / frames * 1000.f);
+                            DJV_ASSERT(image.size() == size);
+                            DJV_ASSERT(Graphics::Pixel::RGBA_F16 == image.pixel());
+                            DJV_ASSERT(0 == memcmp(image.data(), scanlines.data(), image.dataByteCount()));
+                        }
+                    }
+                    catch (const Error & error)
+                    {
+                        DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                        DJV_ASSERT(0);
+                    }
+                    catch (const std::exception & error)
+                    {
+                        DJV_DEBUG_PRINT("error = " << error.what());
+                        DJV_ASSERT(0);
+                    }
+                    QDir().remove(fileName);
+                }
+            }
+            QStringList tmp = QStringList() << "4";
+            context.imageIOFactory()->setOption("OpenEXR", "Thread Count", tmp);
+#endif // OPENEXR_FOUND
+        }
+
+        void OpenEXRLoadBenchmarkTest::tiles(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenEXRLoadBenchmarkTest::tiles");
+#if defined(OPENEXR_FOUND)
+            Graphics::GraphicsContext context(argc, argv);
+            const Graphics::PixelDataUtil::PROXY_FILTER proxyFilter = Graphics::PixelDataUtil::proxyFilter();
+            Graphics::PixelDataUtil::setProxyFilter(Graphics::PixelDataUtil::PROXY_FILTER_NEAREST);
+            struct Levels
+            {
+                QString        label;
+                Imf::LevelMode levelMode;
+            };
+            const std::vector<Levels> levels =
+            {
+                { "one level", Imf::ONE_LEVEL },
+                { "mip-map", Imf::MIPMAP_LEVELS }
+            };
+            const glm::ivec2 size = _benchmark ? glm::ivec2(2048, 1556) : glm::ivec2(512, 389);
+            const Imath::Box2i window(Imath::V2i(0, 0), Imath::V2i(size.x - 1, size.y - 1));
+            const int frames = _benchmark ? 10 : 1;
+            const FileInfo fileInfo("OpenEXRLoadBenchmarkTest.exr");
+            for (const auto & i : levels)
+            {
+                try
+                {
+                    tiledSave(fileInfo.fileName(), window, i.levelMode);
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    Graphics::Image image;
+                    Timer timer;
+                    timer.start();
+                    for (int frame = 0; frame < frames; ++frame)
+                    {
+                        load->read(image);
+                    }
+                    timer.check();
+                    DJV_DEBUG_PRINT(i.label << " (ms) = " << timer.seconds() / frames * 1000.f);
+                    DJV_ASSERT(image.size() == size);
+                    DJV_ASSERT(Graphics::Pixel::RGBA_F16 == image.pixel());
+
+                    // Proxies are read from the matching level when the file has
+                    // them, and match scaling the full image.
+                    const QList<Graphics::PixelDataInfo::PROXY> proxies = QList<Graphics::PixelDataInfo::PROXY>() <<
+                        Graphics::PixelDataInfo::PROXY_1_2 <<
+                        Graphics::PixelDataInfo::PROXY_1_4 <<
+                        Graphics::PixelDataInfo::PROXY_1_8;
+                    Q_FOREACH(Graphics::PixelDataInfo::PROXY proxy, proxies)
+                    {
+                        Graphics::Image proxyImage;
+                        timer.start();
+                        for (int frame = 0; frame < frames; ++frame)
+                        {
+                            load->read(proxyImage, Graphics::ImageIOFrameInfo(-1, 0, proxy));
+                        }
+                        timer.check();
+                        DJV_DEBUG_PRINT(i.label << " proxy " << proxy << " (ms) = " <<
+                            timer.seconds() / frames * 1000.f);
+                        Graphics::PixelDataInfo proxyInfo(image.info());
+                        proxyInfo.size = Graphics::PixelDataUtil::proxyScale(proxyInfo.size, proxy);
+                        proxyInfo.proxy = proxy;
+                        Graphics::PixelData scaled(proxyInfo);
+                        Graphics::PixelDataUtil::proxyScale(image, scaled, proxy);
+                        DJV_ASSERT(proxyImage.size() == scaled.size());
+                        DJV_ASSERT(0 == memcmp(proxyImage.data(), scaled.data(), scaled.dataByteCount()));
+                    }
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                    DJV_ASSERT(0);
+                }
+                catch (const std::exception & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << error.what());
+                    DJV_ASSERT(0);
+                }
+                QDir().remove(fileInfo);
+            }
+            Graphics::PixelDataUtil::setProxyFilter(proxyFilter);
+#endif // OPENEXR_FOUND
+        }
+
+        void OpenEXRLoadBenchmarkTest::channels(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenEXRLoadBenchmarkTest::channels");
+#if defined(OPENEXR_FOUND)
+            Graphics::GraphicsContext context(argc, argv);
+            const int layers = _benchmark ? 50 : 10;
+            const int frames = _benchmark ? 24 : 2;
+            FileInfo fileInfo("OpenEXRLoadBenchmarkTest.exr");
+            fileInfo.setType(FileInfo::SEQUENCE);
+            fileInfo.setSequence(Sequence(1, frames));
+            try
+            {
+                for (int frame = 1; frame <= frames; ++frame)
+                {
+                    channelsSave(fileInfo.fileName(frame), layers);
+                }
+
+                // Read the sequence with a single loader, which re-uses the
+                // layers between frames, and then with a new loader for each
+                // frame, which has to build the layers every time.
+                const int layer = layers / 2;
+                Graphics::Image images[2];
+                int layerCounts[2] = { 0, 0 };
+                Timer timer;
+                timer.start();
+                {
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    for (int frame = 1; frame <= frames; ++frame)
+                    {
+                        load->read(images[0], Graphics::ImageIOFrameInfo(frame, layer));
+                    }
+                    layerCounts[0] = info.layerCount();
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("channels = " << layers * 4);
+                DJV_DEBUG_PRINT("layers re-used (ms) = " << timer.seconds() / frames * 1000.f);
+                timer.start();
+                for (int frame = 1; frame <= frames; ++frame)
+                {
+                    Graphics::ImageIOInfo info;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                    load->read(images[1], Graphics::ImageIOFrameInfo(frame, layer));
+                    layerCounts[1] = info.layerCount();
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("layers rebuilt (ms) = " << timer.seconds() / frames * 1000.f);
+                DJV_ASSERT(layerCounts[0] == layerCounts[1]);
+                DJV_ASSERT(images[0].info().layerName == images[1].info().layerName);
+                DJV_ASSERT(images[0].size() == images[1].size());
+                DJV_ASSERT(images[0].pixel() == images[1].pixel());
+                DJV_ASSERT(0 == memcmp(images[0].data(), images[1].data(), images[0].dataByteCount()));
+
+                // Read several layers of the sequence with a single pass over
+                // each file, and then with a pass for each layer.
+                QVector<int> layerList;
+                for (int i = 0; i < layers; i += 5)
+                {
+                    layerList += i;
+                }
+                std::vector<Graphics::Image> layerImages[2];
+                layerImages[0].resize(layerList.count());
+                layerImages[1].resize(layerList.count());
+                QVector<Graphics::Image *> pointers;
+                for (auto & i : layerImages[0])
+                {
+                    pointers += &i;
+                }
+                Graphics::ImageIOInfo info;
+                QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                timer.start();
+                for (int frame = 1; frame <= frames; ++frame)
+                {
+                    load->readLayers(pointers, layerList, Graphics::ImageIOFrameInfo(frame));
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("layers = " << layerList.count());
+                DJV_DEBUG_PRINT("single pass (ms) = " << timer.seconds() / frames * 1000.f);
+                timer.start();
+                for (int frame = 1; frame <= frames; ++frame)
+                {
+                    for (int i = 0; i < layerList.count(); ++i)
+                    {
+                        load->read(layerImages[1][i], Graphics::ImageIOFrameInfo(frame, layerList[i]));
+                    }
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("pass per layer (ms) = " << timer.seconds() / frames * 1000.f);
+                for (int i = 0; i < layerList.count(); ++i)
+                {
+                    const Graphics::Image & a = layerImages[0][i];
+                    const Graphics::Image & b = layerImages[1][i];
+                    DJV_ASSERT(a.info().layerName == info[layerList[i]].layerName);
+                    DJV_ASSERT(a.info().layerName == b.info().layerName);
+                    DJV_ASSERT(a.size() == b.size());
+                    DJV_ASSERT(a.pixel() == b.pixel());
+                    DJV_ASSERT(0 == memcmp(a.data(), b.data(), a.dataByteCount()));
+                }
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+            catch (const std::exception & error)
+            {
+                DJV_DEBUG_PRINT("error = " << error.what());
+                DJV_ASSERT(0);
+            }
+            for (int frame = 1; frame <= frames; ++frame)
+            {
+                QDir().remove(fileInfo.fileName(frame));
+            }
+#endif // OPENEXR_FOUND
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
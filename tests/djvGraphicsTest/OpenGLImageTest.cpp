@@ -33,9 +33,11 @@
 #include <djvGraphics/OpenGL.h>
 #include <djvGraphics/OpenGLImage.h>
 #include <djvGraphics/OpenGLOffscreenBuffer.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
+#include <djvCore/Math.h>
 
 #include <QPixmap>
 #include <QScopedPointer>
@@ -54,6 +56,7 @@ namespace djv
             ctors();
             members(argc, argv);
             convert(argc, argv);
+            software(argc, argv);
             operators();
         }
 
@@ -137,6 +140,159 @@ namespace djv
             Graphics::OpenGLImage().toQt(data);
         }
 
+        namespace
+        {
+            Graphics::PixelData softwareInput(const glm::ivec2 & size, Graphics::Pixel::PIXEL pixel)
+            {
+                Graphics::PixelData out(Graphics::PixelDataInfo(size, pixel));
+                for (int y = 0; y < size.y; ++y)
+                {
+                    for (int x = 0; x < size.x; ++x)
+                    {
+                        const Graphics::Pixel::F32_T p[] =
+                        {
+                            x / static_cast<float>(size.x - 1),
+                            y / static_cast<float>(size.y - 1),
+                            (x + y) / static_cast<float>(size.x + size.y - 2),
+                            1.f - x / static_cast<float>(size.x - 1)
+                        };
+                        Graphics::Pixel::convert(p, Graphics::Pixel::RGBA_F32, out.data(x, y), pixel);
+                    }
+                }
+                return out;
+            }
+
+            float softwareCompare(
+                const Graphics::PixelData &          input,
+                const Graphics::PixelDataInfo &      outputInfo,
+                const Graphics::OpenGLImageOptions & options)
+            {
+                Graphics::PixelData a(outputInfo);
+                Graphics::PixelData b(outputInfo);
+                Graphics::OpenGLImage::setSoftwareCopy(false);
+                Graphics::OpenGLImage().copy(input, a, options);
+                Graphics::OpenGLImage::setSoftwareCopy(true);
+                Graphics::OpenGLImage().copy(input, b, options);
+                Graphics::OpenGLImage::setSoftwareCopy(false);
+                const Graphics::PixelData & _a = a;
+                const Graphics::PixelData & _b = b;
+                const Graphics::Pixel::PIXEL pixel = Graphics::Pixel::pixel(
+                    Graphics::Pixel::format(outputInfo.pixel),
+                    Graphics::Pixel::F32);
+                const int channels = Graphics::Pixel::channels(pixel);
+                float out = 0.f;
+                for (int y = 0; y < outputInfo.size.y; ++y)
+                {
+                    for (int x = 0; x < outputInfo.size.x; ++x)
+                    {
+                        Graphics::Pixel::F32_T pa[Graphics::Pixel::channelsMax];
+                        Graphics::Pixel::F32_T pb[Graphics::Pixel::channelsMax];
+                        Graphics::Pixel::convert(_a.data(x, y), outputInfo.pixel, pa, pixel);
+                        Graphics::Pixel::convert(_b.data(x, y), outputInfo.pixel, pb, pixel);
+                        for (int c = 0; c < channels; ++c)
+                        {
+                            out = Math::max(out, Math::abs(pa[c] - pb[c]));
+                        }
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        void OpenGLImageTest::software(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenGLImageTest::software");
+            Graphics::GraphicsContext context(argc, argv);
+            const glm::ivec2 size(64, 32);
+            {
+                DJV_DEBUG_PRINT("pixels");
+                for (int i = 0; i < Graphics::Pixel::PIXEL_COUNT; ++i)
+                {
+                    const Graphics::Pixel::PIXEL pixel = static_cast<Graphics::Pixel::PIXEL>(i);
+                    const Graphics::PixelData input = softwareInput(size, pixel);
+                    for (int j = 0; j < Graphics::Pixel::PIXEL_COUNT; ++j)
+                    {
+                        const float diff = softwareCompare(
+                            input,
+                            Graphics::PixelDataInfo(size, static_cast<Graphics::Pixel::PIXEL>(j)),
+                            Graphics::OpenGLImageOptions());
+                        DJV_DEBUG_PRINT(pixel << " " << static_cast<Graphics::Pixel::PIXEL>(j) << " = " << diff);
+                        DJV_ASSERT(diff < .01f);
+                    }
+                }
+            }
+            const Graphics::PixelData input = softwareInput(size, Graphics::Pixel::RGBA_U16);
+            const Graphics::PixelDataInfo outputInfo(size, Graphics::Pixel::RGBA_F32);
+            {
+                DJV_DEBUG_PRINT("color profiles");
+                Graphics::OpenGLImageOptions options;
+                options.colorProfile.type = Graphics::ColorProfile::GAMMA;
+                DJV_ASSERT(softwareCompare(input, outputInfo, options) < .01f);
+                options.colorProfile.type = Graphics::ColorProfile::EXPOSURE;
+                options.colorProfile.exposure = Graphics::ColorProfile::Exposure(1.f, .01f, 0.f, 5.f);
+                DJV_ASSERT(softwareCompare(input, outputInfo, options) < .01f);
+                options.colorProfile.type = Graphics::ColorProfile::LUT;
+                options.colorProfile.lut.set(Graphics::PixelDataInfo(256, 1, Graphics::Pixel::L_F32));
+                Graphics::PixelDataUtil::gradient(options.colorProfile.lut);
+                DJV_ASSERT(softwareCompare(input, outputInfo, options) < .01f);
+            }
+            {
+                DJV_DEBUG_PRINT("display profile");
+                Graphics::OpenGLImageOptions options;
+                options.displayProfile.color.brightness = 1.5f;
+                options.displayProfile.levels.inLow = .1f;
+                options.displayProfile.levels.inHigh = .9f;
+                options.displayProfile.levels.gamma = 2.f;
+                options.displayProfile.softClip = .2f;
+                DJV_ASSERT(softwareCompare(input, outputInfo, options) < .01f);
+            }
+            {
+                DJV_DEBUG_PRINT("channels");
+                for (int i = 0; i < Graphics::OpenGLImageOptions::CHANNEL_COUNT; ++i)
+                {
+                    Graphics::OpenGLImageOptions options;
+                    options.channel = static_cast<Graphics::OpenGLImageOptions::CHANNEL>(i);
+                    DJV_ASSERT(softwareCompare(input, outputInfo, options) < .01f);
+                }
+            }
+            {
+                DJV_DEBUG_PRINT("mirror");
+                Graphics::OpenGLImageOptions options;
+                options.xform.mirror = Graphics::PixelDataInfo::Mirror(true, false);
+                Graphics::PixelDataInfo info = outputInfo;
+                info.mirror = Graphics::PixelDataInfo::Mirror(false, true);
+                DJV_ASSERT(softwareCompare(input, info, options) < .01f);
+            }
+            {
+                DJV_DEBUG_PRINT("filters");
+                const Graphics::OpenGLImageFilter::FILTER filters[] =
+                {
+                    Graphics::OpenGLImageFilter::LINEAR,
+                    Graphics::OpenGLImageFilter::BOX,
+                    Graphics::OpenGLImageFilter::LANCZOS3,
+                    Graphics::OpenGLImageFilter::MITCHELL
+                };
+                const float scales[] = { .5f, 2.f };
+                for (auto filter : filters)
+                {
+                    for (auto scale : scales)
+                    {
+                        Graphics::OpenGLImageOptions options;
+                        options.xform.scale = glm::vec2(scale, scale);
+                        options.filter = Graphics::OpenGLImageFilter(filter, filter);
+                        const Graphics::PixelDataInfo info(
+                            Math::ceil(size.x * scale),
+                            Math::ceil(size.y * scale),
+                            Graphics::Pixel::RGBA_F32);
+                        const float diff = softwareCompare(input, info, options);
+                        DJV_DEBUG_PRINT(filter << " " << scale << " = " << diff);
+                        DJV_ASSERT(diff < .05f);
+                    }
+                }
+            }
+        }
+
         void OpenGLImageTest::operators()
         {
             DJV_DEBUG("OpenGLImageTest::operators");
@@ -44,6 +44,7 @@ namespace djv
             void ctors();
             void members(int &, char **);
             void convert(int &, char **);
+            void software(int &, char **);
             void operators();
         };
 
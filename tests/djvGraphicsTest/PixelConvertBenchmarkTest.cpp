@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/PixelConvertBenchmarkTest.h>
+
+#include <djvGraphics/Pixel.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/Timer.h>
+
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        void PixelConvertBenchmarkTest::run(int &, char **)
+        {
+            DJV_DEBUG("PixelConvertBenchmarkTest::run");
+            DJV_DEBUG_PRINT("cpu = " << Graphics::Pixel::cpuSIMD());
+            const Graphics::Pixel::SIMD simd = Graphics::Pixel::convertSIMD();
+            const int size = 4096;
+            const int rows = 256;
+            std::vector<quint8> in(size * Graphics::Pixel::byteCount(Graphics::Pixel::RGBA_F32), 0);
+            std::vector<quint8> out(in.size(), 0);
+            for (int i = 0; i < Graphics::Pixel::PIXEL_COUNT; ++i)
+            {
+                for (int j = 0; j < Graphics::Pixel::PIXEL_COUNT; ++j)
+                {
+                    for (int k = Graphics::Pixel::SIMD_NONE; k <= Graphics::Pixel::cpuSIMD(); ++k)
+                    {
+                        Graphics::Pixel::setConvertSIMD(static_cast<Graphics::Pixel::SIMD>(k));
+                        Timer timer;
+                        timer.start();
+                        for (int row = 0; row < rows; ++row)
+                        {
+                            Graphics::Pixel::convert(
+                                in.data(),
+                                static_cast<Graphics::Pixel::PIXEL>(i),
+                                out.data(),
+                                static_cast<Graphics::Pixel::PIXEL>(j),
+                                size);
+                        }
+                        timer.check();
+                        DJV_DEBUG_PRINT(
+                            static_cast<Graphics::Pixel::PIXEL>(i) << " -> " <<
+                            static_cast<Graphics::Pixel::PIXEL>(j) << " simd = " << k <<
+                            " (Mpix/s) = " << size * rows / timer.seconds() / 1000000.f);
+                    }
+                }
+            }
+            Graphics::Pixel::setConvertSIMD(simd);
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/PixelDataPoolTest.h>
+
+#include <djvGraphics/PixelData.h>
+#include <djvGraphics/PixelDataPool.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Memory.h>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        void PixelDataPoolTest::run(int &, char **)
+        {
+            DJV_DEBUG("PixelDataPoolTest::run");
+            bucketSize();
+            members();
+            budget();
+            pixelData();
+        }
+
+        void PixelDataPoolTest::bucketSize()
+        {
+            DJV_DEBUG("PixelDataPoolTest::bucketSize");
+            DJV_ASSERT(0 == Graphics::PixelDataPool::bucketSize(0));
+            DJV_ASSERT(4096 == Graphics::PixelDataPool::bucketSize(1));
+            DJV_ASSERT(4096 == Graphics::PixelDataPool::bucketSize(4096));
+            DJV_ASSERT(8192 == Graphics::PixelDataPool::bucketSize(4097));
+            DJV_ASSERT(Core::Memory::megabyte == Graphics::PixelDataPool::bucketSize(Core::Memory::megabyte));
+            DJV_ASSERT(
+                Core::Memory::megabyte + Core::Memory::megabyte / 8 ==
+                Graphics::PixelDataPool::bucketSize(Core::Memory::megabyte + 1));
+            for (quint64 size = 1; size < 64 * Core::Memory::megabyte; size = size * 3 + 1)
+            {
+                const quint64 bucket = Graphics::PixelDataPool::bucketSize(size);
+                DJV_ASSERT(bucket >= size);
+                DJV_ASSERT(bucket == Graphics::PixelDataPool::bucketSize(bucket));
+                DJV_ASSERT(bucket - size < 4096 || bucket - size <= size / 8);
+            }
+        }
+
+        void PixelDataPoolTest::members()
+        {
+            DJV_DEBUG("PixelDataPoolTest::members");
+            Graphics::PixelDataPool pool;
+            DJV_ASSERT(!pool.acquire(0));
+            quint8 * a = pool.acquire(10000);
+            DJV_ASSERT(a);
+            DJV_ASSERT(0 == reinterpret_cast<quintptr>(a) % 4096);
+            a[9999] = 1;
+            DJV_ASSERT(0 == pool.hits());
+            DJV_ASSERT(1 == pool.misses());
+            DJV_ASSERT(Graphics::PixelDataPool::bucketSize(10000) == pool.outstandingBytes());
+            pool.release(a, 10000);
+            DJV_ASSERT(0 == pool.outstandingBytes());
+            DJV_ASSERT(Graphics::PixelDataPool::bucketSize(10000) == pool.pooledBytes());
+
+            // A request in the same bucket re-uses the buffer.
+            quint8 * b = pool.acquire(9000);
+            DJV_ASSERT(a == b);
+            DJV_ASSERT(1 == pool.hits());
+            DJV_ASSERT(0 == pool.pooledBytes());
+
+            // A request in a different bucket allocates a new buffer.
+            quint8 * c = pool.acquire(100000);
+            DJV_ASSERT(c != b);
+            DJV_ASSERT(2 == pool.misses());
+            pool.release(b, 9000);
+            pool.release(c, 100000);
+            pool.clear();
+            DJV_ASSERT(0 == pool.pooledBytes());
+        }
+
+        void PixelDataPoolTest::budget()
+        {
+            DJV_DEBUG("PixelDataPoolTest::budget");
+            Graphics::PixelDataPool pool;
+            pool.setBudget(2 * 4096);
+            DJV_ASSERT(2 * 4096 == pool.budget());
+            quint8 * a = pool.acquire(4096);
+            quint8 * b = pool.acquire(4096);
+            quint8 * c = pool.acquire(4096);
+            DJV_ASSERT(3 * 4096 == pool.outstandingBytes());
+            pool.release(a, 4096);
+            pool.release(b, 4096);
+            pool.release(c, 4096);
+            DJV_ASSERT(2 * 4096 == pool.pooledBytes());
+
+            // The least recently released buffer is freed first.
+            DJV_ASSERT(c == pool.acquire(4096));
+            DJV_ASSERT(b == pool.acquire(4096));
+            pool.release(b, 4096);
+            pool.release(c, 4096);
+            pool.setBudget(0);
+            DJV_ASSERT(0 == pool.pooledBytes());
+            pool.setHugePages(true);
+            DJV_ASSERT(pool.hasHugePages());
+            quint8 * d = pool.acquire(4 * Core::Memory::megabyte);
+            d[0] = 1;
+            pool.release(d, 4 * Core::Memory::megabyte);
+            DJV_ASSERT(0 == pool.pooledBytes());
+        }
+
+        void PixelDataPoolTest::pixelData()
+        {
+            DJV_DEBUG("PixelDataPoolTest::pixelData");
+            Graphics::PixelDataPool * pool = Graphics::PixelDataPool::global();
+            const Graphics::PixelDataInfo info(100, 100, Graphics::Pixel::RGBA_U8);
+            const quint8 * p = nullptr;
+            {
+                Graphics::PixelData data(info);
+                p = data.data();
+                DJV_ASSERT(pool->outstandingBytes() >= data.dataByteCount());
+            }
+            const quint64 hits = pool->hits();
+            {
+                // Pixel data of the same size re-uses the buffer.
+                Graphics::PixelData data(info);
+                DJV_ASSERT(p == data.data());
+                DJV_ASSERT(hits + 1 == pool->hits());
+
+                // Setting the same size keeps the buffer.
+                data.set(info);
+                DJV_ASSERT(p == data.data());
+                DJV_ASSERT(hits + 1 == pool->hits());
+            }
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
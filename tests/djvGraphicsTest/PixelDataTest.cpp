@@ -29,6 +29,7 @@
 
 #include <djvGraphicsTest/PixelDataTest.h>
 
+#include <djvGraphics/Image.h>
 #include <djvGraphics/PixelData.h>
 
 #include <djvCore/Assert.h>
@@ -48,6 +49,7 @@ namespace djv
             DJV_DEBUG("PixelDataTest::run");
             ctors();
             members();
+            sharing();
             operators();
         }
 
@@ -113,6 +115,72 @@ namespace djv
             }
         }
 
+        void PixelDataTest::sharing()
+        {
+            DJV_DEBUG("PixelDataTest::sharing");
+            {
+                // Copies share the same memory.
+                Graphics::PixelData a(Graphics::PixelDataInfo(2, 2, Graphics::Pixel::L_U8));
+                a.zero();
+                DJV_ASSERT(!a.isShared());
+                Graphics::PixelData b(a);
+                Graphics::PixelData c;
+                c = a;
+                DJV_ASSERT(a.isShared());
+                DJV_ASSERT(b.isShared());
+                const Graphics::PixelData & constA = a;
+                const Graphics::PixelData & constB = b;
+                const Graphics::PixelData & constC = c;
+                DJV_ASSERT(constA.data() == constB.data());
+                DJV_ASSERT(constA.data() == constC.data());
+
+                // Changing a copy detaches it.
+                b.data(1, 1)[0] = 1;
+                DJV_ASSERT(constA.data() != constB.data());
+                DJV_ASSERT(0 == constA.data(1, 1)[0]);
+                DJV_ASSERT(1 == constB.data(1, 1)[0]);
+                DJV_ASSERT(0 == constC.data(1, 1)[0]);
+                DJV_ASSERT(!b.isShared());
+                DJV_ASSERT(a.isShared());
+
+                // Detaching memory that is not shared does not copy it.
+                const quint8 * p = constB.data();
+                b.detach();
+                DJV_ASSERT(p == constB.data());
+                DJV_ASSERT(p == b.data());
+
+                // Setting a copy does not change the others.
+                c.set(Graphics::PixelDataInfo(4, 4, Graphics::Pixel::L_U8));
+                DJV_ASSERT(!a.isShared());
+                DJV_ASSERT(Graphics::PixelDataInfo(2, 2, Graphics::Pixel::L_U8) == a.info());
+                DJV_ASSERT(0 == constA.data(1, 1)[0]);
+            }
+            {
+                // The memory is kept while a copy exists.
+                Graphics::PixelData b;
+                {
+                    Graphics::PixelData a(Graphics::PixelDataInfo(2, 2, Graphics::Pixel::L_U8));
+                    a.zero();
+                    a.data()[0] = 2;
+                    b = a;
+                }
+                DJV_ASSERT(!b.isShared());
+                DJV_ASSERT(2 == b.data()[0]);
+            }
+            {
+                // Copies of images share the same memory.
+                Graphics::Image a(Graphics::PixelDataInfo(2, 2, Graphics::Pixel::L_U8));
+                a.zero();
+                Graphics::Image b = a;
+                DJV_ASSERT(a.isShared());
+                DJV_ASSERT(a == b);
+                b.zero();
+                DJV_ASSERT(!a.isShared());
+                b.data()[0] = 1;
+                DJV_ASSERT(a != b);
+            }
+        }
+
         void PixelDataTest::operators()
         {
             DJV_DEBUG("PixelDataTest::operators");
@@ -43,6 +43,7 @@ namespace djv
         private:
             void ctors();
             void members();
+            void sharing();
             void operators();
         };
 
@@ -35,6 +35,7 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
+#include <djvCore/ThreadPool.h>
 
 #include <QPixmap>
 #include <QString>
@@ -51,8 +52,10 @@ namespace djv
             DJV_DEBUG("PixelDataUtilTest::run");
             byteCount();
             proxy();
+            proxyFilter();
             interleave();
             gradient();
+            parallel();
         }
 
         void PixelDataUtilTest::byteCount()
@@ -114,6 +117,89 @@ namespace djv
             }
         }
 
+        void PixelDataUtilTest::proxyFilter()
+        {
+            DJV_DEBUG("PixelDataUtilTest::proxyFilter");
+            {
+                DJV_DEBUG_PRINT("filter = " << Graphics::PixelDataUtil::proxyFilter());
+                DJV_ASSERT(Graphics::PixelDataUtil::PROXY_FILTER_NEAREST == Graphics::PixelDataUtil::proxyFilter());
+                DJV_ASSERT(
+                    Graphics::PixelDataUtil::proxyFilterLabels().count() ==
+                    Graphics::PixelDataUtil::PROXY_FILTER_COUNT);
+            }
+            {
+                // The blocks at the edges of the image are cut off.
+                const quint8 data[] =
+                {
+                    0,   2,   4,
+                    6,   9,   10,
+                    255, 255, 254
+                };
+                const Graphics::PixelData in(Graphics::PixelDataInfo(3, 3, Graphics::Pixel::L_U8), data);
+                Graphics::PixelData out(Graphics::PixelDataInfo(2, 2, Graphics::Pixel::L_U8));
+                Graphics::PixelDataUtil::proxyScale(
+                    in,
+                    out,
+                    Graphics::PixelDataInfo::PROXY_1_2,
+                    Graphics::PixelDataUtil::PROXY_FILTER_BOX);
+                DJV_ASSERT(4 == out.data(0, 0)[0]);
+                DJV_ASSERT(7 == out.data(1, 0)[0]);
+                DJV_ASSERT(255 == out.data(0, 1)[0]);
+                DJV_ASSERT(254 == out.data(1, 1)[0]);
+                Graphics::PixelDataUtil::proxyScale(
+                    in,
+                    out,
+                    Graphics::PixelDataInfo::PROXY_1_2,
+                    Graphics::PixelDataUtil::PROXY_FILTER_NEAREST);
+                DJV_ASSERT(0 == out.data(0, 0)[0]);
+                DJV_ASSERT(4 == out.data(1, 0)[0]);
+                DJV_ASSERT(255 == out.data(0, 1)[0]);
+                DJV_ASSERT(254 == out.data(1, 1)[0]);
+            }
+            {
+                // Scanlines are scaled the same way as the nearest filter.
+                const quint16 data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+                quint16 out[3] = { 0, 0, 0 };
+                Graphics::PixelDataUtil::proxyScaleScanline(
+                    reinterpret_cast<const quint8 *>(data),
+                    reinterpret_cast<quint8 *>(out),
+                    3,
+                    Graphics::Pixel::byteCount(Graphics::Pixel::LA_U8),
+                    Graphics::PixelDataInfo::PROXY_1_4);
+                DJV_ASSERT(1 == out[0]);
+                DJV_ASSERT(5 == out[1]);
+                DJV_ASSERT(9 == out[2]);
+            }
+            {
+                // Each pixel type is averaged in its own type and then
+                // converted.
+                for (int i = 0; i < Graphics::Pixel::PIXEL_COUNT; ++i)
+                {
+                    const Graphics::Pixel::PIXEL pixel = static_cast<Graphics::Pixel::PIXEL>(i);
+                    Graphics::PixelData in(Graphics::PixelDataInfo(8, 8, pixel));
+                    Graphics::PixelData tmp(Graphics::PixelDataInfo(8, 8, Graphics::Pixel::RGBA_F32));
+                    for (int y = 0; y < 8; ++y)
+                    {
+                        for (int x = 0; x < 8; ++x)
+                        {
+                            Graphics::Pixel::F32_T * p = reinterpret_cast<Graphics::Pixel::F32_T *>(tmp.data(x, y));
+                            p[0] = p[1] = p[2] = p[3] = (x + y) % 2 ? 1.f : 0.f;
+                        }
+                    }
+                    Graphics::Pixel::convert(tmp.data(), tmp.pixel(), in.data(), pixel, 64);
+                    Graphics::PixelData out(Graphics::PixelDataInfo(1, 1, Graphics::Pixel::RGBA_F32));
+                    Graphics::PixelDataUtil::proxyScale(
+                        in,
+                        out,
+                        Graphics::PixelDataInfo::PROXY_1_8,
+                        Graphics::PixelDataUtil::PROXY_FILTER_BOX);
+                    const Graphics::Pixel::F32_T * p = reinterpret_cast<const Graphics::Pixel::F32_T *>(out.data());
+                    DJV_DEBUG_PRINT(pixel << " = " << p[0]);
+                    DJV_ASSERT(Math::abs(p[0] - .5f) < .01f);
+                }
+            }
+        }
+
         void PixelDataUtilTest::interleave()
         {
             DJV_DEBUG("PixelDataUtilTest::interleave");
@@ -149,5 +235,61 @@ namespace djv
             Graphics::PixelDataUtil::gradient(data);
         }
 
+        void PixelDataUtilTest::parallel()
+        {
+            DJV_DEBUG("PixelDataUtilTest::parallel");
+            const int threadCount = ThreadPool::global()->threadCount();
+
+            // Run the operations serially and in parallel and compare the
+            // results. The image is large enough to be split between threads.
+            const glm::ivec2 size(1024, 768);
+            QList<Graphics::PixelData> results[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                ThreadPool::global()->setThreadCount(0 == i ? 1 : 4);
+                Graphics::PixelData data(Graphics::PixelDataInfo(size, Graphics::Pixel::RGBA_U16));
+                quint16 * p = reinterpret_cast<quint16 *>(data.data());
+                for (int j = 0; j < size.x * size.y * 4; ++j)
+                {
+                    p[j] = j;
+                }
+                for (int j = 0; j < Graphics::PixelDataInfo::PROXY_COUNT; ++j)
+                {
+                    const Graphics::PixelDataInfo::PROXY proxy = static_cast<Graphics::PixelDataInfo::PROXY>(j);
+                    Graphics::PixelDataInfo info(
+                        Graphics::PixelDataUtil::proxyScale(size, proxy),
+                        Graphics::Pixel::RGB_U8);
+                    info.bgr = true;
+                    for (int k = 0; k < Graphics::PixelDataUtil::PROXY_FILTER_COUNT; ++k)
+                    {
+                        Graphics::PixelData proxyData(info);
+                        Graphics::PixelDataUtil::proxyScale(
+                            data,
+                            proxyData,
+                            proxy,
+                            static_cast<Graphics::PixelDataUtil::PROXY_FILTER>(k));
+                        results[i] += proxyData;
+                    }
+                    Graphics::PixelData interleaveData(Graphics::PixelDataInfo(
+                        Graphics::PixelDataUtil::proxyScale(size, proxy),
+                        data.pixel()));
+                    Graphics::PixelDataUtil::planarInterleave(data, interleaveData, proxy);
+                    results[i] += interleaveData;
+                }
+                Graphics::PixelData deinterleaveData(data.info());
+                Graphics::PixelDataUtil::planarDeinterleave(data, deinterleaveData);
+                results[i] += deinterleaveData;
+                Graphics::PixelData gradientData(Graphics::PixelDataInfo(size, Graphics::Pixel::L_F32));
+                Graphics::PixelDataUtil::gradient(gradientData);
+                results[i] += gradientData;
+            }
+            DJV_ASSERT(results[0].count() == results[1].count());
+            for (int i = 0; i < results[0].count(); ++i)
+            {
+                DJV_ASSERT(results[0][i] == results[1][i]);
+            }
+            ThreadPool::global()->setThreadCount(threadCount);
+        }
+
     } // namespace GraphicsTest
 } // namespace djv
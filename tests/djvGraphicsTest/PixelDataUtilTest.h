@@ -43,8 +43,10 @@ namespace djv
         private:
             void byteCount();
             void proxy();
+            void proxyFilter();
             void interleave();
             void gradient();
+            void parallel();
             void qt();
         };
 
@@ -38,6 +38,8 @@
 
 #include <QStringList>
 
+#include <vector>
+
 using namespace djv::Core;
 using namespace djv::Graphics;
 
@@ -51,6 +53,7 @@ namespace djv
             mask();
             members();
             convert();
+            convertSIMD();
             operators();
         }
 
@@ -375,6 +378,67 @@ namespace djv
             }
         }
 
+        void PixelTest::convertSIMD()
+        {
+            DJV_DEBUG("PixelTest::convertSIMD");
+            DJV_DEBUG_PRINT("cpu = " << Graphics::Pixel::cpuSIMD());
+            const Graphics::Pixel::SIMD simd = Graphics::Pixel::convertSIMD();
+
+            // The SIMD code should give the same results as the scalar code. An
+            // odd size is used so that the scalar tail is also tested.
+            const int size = 1000 + 3;
+            for (int i = 0; i < Graphics::Pixel::PIXEL_COUNT; ++i)
+            {
+                const Graphics::Pixel::PIXEL in = static_cast<Graphics::Pixel::PIXEL>(i);
+                std::vector<quint8> inData(size * Graphics::Pixel::byteCount(in));
+                const int channels = Graphics::Pixel::channels(in);
+                for (int k = 0; k < size * channels; ++k)
+                {
+                    const float value = k / static_cast<float>(size * channels) * 1.5f - .25f;
+                    switch (Graphics::Pixel::type(in))
+                    {
+                    case Graphics::Pixel::U8:
+                        inData[k] = k * 7;
+                        break;
+                    case Graphics::Pixel::U10:
+                        if (k < size)
+                        {
+                            reinterpret_cast<quint32 *>(inData.data())[k] = (k * 2654435761u) & ~3u;
+                        }
+                        break;
+                    case Graphics::Pixel::U16:
+                        reinterpret_cast<quint16 *>(inData.data())[k] = k * 997;
+                        break;
+                    case Graphics::Pixel::F16:
+                        reinterpret_cast<Graphics::Pixel::F16_T *>(inData.data())[k] = value;
+                        break;
+                    case Graphics::Pixel::F32:
+                        reinterpret_cast<Graphics::Pixel::F32_T *>(inData.data())[k] = value;
+                        break;
+                    default: break;
+                    }
+                }
+                for (int j = 0; j < Graphics::Pixel::PIXEL_COUNT; ++j)
+                {
+                    const Graphics::Pixel::PIXEL out = static_cast<Graphics::Pixel::PIXEL>(j);
+                    for (int bgr = 0; bgr < 2; ++bgr)
+                    {
+                        std::vector<quint8> a(size * Graphics::Pixel::byteCount(out), 0);
+                        Graphics::Pixel::setConvertSIMD(Graphics::Pixel::SIMD_NONE);
+                        Graphics::Pixel::convert(inData.data(), in, a.data(), out, size, 1, bgr);
+                        for (int k = Graphics::Pixel::SIMD_NONE + 1; k <= Graphics::Pixel::cpuSIMD(); ++k)
+                        {
+                            std::vector<quint8> b(a.size(), 0);
+                            Graphics::Pixel::setConvertSIMD(static_cast<Graphics::Pixel::SIMD>(k));
+                            Graphics::Pixel::convert(inData.data(), in, b.data(), out, size, 1, bgr);
+                            DJV_ASSERT(a == b);
+                        }
+                    }
+                }
+            }
+            Graphics::Pixel::setConvertSIMD(simd);
+        }
+
         void PixelTest::operators()
         {
             DJV_DEBUG("PixelTest::operators");
@@ -44,6 +44,7 @@ namespace djv
             void mask();
             void members();
             void convert();
+            void convertSIMD();
             void operators();
         };
 
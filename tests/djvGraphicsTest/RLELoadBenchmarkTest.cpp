@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphicsTest/RLELoadBenchmarkTest.h>
+
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/IFF.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+#include <djvGraphics/SGI.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/ThreadPool.h>
+#include <djvCore/Timer.h>
+
+#include <QDir>
+#include <QScopedPointer>
+
+#include <vector>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        namespace
+        {
+            //! Fill pixel data with short runs so that it compresses, but not
+            //! so well that decoding is trivial.
+            void fill(Graphics::PixelData & data)
+            {
+                const quint64 scanlineByteCount = data.scanlineByteCount();
+                for (int y = 0; y < data.h(); ++y)
+                {
+                    quint8 * p = data.data(0, y);
+                    for (quint64 i = 0; i < scanlineByteCount; ++i)
+                    {
+                        p[i] = static_cast<quint8>((i / 16) * 37 + y * 13);
+                    }
+                }
+            }
+
+            void appendU16(std::vector<quint8> & out, quint16 value)
+            {
+                out.push_back(value >> 8);
+                out.push_back(value & 0xff);
+            }
+
+            void appendU32(std::vector<quint8> & out, quint32 value)
+            {
+                appendU16(out, value >> 16);
+                appendU16(out, value & 0xffff);
+            }
+
+            //! Encode a channel of a scanline with the RLA run-length encoding.
+            void rlaEncode(const quint8 * in, int size, int stride, std::vector<quint8> & out)
+            {
+                int i = 0;
+                while (i < size)
+                {
+                    int run = 1;
+                    while (i + run < size && run < 128 && in[(i + run) * stride] == in[i * stride])
+                    {
+                        ++run;
+                    }
+                    if (run > 1)
+                    {
+                        out.push_back(static_cast<quint8>(run - 1));
+                        out.push_back(in[i * stride]);
+                        i += run;
+                    }
+                    else
+                    {
+                        int count = 1;
+                        while (i + count < size && count < 128 &&
+                            !(i + count + 1 < size && in[(i + count) * stride] == in[(i + count + 1) * stride]))
+                        {
+                            ++count;
+                        }
+                        out.push_back(static_cast<quint8>(-count));
+                        for (int j = 0; j < count; ++j)
+                        {
+                            out.push_back(in[(i + j) * stride]);
+                        }
+                        i += count;
+                    }
+                }
+            }
+
+            //! Write an 8-bit RGBA RLA file, since there is no RLA saver.
+            void rlaSave(const QString & fileName, const Graphics::PixelData & data)
+            {
+                const int w = data.w();
+                const int h = data.h();
+                std::vector<quint8> header(740, 0);
+                header[11] = (w - 1) & 0xff;
+                header[10] = (w - 1) >> 8;
+                header[15] = (h - 1) & 0xff;
+                header[14] = (h - 1) >> 8;
+                header[21] = 3;   // Color channels.
+                header[23] = 1;   // Matte channels.
+                header[659] = 8;  // Color bit depth.
+                header[663] = 8;  // Matte bit depth.
+                std::vector<quint8> scanlines;
+                std::vector<quint32> offsets;
+                const quint32 start = static_cast<quint32>(header.size()) + h * 4;
+                for (int y = 0; y < h; ++y)
+                {
+                    offsets.push_back(start + static_cast<quint32>(scanlines.size()));
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        std::vector<quint8> channel;
+                        rlaEncode(data.data(0, y) + c, w, 4, channel);
+                        appendU16(scanlines, static_cast<quint16>(channel.size()));
+                        scanlines.insert(scanlines.end(), channel.begin(), channel.end());
+                    }
+                }
+                for (int y = 0; y < h; ++y)
+                {
+                    appendU32(header, offsets[y]);
+                }
+                FileIO io;
+                io.open(fileName, FileIO::WRITE);
+                io.set(header.data(), header.size());
+                io.set(scanlines.data(), scanlines.size());
+            }
+
+        } // namespace
+
+        RLELoadBenchmarkTest::RLELoadBenchmarkTest(bool benchmark) :
+            _benchmark(benchmark)
+        {}
+
+        void RLELoadBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("RLELoadBenchmarkTest::run");
+            Graphics::GraphicsContext context(argc, argv);
+            QStringList tmp = QStringList() << Graphics::IFF::compressionLabels()[Graphics::IFF::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::IFF::staticName,
+                Graphics::IFF::optionsLabels()[Graphics::IFF::COMPRESSION_OPTION],
+                tmp);
+            tmp = QStringList() << Graphics::SGI::compressionLabels()[Graphics::SGI::COMPRESSION_RLE];
+            context.imageIOFactory()->setOption(
+                Graphics::SGI::staticName,
+                Graphics::SGI::optionsLabels()[Graphics::SGI::COMPRESSION_OPTION],
+                tmp);
+            struct Format
+            {
+                QString                extension;
+                Graphics::Pixel::PIXEL pixel;
+            };
+            const std::vector<Format> formats =
+            {
+                { ".iff", Graphics::Pixel::RGBA_U8 },
+                { ".iff", Graphics::Pixel::RGBA_U16 },
+                { ".rla", Graphics::Pixel::RGBA_U8 },
+                { ".sgi", Graphics::Pixel::RGBA_U8 },
+                { ".sgi", Graphics::Pixel::RGB_U16 }
+            };
+            const int frames = _benchmark ? 10 : 1;
+            const glm::ivec2 size = _benchmark ? glm::ivec2(2048, 1556) : glm::ivec2(301, 203);
+            for (const auto & format : formats)
+            {
+                const FileInfo fileInfo("RLELoadBenchmarkTest" + format.extension);
+                Graphics::Image image(Graphics::PixelDataInfo(size, format.pixel));
+                fill(image);
+                try
+                {
+                    if (".rla" == format.extension)
+                    {
+                        rlaSave(fileInfo, image);
+                    }
+                    else
+                    {
+                        QScopedPointer<Graphics::ImageSave> save(
+                            context.imageIOFactory()->save(fileInfo, Graphics::ImageIOInfo(image.info())));
+                        save->write(image);
+                        save->close();
+                    }
+
+                    // Decode the file serially and then in parallel, and check
+                    // that the results are the same.
+                    Graphics::Image images[2];
+                    float seconds[2] = { 0.f, 0.f };
+                    const int threadCounts[] = { 1, 0 };
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        ThreadPool::global()->setThreadCount(threadCounts[i]);
+                        Graphics::ImageIOInfo info;
+                        QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, info));
+                        Timer timer;
+                        timer.start();
+                        for (int frame = 0; frame < frames; ++frame)
+                        {
+                            load->read(images[i]);
+                        }
+                        timer.check();
+                        seconds[i] = timer.seconds();
+                    }
+                    ThreadPool::global()->setThreadCount(0);
+                    const QString label = format.extension + " " + Graphics::Pixel::pixelLabels()[format.pixel];
+                    DJV_DEBUG_PRINT(label << " serial (ms) = " << seconds[0] / frames * 1000.f);
+                    DJV_DEBUG_PRINT(label << " parallel (ms) = " << seconds[1] / frames * 1000.f);
+                    DJV_DEBUG_PRINT(label << " threads = " << ThreadPool::global()->threadCount());
+                    const Graphics::Image & serial = images[0];
+                    const Graphics::Image & parallel = images[1];
+                    DJV_ASSERT(serial.size() == parallel.size());
+                    DJV_ASSERT(serial.pixel() == parallel.pixel());
+                    DJV_ASSERT(0 == memcmp(serial.data(), parallel.data(), serial.dataByteCount()));
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT("error = " << ErrorUtil::format(error));
+                    DJV_ASSERT(0);
+                }
+                QDir().remove(fileInfo);
+            }
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
@@ -27,29 +27,40 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
+#include <djvViewLibTest/FileCacheTest.h>
+
+#include <djvConvertTest/ConvertContextTest.h>
+
 #include <djvGraphicsTest/ColorProfileTest.h>
 #include <djvGraphicsTest/ColorTest.h>
 #include <djvGraphicsTest/ColorUtilTest.h>
+#include <djvGraphicsTest/FFmpegLoadBenchmarkTest.h>
 #include <djvGraphicsTest/GraphicsContextTest.h>
 #include <djvGraphicsTest/ImageIOFormatsTest.h>
 #include <djvGraphicsTest/ImageIOTest.h>
+#include <djvGraphicsTest/ImageSaveBenchmarkTest.h>
 #include <djvGraphicsTest/ImageTagsTest.h>
 #include <djvGraphicsTest/ImageTest.h>
+#include <djvGraphicsTest/OpenEXRLoadBenchmarkTest.h>
 #include <djvGraphicsTest/OpenGLImageTest.h>
 #include <djvGraphicsTest/OpenGLTest.h>
+#include <djvGraphicsTest/PixelDataPoolTest.h>
 #include <djvGraphicsTest/PixelDataTest.h>
 #include <djvGraphicsTest/PixelDataUtilTest.h>
 #include <djvGraphicsTest/PixelTest.h>
+#include <djvGraphicsTest/RLELoadBenchmarkTest.h>
 
 #include <djvCoreTest/BoxTest.h>
 #include <djvCoreTest/BoxUtilTest.h>
 #include <djvCoreTest/CoreContextTest.h>
 #include <djvCoreTest/DebugTest.h>
 #include <djvCoreTest/ErrorTest.h>
+#include <djvCoreTest/FileBatchReaderTest.h>
 #include <djvCoreTest/FileInfoTest.h>
 #include <djvCoreTest/FileInfoUtilTest.h>
 #include <djvCoreTest/FileIOTest.h>
 #include <djvCoreTest/FileIOUtilTest.h>
+#include <djvCoreTest/FilePrefetchTest.h>
 #include <djvCoreTest/ListUtilTest.h>
 #include <djvCoreTest/MathTest.h>
 #include <djvCoreTest/MemoryTest.h>
@@ -59,6 +70,7 @@
 #include <djvCoreTest/SpeedTest.h>
 #include <djvCoreTest/StringUtilTest.h>
 #include <djvCoreTest/SystemTest.h>
+#include <djvCoreTest/ThreadPoolTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/TimerTest.h>
 #include <djvCoreTest/UserTest.h>
@@ -85,10 +97,12 @@ int main(int argc, char ** argv)
             new CoreTest::CoreContextTest <<
             new CoreTest::DebugTest <<
             new CoreTest::ErrorTest <<
+            new CoreTest::FileBatchReaderTest <<
             new CoreTest::FileInfoTest <<
             new CoreTest::FileInfoUtilTest <<
             new CoreTest::FileIOTest <<
             new CoreTest::FileIOUtilTest <<
+            new CoreTest::FilePrefetchTest <<
             new CoreTest::ListUtilTest <<
             new CoreTest::MathTest <<
             new CoreTest::MemoryTest <<
@@ -98,6 +112,7 @@ int main(int argc, char ** argv)
             new CoreTest::SpeedTest <<
             new CoreTest::StringUtilTest <<
             new CoreTest::SystemTest <<
+            new CoreTest::ThreadPoolTest <<
             new CoreTest::TimeTest <<
             new CoreTest::TimerTest <<
             new CoreTest::UserTest <<
@@ -106,16 +121,25 @@ int main(int argc, char ** argv)
             new GraphicsTest::ColorProfileTest <<
             new GraphicsTest::ColorTest <<
             new GraphicsTest::ColorUtilTest <<
+            new GraphicsTest::FFmpegLoadBenchmarkTest(false) <<
             new GraphicsTest::GraphicsContextTest <<
             new GraphicsTest::ImageIOFormatsTest <<
             new GraphicsTest::ImageIOTest <<
+            new GraphicsTest::ImageSaveBenchmarkTest(false) <<
             new GraphicsTest::ImageTagsTest <<
             new GraphicsTest::ImageTest <<
+            new GraphicsTest::OpenEXRLoadBenchmarkTest(false) <<
             new GraphicsTest::OpenGLImageTest <<
             new GraphicsTest::OpenGLTest <<
+            new GraphicsTest::PixelDataPoolTest <<
             new GraphicsTest::PixelDataTest <<
             new GraphicsTest::PixelDataUtilTest <<
-            new GraphicsTest::PixelTest;
+            new GraphicsTest::PixelTest <<
+            new GraphicsTest::RLELoadBenchmarkTest(false) <<
+
+            new ConvertTest::ConvertContextTest <<
+
+            new ViewLibTest::FileCacheTest;
 
         for (int i = 0; i < tests.count(); ++i)
         {
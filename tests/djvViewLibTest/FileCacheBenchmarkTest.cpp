@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLibTest/FileCacheBenchmarkTest.h>
+
+#include <djvViewLib/FileCache.h>
+#include <djvViewLib/FileCachePolicy.h>
+#include <djvViewLib/ViewContext.h>
+
+#include <djvGraphics/Image.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Timer.h>
+
+using namespace djv::Core;
+using namespace djv::ViewLib;
+
+namespace djv
+{
+    namespace ViewLibTest
+    {
+        void FileCacheBenchmarkTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheBenchmarkTest::run");
+            ViewLib::ViewContext context(argc, argv);
+            int window = 0;
+            auto image = std::make_shared<Graphics::Image>(
+                Graphics::PixelDataInfo(1024, 1024, Graphics::Pixel::L_U8));
+            const int count = 100000;
+            ViewLib::FileCache cache(&context);
+            cache.setMaxSizeGB(count / 1024.f);
+            Timer timer;
+
+            timer.start();
+            for (int i = 0; i < count; ++i)
+            {
+                cache.addItem(ViewLib::FileCacheKey(&window, i), image);
+            }
+            timer.check();
+            DJV_DEBUG_PRINT("add (ms) = " << timer.seconds() * 1000.f);
+            DJV_ASSERT(count == cache.frames(&window).count());
+
+            timer.start();
+            for (int i = 0; i < count; ++i)
+            {
+                cache.item(ViewLib::FileCacheKey(&window, (i * 7919) % count));
+            }
+            timer.check();
+            DJV_DEBUG_PRINT("lookup (ms) = " << timer.seconds() * 1000.f);
+
+            timer.start();
+            for (int i = count; i < count * 2; ++i)
+            {
+                cache.addItem(ViewLib::FileCacheKey(&window, i), image);
+            }
+            timer.check();
+            DJV_DEBUG_PRINT("add and evict (ms) = " << timer.seconds() * 1000.f);
+            DJV_ASSERT(count == cache.frames(&window).count());
+            DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window, count - 1)));
+            DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, count)));
+
+            timer.start();
+            cache.setMaxSizeGB(0.f);
+            timer.check();
+            DJV_DEBUG_PRINT("evict all (ms) = " << timer.seconds() * 1000.f);
+            DJV_ASSERT(0 == cache.currentSizeBytes());
+
+            // With a playback policy the frame just behind the current frame is
+            // needed last, so it is evicted first.
+            auto policy = std::make_shared<FileCachePlaybackPolicy>();
+            policy->setPlayback(0, Enum::FORWARD, Enum::LOOP_REPEAT, 0, count * 2 - 1);
+            cache.setPolicy(&window, policy);
+            cache.setMaxSizeGB(count / 1024.f);
+            for (int i = 0; i < count; ++i)
+            {
+                cache.addItem(ViewLib::FileCacheKey(&window, i), image);
+            }
+            timer.start();
+            for (int i = count; i < count * 2; ++i)
+            {
+                policy->setPlayback(i, Enum::FORWARD, Enum::LOOP_REPEAT, 0, count * 2 - 1);
+                cache.addItem(ViewLib::FileCacheKey(&window, i), image);
+            }
+            timer.check();
+            DJV_DEBUG_PRINT("add and evict with policy (ms) = " << timer.seconds() * 1000.f);
+            DJV_ASSERT(count == cache.frames(&window).count());
+            DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, 0)));
+            DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window, count * 2 - 2)));
+            DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, count * 2 - 1)));
+
+            timer.start();
+            cache.setMaxSizeGB(0.f);
+            timer.check();
+            DJV_DEBUG_PRINT("evict all with policy (ms) = " << timer.seconds() * 1000.f);
+            DJV_ASSERT(0 == cache.currentSizeBytes());
+            cache.setPolicy(&window, nullptr);
+        }
+
+    } // namespace ViewLibTest
+} // namespace djv
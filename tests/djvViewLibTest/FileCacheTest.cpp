@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLibTest/FileCacheTest.h>
+
+#include <djvViewLib/FileCache.h>
+#include <djvViewLib/FileCachePolicy.h>
+#include <djvViewLib/ViewContext.h>
+
+#include <djvGraphics/Image.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+
+using namespace djv::Core;
+using namespace djv::ViewLib;
+
+namespace djv
+{
+    namespace ViewLibTest
+    {
+        void FileCacheTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheTest::run");
+            members(argc, argv);
+            layers(argc, argv);
+            policy(argc, argv);
+        }
+
+        void FileCacheTest::members(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheTest::members");
+            ViewLib::ViewContext context(argc, argv);
+            int window0 = 0;
+            int window1 = 0;
+            auto image = std::make_shared<Graphics::Image>(
+                Graphics::PixelDataInfo(1024, 1024, Graphics::Pixel::L_U8));
+            const quint64 imageBytes = image->dataByteCount();
+            {
+                ViewLib::FileCache cache(&context);
+                cache.setMaxSizeGB(3 / 1024.f);
+                DJV_ASSERT(3 * imageBytes == cache.maxSizeBytes());
+                cache.addItem(ViewLib::FileCacheKey(&window0, 2), image);
+                cache.addItem(ViewLib::FileCacheKey(&window0, 0), image);
+                cache.addItem(ViewLib::FileCacheKey(&window1, 1), image);
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window0, 0)));
+                DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window0, 1)));
+                DJV_ASSERT(cache.item(ViewLib::FileCacheKey(&window1, 1)) == image);
+                DJV_ASSERT(!cache.item(ViewLib::FileCacheKey(&window1, 0)));
+                DJV_ASSERT(3 * imageBytes == cache.currentSizeBytes());
+                DJV_ASSERT(Math::fuzzyCompare(2 / 1024.f, cache.currentSizeGB(&window0)));
+                DJV_ASSERT(Math::fuzzyCompare(1 / 1024.f, cache.currentSizeGB(&window1)));
+                DJV_ASSERT(FrameList() << 0 << 2 == cache.frames(&window0));
+                DJV_ASSERT(2 == static_cast<int>(cache.items(&window0).size()));
+
+                // Items added within the same second are evicted in least
+                // recently used order.
+                cache.item(ViewLib::FileCacheKey(&window0, 2));
+                cache.addItem(ViewLib::FileCacheKey(&window1, 3), image);
+                DJV_ASSERT(3 * imageBytes == cache.currentSizeBytes());
+                DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window0, 0)));
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window0, 2)));
+                DJV_ASSERT(FrameList() << 2 == cache.frames(&window0));
+                DJV_ASSERT(FrameList() << 1 << 3 == cache.frames(&window1));
+
+                // Replacing an item does not change the size.
+                cache.addItem(ViewLib::FileCacheKey(&window1, 3), image);
+                DJV_ASSERT(3 * imageBytes == cache.currentSizeBytes());
+
+                cache.removeItem(ViewLib::FileCacheKey(&window0, 2));
+                DJV_ASSERT(FrameList() == cache.frames(&window0));
+                DJV_ASSERT(0.f == cache.currentSizeGB(&window0));
+                cache.clearItems(&window1);
+                DJV_ASSERT(0 == cache.currentSizeBytes());
+                DJV_ASSERT(FrameList() == cache.frames(&window1));
+
+                cache.addItem(ViewLib::FileCacheKey(&window0, 0), image);
+                cache.setMaxSizeGB(0.f);
+                DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window0, 0)));
+                cache.setMaxSizeGB(1 / 1024.f);
+                cache.addItem(ViewLib::FileCacheKey(&window0, 0), image);
+                cache.clear();
+                DJV_ASSERT(0 == cache.currentSizeBytes());
+            }
+        }
+
+        void FileCacheTest::layers(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheTest::layers");
+            ViewLib::ViewContext context(argc, argv);
+            int window = 0;
+            auto image0 = std::make_shared<Graphics::Image>(
+                Graphics::PixelDataInfo(1024, 1024, Graphics::Pixel::L_U8));
+            auto image1 = std::make_shared<Graphics::Image>(
+                Graphics::PixelDataInfo(1024, 1024, Graphics::Pixel::L_U8));
+            const quint64 imageBytes = image0->dataByteCount();
+            {
+                ViewLib::FileCache cache(&context);
+                cache.setMaxSizeGB(8 / 1024.f);
+                cache.addItem(ViewLib::FileCacheKey(&window, 0, 0), image0);
+                cache.addItem(ViewLib::FileCacheKey(&window, 0, 1), image1);
+                cache.addItem(ViewLib::FileCacheKey(&window, 1, 0), image0);
+                cache.addItem(ViewLib::FileCacheKey(&window, 1, 1), image1);
+                cache.addItem(ViewLib::FileCacheKey(&window, 2, 1), image1);
+                DJV_ASSERT(ViewLib::FileCacheKey(&window, 0) == ViewLib::FileCacheKey(&window, 0, 0));
+                DJV_ASSERT(!(ViewLib::FileCacheKey(&window, 0, 0) == ViewLib::FileCacheKey(&window, 0, 1)));
+                DJV_ASSERT(ViewLib::FileCacheKey(&window, 0, 1) < ViewLib::FileCacheKey(&window, 1, 0));
+                DJV_ASSERT(cache.item(ViewLib::FileCacheKey(&window, 0, 0)) == image0);
+                DJV_ASSERT(cache.item(ViewLib::FileCacheKey(&window, 0, 1)) == image1);
+                DJV_ASSERT(!cache.item(ViewLib::FileCacheKey(&window, 2, 0)));
+                DJV_ASSERT(5 * imageBytes == cache.currentSizeBytes());
+                DJV_ASSERT(FrameList() << 0 << 1 << 2 == cache.frames(&window));
+                DJV_ASSERT(5 == static_cast<int>(cache.items(&window).size()));
+
+                // Removing a frame removes all of its layers.
+                cache.removeFrame(&window, 1);
+                DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window, 1, 0)));
+                DJV_ASSERT(!cache.hasItem(ViewLib::FileCacheKey(&window, 1, 1)));
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, 0, 1)));
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, 2, 1)));
+                DJV_ASSERT(3 * imageBytes == cache.currentSizeBytes());
+                DJV_ASSERT(FrameList() << 0 << 2 == cache.frames(&window));
+
+                // The playback policy evicts all of the layers of the frames
+                // furthest from the current frame.
+                auto policy = std::make_shared<FileCachePlaybackPolicy>();
+                policy->setPlayback(0, Enum::FORWARD, Enum::LOOP_REPEAT, 0, 2);
+                cache.setPolicy(&window, policy);
+                cache.setMaxSizeGB(2 / 1024.f);
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, 0, 0)));
+                DJV_ASSERT(cache.hasItem(ViewLib::FileCacheKey(&window, 0, 1)));
+                DJV_ASSERT(FrameList() << 0 == cache.frames(&window));
+
+                cache.clearItems(&window);
+                DJV_ASSERT(0 == cache.currentSizeBytes());
+                cache.setPolicy(&window, nullptr);
+            }
+        }
+
+        void FileCacheTest::policy(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileCacheTest::policy");
+            const qint64 max = FileCachePlaybackPolicy::distanceMax;
+            {
+                FileCachePlaybackPolicy policy;
+                policy.setPlayback(2, Enum::FORWARD, Enum::LOOP_REPEAT, 1, 5);
+                DJV_ASSERT(max == policy.distance(0));
+                DJV_ASSERT(0 == policy.distance(2));
+                DJV_ASSERT(3 == policy.distance(5));
+                DJV_ASSERT(4 == policy.distance(1));
+                DJV_ASSERT(max == policy.distance(6));
+            }
+            {
+                FileCachePlaybackPolicy policy;
+                policy.setPlayback(2, Enum::REVERSE, Enum::LOOP_REPEAT, 1, 5);
+                DJV_ASSERT(1 == policy.distance(1));
+                DJV_ASSERT(2 == policy.distance(5));
+                DJV_ASSERT(4 == policy.distance(3));
+            }
+            {
+                FileCachePlaybackPolicy policy;
+                policy.setPlayback(2, Enum::FORWARD, Enum::LOOP_ONCE, 1, 5);
+                DJV_ASSERT(3 == policy.distance(5));
+                DJV_ASSERT(max == policy.distance(1));
+            }
+            {
+                FileCachePlaybackPolicy policy;
+                policy.setPlayback(3, Enum::FORWARD, Enum::LOOP_PING_PONG, 1, 5);
+                DJV_ASSERT(2 == policy.distance(5));
+                DJV_ASSERT(5 == policy.distance(2));
+                DJV_ASSERT(6 == policy.distance(1));
+                policy.setPlayback(3, Enum::REVERSE, Enum::LOOP_PING_PONG, 1, 5);
+                DJV_ASSERT(2 == policy.distance(1));
+                DJV_ASSERT(5 == policy.distance(4));
+                DJV_ASSERT(6 == policy.distance(5));
+            }
+            {
+                FileCachePlaybackPolicy policy;
+                policy.setPlayback(3, Enum::STOP, Enum::LOOP_ONCE, 1, 9);
+                DJV_ASSERT(3 == policy.distance(6));
+                DJV_ASSERT(FileCachePlaybackPolicy::behindWeight == policy.distance(2));
+            }
+            {
+                // Playing forward in a loop that does not fit in the cache
+                // evicts the frames just behind the current frame instead of
+                // the frames that are needed next.
+                ViewLib::ViewContext context(argc, argv);
+                int window = 0;
+                auto image = std::make_shared<Graphics::Image>(
+                    Graphics::PixelDataInfo(1024, 1024, Graphics::Pixel::L_U8));
+                auto policy = std::make_shared<FileCachePlaybackPolicy>();
+                ViewLib::FileCache cache(&context);
+                cache.setMaxSizeGB(3 / 1024.f);
+                cache.setPolicy(&window, policy);
+                DJV_ASSERT(cache.policy(&window) == policy);
+                for (qint64 frame = 0; frame < 4; ++frame)
+                {
+                    policy->setPlayback(frame, Enum::FORWARD, Enum::LOOP_REPEAT, 0, 4);
+                    if (!cache.item(ViewLib::FileCacheKey(&window, frame)))
+                    {
+                        cache.addItem(ViewLib::FileCacheKey(&window, frame), image);
+                    }
+                }
+                DJV_ASSERT(FrameList() << 0 << 1 << 3 == cache.frames(&window));
+                DJV_ASSERT(0 == cache.stats().hits);
+                DJV_ASSERT(4 == cache.stats().misses);
+                DJV_ASSERT(1 == cache.stats().evictions);
+                policy->setPlayback(0, Enum::FORWARD, Enum::LOOP_REPEAT, 0, 4);
+                DJV_ASSERT(cache.item(ViewLib::FileCacheKey(&window, 0)));
+                DJV_ASSERT(Math::fuzzyCompare(20.f, cache.stats().hitRate()));
+
+                // Without a policy the least recently used item is evicted.
+                cache.setPolicy(&window, nullptr);
+                DJV_ASSERT(!cache.policy(&window));
+                cache.addItem(ViewLib::FileCacheKey(&window, 4), image);
+                DJV_ASSERT(FrameList() << 0 << 3 << 4 == cache.frames(&window));
+                DJV_ASSERT(2 == cache.stats().evictions);
+                cache.resetStats();
+                DJV_ASSERT(0 == cache.stats().misses);
+                DJV_ASSERT(0.f == cache.stats().hitRate());
+            }
+        }
+
+    } // namespace ViewLibTest
+} // namespace djv